@@ -10,8 +10,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long alt_bn128_G1::add_cnt = 0;
-long long alt_bn128_G1::dbl_cnt = 0;
+op_counter alt_bn128_G1::add_cnt("alt_bn128_G1::add");
+op_counter alt_bn128_G1::dbl_cnt("alt_bn128_G1::dbl");
 #endif
 
 std::vector<size_t> alt_bn128_G1::wnaf_window_table;
@@ -179,6 +179,10 @@ alt_bn128_G1 alt_bn128_G1::operator+(const alt_bn128_G1 &other) const
         return this->dbl();
     }
 
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
+
     // rest of add case
     alt_bn128_Fq H = U2 - U1;                            // H = U2-U1
     alt_bn128_Fq S2_minus_S1 = S2-S1;
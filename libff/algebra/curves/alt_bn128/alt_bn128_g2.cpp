@@ -10,8 +10,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long alt_bn128_G2::add_cnt = 0;
-long long alt_bn128_G2::dbl_cnt = 0;
+op_counter alt_bn128_G2::add_cnt("alt_bn128_G2::add");
+op_counter alt_bn128_G2::dbl_cnt("alt_bn128_G2::dbl");
 #endif
 
 std::vector<size_t> alt_bn128_G2::wnaf_window_table;
@@ -189,6 +189,10 @@ alt_bn128_G2 alt_bn128_G2::operator+(const alt_bn128_G2 &other) const
         return this->dbl();
     }
 
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
+
     // rest of add case
     alt_bn128_Fq2 H = U2 - U1;                            // H = U2-U1
     alt_bn128_Fq2 S2_minus_S1 = S2-S1;
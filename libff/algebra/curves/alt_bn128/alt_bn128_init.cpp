@@ -33,6 +33,11 @@ void init_alt_bn128_params()
     typedef bigint<alt_bn128_r_limbs> bigint_r;
     typedef bigint<alt_bn128_q_limbs> bigint_q;
 
+#ifdef PROFILE_OP_COUNTS
+    alt_bn128_Fr::name_op_counters("alt_bn128_Fr");
+    alt_bn128_Fq::name_op_counters("alt_bn128_Fq");
+#endif
+
     assert(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
 
     /* parameters for scalar field Fr */
@@ -11,6 +11,7 @@
 #include <libff/algebra/curves/alt_bn128/alt_bn128_g2.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_init.hpp>
 #include <libff/algebra/curves/alt_bn128/alt_bn128_pairing.hpp>
+#include <libff/common/memory_accounting.hpp>
 #include <libff/common/profiling.hpp>
 
 namespace libff {
@@ -102,6 +103,8 @@ std::istream& operator>>(std::istream& in, alt_bn128_ate_G2_precomp &prec_Q)
         prec_Q.coeffs.emplace_back(c);
     }
 
+    prec_Q.coeffs_mem.set(prec_Q.coeffs.capacity() * sizeof(alt_bn128_ate_ell_coeffs));
+
     return in;
 }
 
@@ -361,12 +364,14 @@ alt_bn128_ate_G2_precomp alt_bn128_ate_precompute_G2(const alt_bn128_G2& Q)
     mixed_addition_step_for_flipped_miller_loop(Q2, R, c);
     result.coeffs.push_back(c);
 
+    result.coeffs_mem.set(result.coeffs.capacity() * sizeof(alt_bn128_ate_ell_coeffs));
+
     leave_block("Call to alt_bn128_ate_precompute_G2");
     return result;
 }
 
-alt_bn128_Fq12 alt_bn128_ate_miller_loop(const alt_bn128_ate_G1_precomp &prec_P,
-                                     const alt_bn128_ate_G2_precomp &prec_Q)
+static alt_bn128_Fq12 alt_bn128_ate_miller_loop_inner(const alt_bn128_ate_G1_precomp &prec_P,
+                                                      const alt_bn128_ate_ell_coeffs *coeffs)
 {
     enter_block("Call to alt_bn128_ate_miller_loop");
 
@@ -392,13 +397,13 @@ alt_bn128_Fq12 alt_bn128_ate_miller_loop(const alt_bn128_ate_G1_precomp &prec_P,
            alt_bn128_param_p (skipping leading zeros) in MSB to LSB
            order */
 
-        c = prec_Q.coeffs[idx++];
+        c = coeffs[idx++];
         f = f.squared();
         f = f.mul_by_024(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
 
         if (bit)
         {
-            c = prec_Q.coeffs[idx++];
+            c = coeffs[idx++];
             f = f.mul_by_024(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
         }
 
@@ -409,23 +414,52 @@ alt_bn128_Fq12 alt_bn128_ate_miller_loop(const alt_bn128_ate_G1_precomp &prec_P,
     	f = f.inverse();
     }
 
-    c = prec_Q.coeffs[idx++];
+    c = coeffs[idx++];
     f = f.mul_by_024(c.ell_0,prec_P.PY * c.ell_VW,prec_P.PX * c.ell_VV);
 
-    c = prec_Q.coeffs[idx++];
+    c = coeffs[idx++];
     f = f.mul_by_024(c.ell_0,prec_P.PY * c.ell_VW,prec_P.PX * c.ell_VV);
 
     leave_block("Call to alt_bn128_ate_miller_loop");
     return f;
 }
 
-alt_bn128_Fq12 alt_bn128_ate_double_miller_loop(const alt_bn128_ate_G1_precomp &prec_P1,
-                                     const alt_bn128_ate_G2_precomp &prec_Q1,
-                                     const alt_bn128_ate_G1_precomp &prec_P2,
-                                     const alt_bn128_ate_G2_precomp &prec_Q2)
+alt_bn128_Fq12 alt_bn128_ate_miller_loop(const alt_bn128_ate_G1_precomp &prec_P,
+                                     const alt_bn128_ate_G2_precomp &prec_Q)
 {
-    enter_block("Call to alt_bn128_ate_double_miller_loop");
+    return alt_bn128_ate_miller_loop_inner(prec_P, prec_Q.coeffs.data());
+}
 
+alt_bn128_Fq12 alt_bn128_ate_miller_loop(const alt_bn128_ate_G1_precomp &prec_P,
+                                     const alt_bn128_ate_G2_precomp_view &prec_Q)
+{
+    return alt_bn128_ate_miller_loop_inner(prec_P, prec_Q.coeffs.data());
+}
+
+/* multiply f by the lines at position idx of all pairs, two lines at a time */
+static void alt_bn128_ate_mul_by_lines(alt_bn128_Fq12 &f,
+                                 const std::vector<const alt_bn128_ate_G1_precomp*> &prec_P,
+                                 const std::vector<const alt_bn128_ate_ell_coeffs*> &coeffs,
+                                 const size_t idx)
+{
+    size_t i = 0;
+    for (; i + 1 < prec_P.size(); i += 2)
+    {
+        const alt_bn128_ate_ell_coeffs &c1 = coeffs[i][idx];
+        const alt_bn128_ate_ell_coeffs &c2 = coeffs[i+1][idx];
+        f = f.mul_by_01234(alt_bn128_Fq12::mul_024_by_024(c1.ell_0, prec_P[i]->PY * c1.ell_VW, prec_P[i]->PX * c1.ell_VV,
+                                                          c2.ell_0, prec_P[i+1]->PY * c2.ell_VW, prec_P[i+1]->PX * c2.ell_VV));
+    }
+    if (i < prec_P.size())
+    {
+        const alt_bn128_ate_ell_coeffs &c1 = coeffs[i][idx];
+        f = f.mul_by_024(c1.ell_0, prec_P[i]->PY * c1.ell_VW, prec_P[i]->PX * c1.ell_VV);
+    }
+}
+
+static alt_bn128_Fq12 alt_bn128_ate_multi_miller_loop_inner(const std::vector<const alt_bn128_ate_G1_precomp*> &prec_P,
+                                               const std::vector<const alt_bn128_ate_ell_coeffs*> &coeffs)
+{
     alt_bn128_Fq12 f = alt_bn128_Fq12::one();
 
     bool found_one = false;
@@ -446,23 +480,12 @@ alt_bn128_Fq12 alt_bn128_ate_double_miller_loop(const alt_bn128_ate_G1_precomp &
            alt_bn128_param_p (skipping leading zeros) in MSB to LSB
            order */
 
-        alt_bn128_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-        alt_bn128_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-        ++idx;
-
         f = f.squared();
-
-        f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-        f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+        alt_bn128_ate_mul_by_lines(f, prec_P, coeffs, idx++);
 
         if (bit)
         {
-            alt_bn128_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-            alt_bn128_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-            ++idx;
-
-            f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-            f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+            alt_bn128_ate_mul_by_lines(f, prec_P, coeffs, idx++);
         }
     }
 
@@ -471,23 +494,70 @@ alt_bn128_Fq12 alt_bn128_ate_double_miller_loop(const alt_bn128_ate_G1_precomp &
     	f = f.inverse();
     }
 
-    alt_bn128_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-    alt_bn128_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-    ++idx;
-    f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-    f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+    alt_bn128_ate_mul_by_lines(f, prec_P, coeffs, idx++);
+    alt_bn128_ate_mul_by_lines(f, prec_P, coeffs, idx++);
+
+    return f;
+}
+
+alt_bn128_Fq12 alt_bn128_ate_double_miller_loop(const alt_bn128_ate_G1_precomp &prec_P1,
+                                     const alt_bn128_ate_G2_precomp &prec_Q1,
+                                     const alt_bn128_ate_G1_precomp &prec_P2,
+                                     const alt_bn128_ate_G2_precomp &prec_Q2)
+{
+    enter_block("Call to alt_bn128_ate_double_miller_loop");
+    const alt_bn128_Fq12 f = alt_bn128_ate_multi_miller_loop_inner({ &prec_P1, &prec_P2 }, { prec_Q1.coeffs.data(), prec_Q2.coeffs.data() });
+    leave_block("Call to alt_bn128_ate_double_miller_loop");
 
-    c1 = prec_Q1.coeffs[idx];
-    c2 = prec_Q2.coeffs[idx];
-    ++idx;
-    f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-    f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+    return f;
+}
 
+alt_bn128_Fq12 alt_bn128_ate_double_miller_loop(const alt_bn128_ate_G1_precomp &prec_P1,
+                                     const alt_bn128_ate_G2_precomp_view &prec_Q1,
+                                     const alt_bn128_ate_G1_precomp &prec_P2,
+                                     const alt_bn128_ate_G2_precomp_view &prec_Q2)
+{
+    enter_block("Call to alt_bn128_ate_double_miller_loop");
+    const alt_bn128_Fq12 f = alt_bn128_ate_multi_miller_loop_inner({ &prec_P1, &prec_P2 }, { prec_Q1.coeffs.data(), prec_Q2.coeffs.data() });
     leave_block("Call to alt_bn128_ate_double_miller_loop");
 
     return f;
 }
 
+template<typename G2_precomp_type>
+static alt_bn128_Fq12 alt_bn128_ate_multi_miller_loop_of(const std::vector<alt_bn128_ate_G1_precomp> &prec_P,
+                                                         const std::vector<G2_precomp_type> &prec_Q)
+{
+    assert(prec_P.size() == prec_Q.size());
+    enter_block("Call to alt_bn128_ate_multi_miller_loop");
+
+    std::vector<const alt_bn128_ate_G1_precomp*> P_ptrs;
+    std::vector<const alt_bn128_ate_ell_coeffs*> Q_ptrs;
+    P_ptrs.reserve(prec_P.size());
+    Q_ptrs.reserve(prec_Q.size());
+    for (size_t i = 0; i < prec_P.size(); ++i)
+    {
+        P_ptrs.emplace_back(&prec_P[i]);
+        Q_ptrs.emplace_back(prec_Q[i].coeffs.data());
+    }
+    const alt_bn128_Fq12 f = alt_bn128_ate_multi_miller_loop_inner(P_ptrs, Q_ptrs);
+
+    leave_block("Call to alt_bn128_ate_multi_miller_loop");
+    return f;
+}
+
+alt_bn128_Fq12 alt_bn128_ate_multi_miller_loop(const std::vector<alt_bn128_ate_G1_precomp> &prec_P,
+                                               const std::vector<alt_bn128_ate_G2_precomp> &prec_Q)
+{
+    return alt_bn128_ate_multi_miller_loop_of(prec_P, prec_Q);
+}
+
+alt_bn128_Fq12 alt_bn128_ate_multi_miller_loop(const std::vector<alt_bn128_ate_G1_precomp> &prec_P,
+                                               const std::vector<alt_bn128_ate_G2_precomp_view> &prec_Q)
+{
+    return alt_bn128_ate_multi_miller_loop_of(prec_P, prec_Q);
+}
+
 alt_bn128_Fq12 alt_bn128_ate_pairing(const alt_bn128_G1& P, const alt_bn128_G2 &Q)
 {
     enter_block("Call to alt_bn128_ate_pairing");
@@ -525,6 +595,12 @@ alt_bn128_Fq12 alt_bn128_miller_loop(const alt_bn128_G1_precomp &prec_P,
     return alt_bn128_ate_miller_loop(prec_P, prec_Q);
 }
 
+alt_bn128_Fq12 alt_bn128_miller_loop(const alt_bn128_G1_precomp &prec_P,
+                          const alt_bn128_G2_precomp_view &prec_Q)
+{
+    return alt_bn128_ate_miller_loop(prec_P, prec_Q);
+}
+
 alt_bn128_Fq12 alt_bn128_double_miller_loop(const alt_bn128_G1_precomp &prec_P1,
                                  const alt_bn128_G2_precomp &prec_Q1,
                                  const alt_bn128_G1_precomp &prec_P2,
@@ -533,6 +609,26 @@ alt_bn128_Fq12 alt_bn128_double_miller_loop(const alt_bn128_G1_precomp &prec_P1,
     return alt_bn128_ate_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
 }
 
+alt_bn128_Fq12 alt_bn128_double_miller_loop(const alt_bn128_G1_precomp &prec_P1,
+                                 const alt_bn128_G2_precomp_view &prec_Q1,
+                                 const alt_bn128_G1_precomp &prec_P2,
+                                 const alt_bn128_G2_precomp_view &prec_Q2)
+{
+    return alt_bn128_ate_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
+}
+
+alt_bn128_Fq12 alt_bn128_multi_miller_loop(const std::vector<alt_bn128_G1_precomp> &prec_P,
+                               const std::vector<alt_bn128_G2_precomp> &prec_Q)
+{
+    return alt_bn128_ate_multi_miller_loop(prec_P, prec_Q);
+}
+
+alt_bn128_Fq12 alt_bn128_multi_miller_loop(const std::vector<alt_bn128_G1_precomp> &prec_P,
+                               const std::vector<alt_bn128_G2_precomp_view> &prec_Q)
+{
+    return alt_bn128_ate_multi_miller_loop(prec_P, prec_Q);
+}
+
 alt_bn128_Fq12 alt_bn128_pairing(const alt_bn128_G1& P,
                       const alt_bn128_G2 &Q)
 {
@@ -10,6 +10,8 @@
 #include <vector>
 
 #include <libff/algebra/curves/alt_bn128/alt_bn128_init.hpp>
+#include <libff/algebra/curves/precomp_coeffs.hpp>
+#include <libff/common/memory_accounting.hpp>
 
 namespace libff {
 
@@ -42,21 +44,41 @@ struct alt_bn128_ate_G2_precomp {
     alt_bn128_Fq2 QX;
     alt_bn128_Fq2 QY;
     std::vector<alt_bn128_ate_ell_coeffs> coeffs;
+    mem_charge<mem_tag_pairing_precomp> coeffs_mem;
 
     bool operator==(const alt_bn128_ate_G2_precomp &other) const;
     friend std::ostream& operator<<(std::ostream &out, const alt_bn128_ate_G2_precomp &prec_Q);
     friend std::istream& operator>>(std::istream &in, alt_bn128_ate_G2_precomp &prec_Q);
 };
 
+/* a G2 precomputation whose coefficients are read in place, e.g. from a mapped file (see flat_precomp.hpp) */
+struct alt_bn128_ate_G2_precomp_view {
+    alt_bn128_Fq2 QX;
+    alt_bn128_Fq2 QY;
+    precomp_coeffs_view<alt_bn128_ate_ell_coeffs> coeffs;
+};
+
 alt_bn128_ate_G1_precomp alt_bn128_ate_precompute_G1(const alt_bn128_G1& P);
 alt_bn128_ate_G2_precomp alt_bn128_ate_precompute_G2(const alt_bn128_G2& Q);
 
 alt_bn128_Fq12 alt_bn128_ate_miller_loop(const alt_bn128_ate_G1_precomp &prec_P,
                               const alt_bn128_ate_G2_precomp &prec_Q);
+alt_bn128_Fq12 alt_bn128_ate_miller_loop(const alt_bn128_ate_G1_precomp &prec_P,
+                              const alt_bn128_ate_G2_precomp_view &prec_Q);
 alt_bn128_Fq12 alt_bn128_ate_double_miller_loop(const alt_bn128_ate_G1_precomp &prec_P1,
                                      const alt_bn128_ate_G2_precomp &prec_Q1,
                                      const alt_bn128_ate_G1_precomp &prec_P2,
                                      const alt_bn128_ate_G2_precomp &prec_Q2);
+alt_bn128_Fq12 alt_bn128_ate_double_miller_loop(const alt_bn128_ate_G1_precomp &prec_P1,
+                                     const alt_bn128_ate_G2_precomp_view &prec_Q1,
+                                     const alt_bn128_ate_G1_precomp &prec_P2,
+                                     const alt_bn128_ate_G2_precomp_view &prec_Q2);
+
+/* product of the Miller loops of all pairs (prec_P[i], prec_Q[i]) */
+alt_bn128_Fq12 alt_bn128_ate_multi_miller_loop(const std::vector<alt_bn128_ate_G1_precomp> &prec_P,
+                                   const std::vector<alt_bn128_ate_G2_precomp> &prec_Q);
+alt_bn128_Fq12 alt_bn128_ate_multi_miller_loop(const std::vector<alt_bn128_ate_G1_precomp> &prec_P,
+                                   const std::vector<alt_bn128_ate_G2_precomp_view> &prec_Q);
 
 alt_bn128_Fq12 alt_bn128_ate_pairing(const alt_bn128_G1& P,
                           const alt_bn128_G2 &Q);
@@ -67,6 +89,7 @@ alt_bn128_GT alt_bn128_ate_reduced_pairing(const alt_bn128_G1 &P,
 
 typedef alt_bn128_ate_G1_precomp alt_bn128_G1_precomp;
 typedef alt_bn128_ate_G2_precomp alt_bn128_G2_precomp;
+typedef alt_bn128_ate_G2_precomp_view alt_bn128_G2_precomp_view;
 
 alt_bn128_G1_precomp alt_bn128_precompute_G1(const alt_bn128_G1& P);
 
@@ -74,11 +97,21 @@ alt_bn128_G2_precomp alt_bn128_precompute_G2(const alt_bn128_G2& Q);
 
 alt_bn128_Fq12 alt_bn128_miller_loop(const alt_bn128_G1_precomp &prec_P,
                           const alt_bn128_G2_precomp &prec_Q);
+alt_bn128_Fq12 alt_bn128_miller_loop(const alt_bn128_G1_precomp &prec_P,
+                          const alt_bn128_G2_precomp_view &prec_Q);
 
 alt_bn128_Fq12 alt_bn128_double_miller_loop(const alt_bn128_G1_precomp &prec_P1,
                                  const alt_bn128_G2_precomp &prec_Q1,
                                  const alt_bn128_G1_precomp &prec_P2,
                                  const alt_bn128_G2_precomp &prec_Q2);
+alt_bn128_Fq12 alt_bn128_double_miller_loop(const alt_bn128_G1_precomp &prec_P1,
+                                 const alt_bn128_G2_precomp_view &prec_Q1,
+                                 const alt_bn128_G1_precomp &prec_P2,
+                                 const alt_bn128_G2_precomp_view &prec_Q2);
+alt_bn128_Fq12 alt_bn128_multi_miller_loop(const std::vector<alt_bn128_G1_precomp> &prec_P,
+                               const std::vector<alt_bn128_G2_precomp> &prec_Q);
+alt_bn128_Fq12 alt_bn128_multi_miller_loop(const std::vector<alt_bn128_G1_precomp> &prec_P,
+                               const std::vector<alt_bn128_G2_precomp_view> &prec_Q);
 
 alt_bn128_Fq12 alt_bn128_pairing(const alt_bn128_G1& P,
                       const alt_bn128_G2 &Q);
@@ -22,6 +22,7 @@ public:
     typedef alt_bn128_G2 G2_type;
     typedef alt_bn128_G1_precomp G1_precomp_type;
     typedef alt_bn128_G2_precomp G2_precomp_type;
+    typedef alt_bn128_G2_precomp_view G2_precomp_view_type;
     typedef alt_bn128_Fq Fq_type;
     typedef alt_bn128_Fq2 Fqe_type;
     typedef alt_bn128_Fq12 Fqk_type;
@@ -35,10 +36,20 @@ public:
     static alt_bn128_G2_precomp precompute_G2(const alt_bn128_G2 &Q);
     static alt_bn128_Fq12 miller_loop(const alt_bn128_G1_precomp &prec_P,
                                       const alt_bn128_G2_precomp &prec_Q);
+    static alt_bn128_Fq12 miller_loop(const alt_bn128_G1_precomp &prec_P,
+                                      const alt_bn128_G2_precomp_view &prec_Q);
     static alt_bn128_Fq12 double_miller_loop(const alt_bn128_G1_precomp &prec_P1,
                                              const alt_bn128_G2_precomp &prec_Q1,
                                              const alt_bn128_G1_precomp &prec_P2,
                                              const alt_bn128_G2_precomp &prec_Q2);
+    static alt_bn128_Fq12 double_miller_loop(const alt_bn128_G1_precomp &prec_P1,
+                                             const alt_bn128_G2_precomp_view &prec_Q1,
+                                             const alt_bn128_G1_precomp &prec_P2,
+                                             const alt_bn128_G2_precomp_view &prec_Q2);
+    static alt_bn128_Fq12 multi_miller_loop(const std::vector<alt_bn128_G1_precomp> &prec_P,
+                                      const std::vector<alt_bn128_G2_precomp> &prec_Q);
+    static alt_bn128_Fq12 multi_miller_loop(const std::vector<alt_bn128_G1_precomp> &prec_P,
+                                      const std::vector<alt_bn128_G2_precomp_view> &prec_Q);
     static alt_bn128_Fq12 pairing(const alt_bn128_G1 &P,
                                   const alt_bn128_G2 &Q);
     static alt_bn128_Fq12 reduced_pairing(const alt_bn128_G1 &P,
@@ -0,0 +1,81 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of batch verification of pairing-product equations.
+
+ An equation is  prod_i e(P_i, Q_i) = rhs  with P_i in G1, Q_i in G2 and rhs
+ in GT (e.g. e(alpha, beta) of a Groth16 verification key). A batch of
+ equations is checked at once by raising the j-th equation to a random
+ 128-bit coefficient rho_j (rho_0 = 1) and multiplying them:
+
+   prod_j prod_i e(rho_j * P_ji, Q_ji) = prod_j rhs_j^rho_j.
+
+ On the left, the G1 points of all terms with the same G2 point are folded
+ into one point with a multi-exponentiation, so that a G2 point shared by
+ all equations (such as those of a verification key) takes part in a single
+ Miller loop. The Miller loops of the folded terms are computed together and
+ followed by one final exponentiation. On the right, equal values of rhs
+ are merged before exponentiation.
+
+ If all equations hold the batch is accepted; if one does not, it is
+ rejected except with probability about 2^-128.
+
+ This is only sound for points of the subgroups of prime order r of G1 and
+ G2 and for rhs in GT: components of small order could cancel out in the
+ random linear combination whenever a coefficient rho_j vanishes modulo
+ their order, which happens far more often than 2^-128. Every point is
+ therefore checked to be on its curve, and to be in the subgroup of order r
+ where its group has batch_is_in_correct_subgroup (e.g. G1 of bls12_377,
+ bls12_381 and bw6_761); equations with points that fail the checks are
+ rejected. A G1 of cofactor 1 (as on the BN and MNT curves) needs nothing
+ more; for the other groups (such as G2) and for rhs the caller is
+ responsible, e.g. by taking them from a checked verification key.
+
+ The engine works for every curve of public_params.hpp. It uses
+ ppT::multi_miller_loop where the curve has it, ppT::double_miller_loop
+ otherwise, and for curves without the usual precomputations the product of
+ ppT::pairing.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef BATCH_VERIFY_HPP_
+#define BATCH_VERIFY_HPP_
+
+#include <vector>
+
+#include <libff/algebra/curves/public_params.hpp>
+
+namespace libff {
+
+template<typename ppT>
+struct pairing_product_equation {
+    std::vector<G1<ppT> > P;
+    std::vector<G2<ppT> > Q;
+    GT<ppT> rhs;
+
+    pairing_product_equation() : rhs(GT<ppT>::one()) {}
+
+    /* multiply the left-hand side by e(P, Q) */
+    void add_term(const G1<ppT> &P, const G2<ppT> &Q)
+    {
+        this->P.emplace_back(P);
+        this->Q.emplace_back(Q);
+    }
+};
+
+/**
+ * Whether all equations hold (up to a probability of error of about 2^-128);
+ * false as well if one of the points fails the checks above.
+ */
+template<typename ppT>
+bool batch_verify_pairing_products(const std::vector<pairing_product_equation<ppT> > &equations);
+
+} // libff
+
+#include <libff/algebra/curves/batch_verify.tcc>
+
+#endif // BATCH_VERIFY_HPP_
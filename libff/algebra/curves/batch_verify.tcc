@@ -0,0 +1,271 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of batch verification of pairing-product equations.
+
+ See batch_verify.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef BATCH_VERIFY_TCC_
+#define BATCH_VERIFY_TCC_
+
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <libff/algebra/curves/gt_exp.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <libff/common/execution.hpp>
+#include <libff/common/profiling.hpp>
+
+namespace libff {
+
+/* overload ranking for the choice of Miller loop: higher is tried first */
+template<unsigned N>
+struct batch_verify_priority : batch_verify_priority<N-1> {};
+template<>
+struct batch_verify_priority<0> {};
+
+template<typename ppT>
+auto batch_verify_miller_loop(const std::vector<G1<ppT> > &P,
+                              const std::vector<G2<ppT> > &Q,
+                              batch_verify_priority<2>)
+    -> decltype(ppT::multi_miller_loop(std::vector<G1_precomp<ppT> >(), std::vector<G2_precomp<ppT> >()))
+{
+    std::vector<G1_precomp<ppT> > prec_P(P.size());
+    std::vector<G2_precomp<ppT> > prec_Q(Q.size());
+    parallel_for(0, P.size(), [&](const size_t i) {
+        prec_P[i] = ppT::precompute_G1(P[i]);
+        prec_Q[i] = ppT::precompute_G2(Q[i]);
+    });
+    return ppT::multi_miller_loop(prec_P, prec_Q);
+}
+
+template<typename ppT>
+auto batch_verify_miller_loop(const std::vector<G1<ppT> > &P,
+                              const std::vector<G2<ppT> > &Q,
+                              batch_verify_priority<1>)
+    -> decltype(ppT::double_miller_loop(ppT::precompute_G1(P[0]), ppT::precompute_G2(Q[0]),
+                                        ppT::precompute_G1(P[0]), ppT::precompute_G2(Q[0])))
+{
+    /* pairs of terms, each with a double Miller loop */
+    const size_t num_loops = (P.size() + 1) / 2;
+    std::vector<Fqk<ppT> > partial(num_loops);
+    parallel_for(0, num_loops, [&](const size_t k) {
+        const size_t i = 2 * k;
+        if (i + 1 < P.size())
+        {
+            partial[k] = ppT::double_miller_loop(ppT::precompute_G1(P[i]), ppT::precompute_G2(Q[i]),
+                                                 ppT::precompute_G1(P[i+1]), ppT::precompute_G2(Q[i+1]));
+        }
+        else
+        {
+            partial[k] = ppT::miller_loop(ppT::precompute_G1(P[i]), ppT::precompute_G2(Q[i]));
+        }
+    });
+
+    Fqk<ppT> f = Fqk<ppT>::one();
+    for (const Fqk<ppT> &p : partial)
+    {
+        f = f * p;
+    }
+    return f;
+}
+
+template<typename ppT>
+Fqk<ppT> batch_verify_miller_loop(const std::vector<G1<ppT> > &P,
+                                  const std::vector<G2<ppT> > &Q,
+                                  batch_verify_priority<0>)
+{
+    std::vector<Fqk<ppT> > partial(P.size());
+    parallel_for(0, P.size(), [&](const size_t i) {
+        partial[i] = ppT::pairing(P[i], Q[i]);
+    });
+
+    Fqk<ppT> f = Fqk<ppT>::one();
+    for (const Fqk<ppT> &p : partial)
+    {
+        f = f * p;
+    }
+    return f;
+}
+
+/* the product of rhs[k]^exponents[k]; GT_multi_exp where GT has the Frobenius map */
+template<typename ppT>
+auto batch_verify_rhs(const std::vector<GT<ppT> > &rhs,
+                      const std::vector<Fr<ppT> > &exponents,
+                      batch_verify_priority<1>)
+    -> decltype(rhs[0].Frobenius_map(1).cyclotomic_squared())
+{
+    return GT_multi_exp<ppT>(rhs, exponents);
+}
+
+template<typename ppT>
+GT<ppT> batch_verify_rhs(const std::vector<GT<ppT> > &rhs,
+                         const std::vector<Fr<ppT> > &exponents,
+                         batch_verify_priority<0>)
+{
+    GT<ppT> result = GT<ppT>::one();
+    for (size_t k = 0; k < rhs.size(); ++k)
+    {
+        result = result * (rhs[k] ^ exponents[k]);
+    }
+    return result;
+}
+
+/* whether all points are in the subgroup of order r, where the group can check it */
+template<typename GroupT>
+auto batch_verify_in_subgroup(const std::vector<GroupT> &points, batch_verify_priority<1>)
+    -> decltype(GroupT::batch_is_in_correct_subgroup(points))
+{
+    return GroupT::batch_is_in_correct_subgroup(points);
+}
+
+template<typename GroupT>
+bool batch_verify_in_subgroup(const std::vector<GroupT> &, batch_verify_priority<0>)
+{
+    return true;
+}
+
+/* whether all points are on the curve and, where the group can check it, in the subgroup of order r */
+template<typename GroupT>
+bool batch_verify_check_points(const std::vector<GroupT> &points)
+{
+    for (const GroupT &point : points)
+    {
+        if (!point.is_well_formed())
+        {
+            return false;
+        }
+    }
+    return batch_verify_in_subgroup(points, batch_verify_priority<1>());
+}
+
+/* a uniformly random coefficient of 128 bits */
+template<typename FieldT>
+FieldT batch_verify_coefficient()
+{
+    static_assert(FieldT::num_limbs * GMP_NUMB_BITS > 128, "the scalar field must hold 128-bit coefficients");
+    bigint<128 / GMP_NUMB_BITS> random;
+    random.randomize();
+
+    bigint<FieldT::num_limbs> value;
+    for (size_t i = 0; i < 128 / GMP_NUMB_BITS; ++i)
+    {
+        value.data[i] = random.data[i];
+    }
+    return FieldT(value);
+}
+
+template<typename ppT>
+bool batch_verify_pairing_products(const std::vector<pairing_product_equation<ppT> > &equations)
+{
+    enter_block("Call to batch_verify_pairing_products");
+
+    /* terms grouped by their G2 point, identified by its serialization in affine coordinates */
+    std::map<std::string, size_t> group_of_point;
+    std::vector<G2<ppT> > group_Q;
+    std::vector<std::vector<G1<ppT> > > group_P;
+    std::vector<std::vector<Fr<ppT> > > group_coeffs;
+
+    /* equal right-hand sides merged, identified by their serialization */
+    std::map<std::string, size_t> index_of_rhs;
+    std::vector<GT<ppT> > distinct_rhs;
+    std::vector<Fr<ppT> > rhs_exponents;
+
+    std::vector<G1<ppT> > all_P;
+    std::vector<G2<ppT> > all_Q;
+
+    for (size_t j = 0; j < equations.size(); ++j)
+    {
+        const pairing_product_equation<ppT> &eq = equations[j];
+        if (eq.P.size() != eq.Q.size())
+        {
+            throw std::invalid_argument("batch_verify_pairing_products: different numbers of G1 and G2 points");
+        }
+
+        const Fr<ppT> rho = (j == 0 ? Fr<ppT>::one() : batch_verify_coefficient<Fr<ppT> >());
+
+        for (size_t i = 0; i < eq.P.size(); ++i)
+        {
+            if (eq.P[i].is_zero() || eq.Q[i].is_zero())
+            {
+                continue;
+            }
+            std::ostringstream key;
+            key << eq.Q[i];
+            const auto it = group_of_point.emplace(key.str(), group_Q.size());
+            if (it.second)
+            {
+                group_Q.emplace_back(eq.Q[i]);
+                group_P.emplace_back();
+                group_coeffs.emplace_back();
+            }
+            group_P[it.first->second].emplace_back(eq.P[i]);
+            group_coeffs[it.first->second].emplace_back(rho);
+        }
+
+        all_P.insert(all_P.end(), eq.P.begin(), eq.P.end());
+        all_Q.insert(all_Q.end(), eq.Q.begin(), eq.Q.end());
+
+        std::ostringstream rhs_key;
+        rhs_key << eq.rhs;
+        const auto k = index_of_rhs.emplace(rhs_key.str(), distinct_rhs.size());
+        if (k.second)
+        {
+            distinct_rhs.emplace_back(eq.rhs);
+            rhs_exponents.emplace_back(Fr<ppT>::zero());
+        }
+        rhs_exponents[k.first->second] += rho;
+    }
+
+    if (!batch_verify_check_points(all_P) || !batch_verify_check_points(all_Q))
+    {
+        leave_block("Call to batch_verify_pairing_products");
+        return false;
+    }
+
+    /* fold the G1 points of each group */
+    std::vector<G1<ppT> > folded_P(group_Q.size());
+    parallel_for(0, group_Q.size(), [&](const size_t g) {
+        if (group_P[g].size() == 1)
+        {
+            folded_P[g] = group_coeffs[g][0] * group_P[g][0];
+        }
+        else
+        {
+            folded_P[g] = multi_exp<G1<ppT>, Fr<ppT>, multi_exp_method_BDLO12>(
+                group_P[g].cbegin(), group_P[g].cend(), group_coeffs[g].cbegin(), group_coeffs[g].cend(), 1);
+        }
+    });
+
+    std::vector<G1<ppT> > P;
+    std::vector<G2<ppT> > Q;
+    for (size_t g = 0; g < group_Q.size(); ++g)
+    {
+        if (!folded_P[g].is_zero())
+        {
+            P.emplace_back(folded_P[g]);
+            Q.emplace_back(group_Q[g]);
+        }
+    }
+
+    const GT<ppT> expected = batch_verify_rhs<ppT>(distinct_rhs, rhs_exponents, batch_verify_priority<1>());
+
+    const GT<ppT> lhs = (P.empty() ? GT<ppT>::one() :
+                         ppT::final_exponentiation(batch_verify_miller_loop<ppT>(P, Q, batch_verify_priority<2>())));
+    const bool result = (lhs == expected);
+
+    leave_block("Call to batch_verify_pairing_products");
+    return result;
+}
+
+} // libff
+
+#endif // BATCH_VERIFY_TCC_
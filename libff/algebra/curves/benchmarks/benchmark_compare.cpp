@@ -0,0 +1,67 @@
+/** @file
+ *****************************************************************************
+
+ Compare two JSON files written by the curve benchmarks:
+
+     benchmark_compare baseline.json current.json [--threshold PERCENT]
+
+ Prints the change of every benchmark and exits with status 1 if any of them
+ got slower by more than the threshold (default 5%).
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <libff/common/benchmark.hpp>
+
+using namespace libff;
+
+int main(int argc, char **argv)
+{
+    double threshold_percent = 5;
+    const char *paths[2] = { nullptr, nullptr };
+    size_t num_paths = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc)
+        {
+            threshold_percent = atof(argv[++i]);
+        }
+        else if (num_paths < 2 && argv[i][0] != '-')
+        {
+            paths[num_paths++] = argv[i];
+        }
+        else
+        {
+            num_paths = 0;
+            break;
+        }
+    }
+
+    if (num_paths != 2)
+    {
+        fprintf(stderr, "usage: %s baseline.json current.json [--threshold PERCENT]\n", argv[0]);
+        return 2;
+    }
+
+    try
+    {
+        const benchmark_run baseline = read_benchmark_json(paths[0]);
+        const benchmark_run current = read_benchmark_json(paths[1]);
+        const size_t regressions = compare_benchmark_results(baseline, current, threshold_percent);
+        return (regressions > 0 ? 1 : 0);
+    }
+    catch (const std::runtime_error &e)
+    {
+        fprintf(stderr, "benchmark_compare: %s\n", e.what());
+        return 2;
+    }
+}
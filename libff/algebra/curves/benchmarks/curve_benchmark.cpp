@@ -0,0 +1,107 @@
+/** @file
+ *****************************************************************************
+
+ Benchmark binary for a single curve, selected at compile time with
+ BENCHMARK_CURVE_<curve> (the build defines one benchmark_<curve> target per
+ curve). Run with --help for the options; results are written as JSON to
+ <curve>.json unless --output is given, and can be compared with
+ benchmark_compare.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#if defined(BENCHMARK_CURVE_ALT_BN128)
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+typedef libff::alt_bn128_pp benchmark_ppT;
+static const char *benchmark_curve_name = "alt_bn128";
+#elif defined(BENCHMARK_CURVE_BLS12_377)
+#include <libff/algebra/curves/bls12_377/bls12_377_pp.hpp>
+typedef libff::bls12_377_pp benchmark_ppT;
+static const char *benchmark_curve_name = "bls12_377";
+#elif defined(BENCHMARK_CURVE_BLS12_381)
+#include <libff/algebra/curves/bls12_381/bls12_381_pp.hpp>
+typedef libff::bls12_381_pp benchmark_ppT;
+static const char *benchmark_curve_name = "bls12_381";
+#elif defined(BENCHMARK_CURVE_BN128)
+#include <libff/algebra/curves/bn128/bn128_pp.hpp>
+typedef libff::bn128_pp benchmark_ppT;
+static const char *benchmark_curve_name = "bn128";
+#elif defined(BENCHMARK_CURVE_BW6_761)
+#include <libff/algebra/curves/bw6_761/bw6_761_pp.hpp>
+typedef libff::bw6_761_pp benchmark_ppT;
+static const char *benchmark_curve_name = "bw6_761";
+#elif defined(BENCHMARK_CURVE_BW12_446)
+#include <libff/algebra/curves/bw12_446/bw12_446_pp.hpp>
+typedef libff::bw12_446_pp benchmark_ppT;
+static const char *benchmark_curve_name = "bw12_446";
+#elif defined(BENCHMARK_CURVE_EDWARDS)
+#include <libff/algebra/curves/edwards/edwards_pp.hpp>
+typedef libff::edwards_pp benchmark_ppT;
+static const char *benchmark_curve_name = "edwards";
+#elif defined(BENCHMARK_CURVE_MNT4)
+#include <libff/algebra/curves/mnt/mnt4/mnt4_pp.hpp>
+typedef libff::mnt4_pp benchmark_ppT;
+static const char *benchmark_curve_name = "mnt4";
+#elif defined(BENCHMARK_CURVE_MNT6)
+#include <libff/algebra/curves/mnt/mnt6/mnt6_pp.hpp>
+typedef libff::mnt6_pp benchmark_ppT;
+static const char *benchmark_curve_name = "mnt6";
+#elif defined(BENCHMARK_CURVE_MNT4753)
+#include <libff/algebra/curves/mnt753/mnt4753/mnt4753_pp.hpp>
+typedef libff::mnt4753_pp benchmark_ppT;
+static const char *benchmark_curve_name = "mnt4753";
+#elif defined(BENCHMARK_CURVE_MNT6753)
+#include <libff/algebra/curves/mnt753/mnt6753/mnt6753_pp.hpp>
+typedef libff::mnt6753_pp benchmark_ppT;
+static const char *benchmark_curve_name = "mnt6753";
+#elif defined(BENCHMARK_CURVE_PENDULUM)
+#include <libff/algebra/curves/pendulum/pendulum_pp.hpp>
+typedef libff::pendulum_pp benchmark_ppT;
+static const char *benchmark_curve_name = "pendulum";
+#elif defined(BENCHMARK_CURVE_SW6)
+#include <libff/algebra/curves/sw6/sw6_pp.hpp>
+typedef libff::sw6_pp benchmark_ppT;
+static const char *benchmark_curve_name = "sw6";
+#else
+#error "define BENCHMARK_CURVE_<curve> to select the curve to benchmark"
+#endif
+
+#include <libff/algebra/curves/benchmarks/curve_benchmarks.hpp>
+#include <libff/common/profiling.hpp>
+
+#if defined(BENCHMARK_CURVE_BN128)
+namespace libff {
+
+/* the extension fields of bn128 are those of the ate-pairing library, without the libff field interface */
+template<>
+void benchmark_curve_fields<bn128_pp>(benchmark_suite &suite)
+{
+    benchmark_field<Fr<bn128_pp> >(suite, "Fr");
+    benchmark_field_sqrt<Fr<bn128_pp> >(suite, "Fr");
+    benchmark_field<Fq<bn128_pp> >(suite, "Fq");
+    benchmark_field_sqrt<Fq<bn128_pp> >(suite, "Fq");
+}
+
+} // libff
+#endif
+
+using namespace libff;
+
+int main(int argc, char **argv)
+{
+    benchmark_suite suite(benchmark_curve_name);
+    if (!suite.parse_args(argc, argv))
+    {
+        return 2;
+    }
+
+    inhibit_profiling_info = true;
+    benchmark_ppT::init_public_params();
+
+    benchmark_curve<benchmark_ppT>(suite);
+
+    return suite.finish();
+}
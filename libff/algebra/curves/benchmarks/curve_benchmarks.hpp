@@ -0,0 +1,59 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of the benchmarks run for every curve.
+
+ Covers field arithmetic (Fr, Fq, Fqe, Fqk), group arithmetic (G1, G2), the
+ pairing stages, multi-exponentiation methods over sizes 2^min_log_size to
+ 2^max_log_size, and fixed-base batch exponentiation. See curve_benchmark.cpp
+ for the per-curve binaries and benchmark.hpp for the harness.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef CURVE_BENCHMARKS_HPP_
+#define CURVE_BENCHMARKS_HPP_
+
+#include <string>
+
+#include <libff/algebra/curves/public_params.hpp>
+#include <libff/common/benchmark.hpp>
+
+namespace libff {
+
+/* mul, square and inverse */
+template<typename FieldT>
+void benchmark_field(benchmark_suite &suite, const std::string &name);
+
+template<typename FieldT>
+void benchmark_field_sqrt(benchmark_suite &suite, const std::string &name);
+
+/* add, dbl, mixed_add and scalar_mul */
+template<typename GroupT, typename ScalarT>
+void benchmark_group(benchmark_suite &suite, const std::string &name);
+
+/* precomputation, Miller loop(s) and final exponentiation */
+template<typename ppT>
+void benchmark_pairing(benchmark_suite &suite);
+
+template<typename GroupT, typename ScalarT>
+void benchmark_multi_exp(benchmark_suite &suite, const std::string &name);
+
+template<typename GroupT, typename ScalarT>
+void benchmark_batch_exp(benchmark_suite &suite, const std::string &name);
+
+/* Fr, Fq, Fqe and Fqk; specialized for curves whose extension fields are not libff fields */
+template<typename ppT>
+void benchmark_curve_fields(benchmark_suite &suite);
+
+template<typename ppT>
+void benchmark_curve(benchmark_suite &suite);
+
+} // libff
+
+#include <libff/algebra/curves/benchmarks/curve_benchmarks.tcc>
+
+#endif // CURVE_BENCHMARKS_HPP_
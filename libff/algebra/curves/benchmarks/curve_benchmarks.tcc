@@ -0,0 +1,344 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of the benchmarks run for every curve.
+
+ See curve_benchmarks.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef CURVE_BENCHMARKS_TCC_
+#define CURVE_BENCHMARKS_TCC_
+
+#include <vector>
+
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+
+namespace libff {
+
+template<typename FieldT>
+void benchmark_field(benchmark_suite &suite, const std::string &name)
+{
+    const FieldT b = FieldT::random_element();
+
+    suite.run(name + "::mul", 1, [&b](const size_t iterations) {
+        FieldT a = FieldT::random_element();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            a = a * b;
+        }
+        benchmark_keep(a);
+    });
+
+    suite.run(name + "::square", 1, [](const size_t iterations) {
+        FieldT a = FieldT::random_element();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            a = a.squared();
+        }
+        benchmark_keep(a);
+    });
+
+    suite.run(name + "::inverse", 1, [](const size_t iterations) {
+        FieldT a = FieldT::random_element();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            a = a.inverse();
+        }
+        benchmark_keep(a);
+    });
+}
+
+template<typename FieldT>
+void benchmark_field_sqrt(benchmark_suite &suite, const std::string &name)
+{
+    const FieldT square = FieldT::random_element().squared();
+
+    suite.run(name + "::sqrt", 1, [&square](const size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            const FieldT root = square.sqrt();
+            benchmark_keep(root);
+        }
+    });
+}
+
+template<typename GroupT, typename ScalarT>
+void benchmark_group(benchmark_suite &suite, const std::string &name)
+{
+    GroupT Q = GroupT::random_element();
+
+    suite.run(name + "::add", 1, [&Q](const size_t iterations) {
+        GroupT P = GroupT::random_element();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            P = P + Q;
+        }
+        benchmark_keep(P);
+    });
+
+    suite.run(name + "::dbl", 1, [](const size_t iterations) {
+        GroupT P = GroupT::random_element();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            P = P.dbl();
+        }
+        benchmark_keep(P);
+    });
+
+    Q.to_special();
+    suite.run(name + "::mixed_add", 1, [&Q](const size_t iterations) {
+        GroupT P = GroupT::random_element();
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            P = P.mixed_add(Q);
+        }
+        benchmark_keep(P);
+    });
+
+    const ScalarT s = ScalarT::random_element();
+    suite.run(name + "::scalar_mul", 1, [&Q, &s](const size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            const GroupT R = s * Q;
+            benchmark_keep(R);
+        }
+    });
+}
+
+template<typename ppT>
+void benchmark_pairing(benchmark_suite &suite)
+{
+    const G1<ppT> P1 = G1<ppT>::random_element();
+    const G2<ppT> Q1 = G2<ppT>::random_element();
+    const G1<ppT> P2 = G1<ppT>::random_element();
+    const G2<ppT> Q2 = G2<ppT>::random_element();
+
+    const G1_precomp<ppT> prec_P1 = ppT::precompute_G1(P1);
+    const G2_precomp<ppT> prec_Q1 = ppT::precompute_G2(Q1);
+    const G1_precomp<ppT> prec_P2 = ppT::precompute_G1(P2);
+    const G2_precomp<ppT> prec_Q2 = ppT::precompute_G2(Q2);
+    const Fqk<ppT> f = ppT::miller_loop(prec_P1, prec_Q1);
+
+    suite.run("pairing::precompute_G1", 1, [&P1](const size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            const G1_precomp<ppT> prec = ppT::precompute_G1(P1);
+            benchmark_keep(prec);
+        }
+    });
+
+    suite.run("pairing::precompute_G2", 1, [&Q1](const size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            const G2_precomp<ppT> prec = ppT::precompute_G2(Q1);
+            benchmark_keep(prec);
+        }
+    });
+
+    suite.run("pairing::miller_loop", 1, [&](const size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            const Fqk<ppT> r = ppT::miller_loop(prec_P1, prec_Q1);
+            benchmark_keep(r);
+        }
+    });
+
+    suite.run("pairing::double_miller_loop", 1, [&](const size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            const Fqk<ppT> r = ppT::double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
+            benchmark_keep(r);
+        }
+    });
+
+    suite.run("pairing::final_exponentiation", 1, [&f](const size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            const GT<ppT> r = ppT::final_exponentiation(f);
+            benchmark_keep(r);
+        }
+    });
+
+    suite.run("pairing::reduced_pairing", 1, [&P1, &Q1](const size_t iterations) {
+        for (size_t i = 0; i < iterations; ++i)
+        {
+            const GT<ppT> r = ppT::reduced_pairing(P1, Q1);
+            benchmark_keep(r);
+        }
+    });
+}
+
+/* Distinct bases in special form, computed with one addition each rather than a scalar multiplication. */
+template<typename GroupT>
+std::vector<GroupT> benchmark_bases(const size_t count)
+{
+    std::vector<GroupT> bases(count);
+    const GroupT step = GroupT::random_element();
+    GroupT current = GroupT::random_element();
+    for (size_t i = 0; i < count; ++i)
+    {
+        bases[i] = current;
+        current = current + step;
+    }
+    GroupT::batch_to_special_all_non_zeros(bases);
+    return bases;
+}
+
+template<typename GroupT, typename ScalarT>
+void benchmark_multi_exp(benchmark_suite &suite, const std::string &name)
+{
+    const std::string naive_plain_name = name + "::multi_exp<naive_plain>";
+    const std::string bos_coster_name = name + "::multi_exp<bos_coster>";
+    const std::string BDLO12_name = name + "::multi_exp<BDLO12>";
+    const std::string BDLO12_small_scalars_name = name + "::multi_exp<BDLO12_small_scalars>";
+    const std::string mixed_addition_name = name + "::multi_exp_with_mixed_addition<BDLO12>";
+    if (!suite.enabled(naive_plain_name) && !suite.enabled(bos_coster_name) &&
+        !suite.enabled(BDLO12_name) && !suite.enabled(BDLO12_small_scalars_name) &&
+        !suite.enabled(mixed_addition_name))
+    {
+        return;
+    }
+
+    const size_t max_size = 1ul << suite.max_log_size;
+    const std::vector<GroupT> bases = benchmark_bases<GroupT>(max_size);
+    std::vector<ScalarT> scalars(max_size);
+    for (size_t i = 0; i < max_size; ++i)
+    {
+        scalars[i] = ScalarT::random_element();
+    }
+
+    const size_t chunks = suite.chunks;
+    for (size_t log_size = suite.min_log_size; log_size <= suite.max_log_size; ++log_size)
+    {
+        const size_t size = 1ul << log_size;
+        const auto bases_end = bases.cbegin() + size;
+        const auto scalars_end = scalars.cbegin() + size;
+
+        if (log_size <= 12)
+        {
+            suite.run(naive_plain_name, size, [&](const size_t iterations) {
+                for (size_t i = 0; i < iterations; ++i)
+                {
+                    const GroupT r = multi_exp<GroupT, ScalarT, multi_exp_method_naive_plain>(
+                        bases.cbegin(), bases_end, scalars.cbegin(), scalars_end, chunks);
+                    benchmark_keep(r);
+                }
+            });
+        }
+
+        suite.run(bos_coster_name, size, [&](const size_t iterations) {
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                const GroupT r = multi_exp<GroupT, ScalarT, multi_exp_method_bos_coster>(
+                    bases.cbegin(), bases_end, scalars.cbegin(), scalars_end, chunks);
+                benchmark_keep(r);
+            }
+        });
+
+        suite.run(BDLO12_name, size, [&](const size_t iterations) {
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                const GroupT r = multi_exp<GroupT, ScalarT, multi_exp_method_BDLO12>(
+                    bases.cbegin(), bases_end, scalars.cbegin(), scalars_end, chunks);
+                benchmark_keep(r);
+            }
+        });
+
+        suite.run(BDLO12_small_scalars_name, size, [&](const size_t iterations) {
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                const GroupT r = multi_exp<GroupT, ScalarT, multi_exp_method_BDLO12_small_scalars>(
+                    bases.cbegin(), bases_end, scalars.cbegin(), scalars_end, chunks);
+                benchmark_keep(r);
+            }
+        });
+
+        suite.run(mixed_addition_name, size, [&](const size_t iterations) {
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                const GroupT r = multi_exp_with_mixed_addition<GroupT, ScalarT, multi_exp_method_BDLO12>(
+                    bases.cbegin(), bases_end, scalars.cbegin(), scalars_end, chunks);
+                benchmark_keep(r);
+            }
+        });
+    }
+}
+
+template<typename GroupT, typename ScalarT>
+void benchmark_batch_exp(benchmark_suite &suite, const std::string &name)
+{
+    if (!suite.enabled(name + "::batch_exp") && !suite.enabled(name + "::batch_exp_affine"))
+    {
+        return;
+    }
+
+    const size_t scalar_size = ScalarT::size_in_bits();
+    const GroupT base = GroupT::random_element();
+    std::vector<ScalarT> scalars(1ul << suite.max_log_size);
+    for (size_t i = 0; i < scalars.size(); ++i)
+    {
+        scalars[i] = ScalarT::random_element();
+    }
+
+    for (size_t log_size = suite.min_log_size; log_size <= suite.max_log_size; ++log_size)
+    {
+        const size_t size = 1ul << log_size;
+        const std::vector<ScalarT> v(scalars.begin(), scalars.begin() + size);
+        const size_t window = get_exp_window_size<GroupT>(size);
+        const window_table<GroupT> table = get_window_table(scalar_size, window, base);
+
+        suite.run(name + "::batch_exp", size, [&](const size_t iterations) {
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                const std::vector<GroupT> r = batch_exp(scalar_size, window, table, v);
+                benchmark_keep(r);
+            }
+        });
+
+        suite.run(name + "::batch_exp_affine", size, [&](const size_t iterations) {
+            for (size_t i = 0; i < iterations; ++i)
+            {
+                const std::vector<GroupT> r = batch_exp_affine(scalar_size, window, table, v);
+                benchmark_keep(r);
+            }
+        });
+    }
+}
+
+template<typename ppT>
+void benchmark_curve_fields(benchmark_suite &suite)
+{
+    benchmark_field<Fr<ppT> >(suite, "Fr");
+    benchmark_field_sqrt<Fr<ppT> >(suite, "Fr");
+    benchmark_field<Fq<ppT> >(suite, "Fq");
+    benchmark_field_sqrt<Fq<ppT> >(suite, "Fq");
+    benchmark_field<Fqe<ppT> >(suite, "Fqe");
+    benchmark_field_sqrt<Fqe<ppT> >(suite, "Fqe");
+    benchmark_field<Fqk<ppT> >(suite, "Fqk");
+}
+
+template<typename ppT>
+void benchmark_curve(benchmark_suite &suite)
+{
+    benchmark_curve_fields<ppT>(suite);
+
+    benchmark_group<G1<ppT>, Fr<ppT> >(suite, "G1");
+    benchmark_group<G2<ppT>, Fr<ppT> >(suite, "G2");
+
+    benchmark_pairing<ppT>(suite);
+
+    benchmark_multi_exp<G1<ppT>, Fr<ppT> >(suite, "G1");
+    benchmark_multi_exp<G2<ppT>, Fr<ppT> >(suite, "G2");
+
+    benchmark_batch_exp<G1<ppT>, Fr<ppT> >(suite, "G1");
+    benchmark_batch_exp<G2<ppT>, Fr<ppT> >(suite, "G2");
+}
+
+} // libff
+
+#endif // CURVE_BENCHMARKS_TCC_
@@ -5,13 +5,16 @@
  * @copyright  MIT license (see LICENSE file)
  *****************************************************************************/
 
+#include <atomic>
+
 #include <libff/algebra/curves/bls12_377/bls12_377_g1.hpp>
+#include <libff/common/execution.hpp>
 
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long bls12_377_G1::add_cnt = 0;
-long long bls12_377_G1::dbl_cnt = 0;
+op_counter bls12_377_G1::add_cnt("bls12_377_G1::add");
+op_counter bls12_377_G1::dbl_cnt("bls12_377_G1::dbl");
 #endif
 
 std::vector<size_t> bls12_377_G1::wnaf_window_table;
@@ -179,6 +182,10 @@ bls12_377_G1 bls12_377_G1::operator+(const bls12_377_G1 &other) const
         return this->dbl();
     }
 
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
+
     // rest of add case
     bls12_377_Fq H = U2 - U1;                            // H = U2-U1
     bls12_377_Fq S2_minus_S1 = S2-S1;
@@ -386,6 +393,30 @@ bool bls12_377_G1::is_well_formed() const
     }
 }
 
+bool bls12_377_G1::is_in_correct_subgroup() const
+{
+    /*
+      phi(x, y) = (beta * x, y) acts on G1 as multiplication by -u^2. The
+      points of E(Fq) with phi(P) = -[u^2]P form the kernel of phi + u^2,
+      of order u^4 - u^2 + 1 = r, so the check is exact with a scalar of
+      half the size of r.
+    */
+    const bls12_377_G1 phi(bls12_377_g1_endomorphism_beta * this->X, this->Y, this->Z);
+    return phi == -(bls12_377_g1_endomorphism_u_squared * (*this));
+}
+
+bool bls12_377_G1::batch_is_in_correct_subgroup(const std::vector<bls12_377_G1> &vec)
+{
+    std::atomic<bool> result(true);
+    parallel_for(0, vec.size(), [&](const size_t i) {
+        if (result.load(std::memory_order_relaxed) && !vec[i].is_in_correct_subgroup())
+        {
+            result.store(false, std::memory_order_relaxed);
+        }
+    });
+    return result.load();
+}
+
 bls12_377_G1 bls12_377_G1::zero()
 {
     return G1_zero;
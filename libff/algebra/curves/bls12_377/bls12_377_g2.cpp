@@ -10,8 +10,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long bls12_377_G2::add_cnt = 0;
-long long bls12_377_G2::dbl_cnt = 0;
+op_counter bls12_377_G2::add_cnt("bls12_377_G2::add");
+op_counter bls12_377_G2::dbl_cnt("bls12_377_G2::dbl");
 #endif
 
 std::vector<size_t> bls12_377_G2::wnaf_window_table;
@@ -189,6 +189,10 @@ bls12_377_G2 bls12_377_G2::operator+(const bls12_377_G2 &other) const
         return this->dbl();
     }
 
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
+
     // rest of add case
     bls12_377_Fq2 H = U2 - U1;                            // H = U2-U1
     bls12_377_Fq2 S2_minus_S1 = S2-S1;
@@ -21,8 +21,8 @@ std::istream& operator>>(std::istream &, bls12_377_G2&);
 class bls12_377_G2 {
 public:
 #ifdef PROFILE_OP_COUNTS
-    static long long add_cnt;
-    static long long dbl_cnt;
+    static op_counter add_cnt;
+    static op_counter dbl_cnt;
 #endif
     static std::vector<size_t> wnaf_window_table;
     static std::vector<size_t> fixed_base_exp_window_table;
@@ -15,6 +15,9 @@ bls12_377_Fq bls12_377_twist_mul_by_b_c1;
 bls12_377_Fq2 bls12_377_twist_mul_by_q_X;
 bls12_377_Fq2 bls12_377_twist_mul_by_q_Y;
 
+bls12_377_Fq bls12_377_g1_endomorphism_beta;
+bigint<bls12_377_r_limbs> bls12_377_g1_endomorphism_u_squared;
+
 bigint<bls12_377_q_limbs> bls12_377_ate_loop_count;
 bool bls12_377_ate_is_loop_count_neg;
 bigint<12*bls12_377_q_limbs> bls12_377_final_exponent;
@@ -26,6 +29,11 @@ void init_bls12_377_params()
     typedef bigint<bls12_377_r_limbs> bigint_r;
     typedef bigint<bls12_377_q_limbs> bigint_q;
 
+#ifdef PROFILE_OP_COUNTS
+    bls12_377_Fr::name_op_counters("bls12_377_Fr");
+    bls12_377_Fq::name_op_counters("bls12_377_Fq");
+#endif
+
     assert(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
 
     /* parameters for scalar field Fr */
@@ -142,6 +150,8 @@ void init_bls12_377_params()
     bls12_377_G1::G1_one = bls12_377_G1(bls12_377_Fq("81937999373150964239938255573465948239988671502647976594219695644855304257327692006745978603320413799295628339695"),
                                     bls12_377_Fq("241266749859715473739788878240585681733927191168601896383759122102112907357779751001206799952863815012735208165030"),
                                     bls12_377_Fq::one());
+    bls12_377_g1_endomorphism_beta = bls12_377_Fq("258664426012969093929703085429980814127835149614277183275038967946009968870203535512256352201271898244626862047231");
+    bls12_377_g1_endomorphism_u_squared = bigint_r("91893752504881257701523279626832445441");
 
     // TODO: wNAF window table
     bls12_377_G1::wnaf_window_table.resize(0);
@@ -11,6 +11,7 @@
 #include <libff/algebra/curves/bls12_377/bls12_377_g2.hpp>
 #include <libff/algebra/curves/bls12_377/bls12_377_init.hpp>
 #include <libff/algebra/curves/bls12_377/bls12_377_pairing.hpp>
+#include <libff/common/memory_accounting.hpp>
 #include <libff/common/profiling.hpp>
 
 namespace libff {
@@ -102,6 +103,8 @@ std::istream& operator>>(std::istream& in, bls12_377_ate_G2_precomp &prec_Q)
         prec_Q.coeffs.emplace_back(c);
     }
 
+    prec_Q.coeffs_mem.set(prec_Q.coeffs.capacity() * sizeof(bls12_377_ate_ell_coeffs));
+
     return in;
 }
 
@@ -305,12 +308,14 @@ bls12_377_ate_G2_precomp bls12_377_ate_precompute_G2(const bls12_377_G2& Q)
         }
     }
 
+    result.coeffs_mem.set(result.coeffs.capacity() * sizeof(bls12_377_ate_ell_coeffs));
+
     leave_block("Call to bls12_377_ate_precompute_G2");
     return result;
 }
 
-bls12_377_Fq12 bls12_377_ate_miller_loop(const bls12_377_ate_G1_precomp &prec_P,
-                                     const bls12_377_ate_G2_precomp &prec_Q)
+static bls12_377_Fq12 bls12_377_ate_miller_loop_inner(const bls12_377_ate_G1_precomp &prec_P,
+                                                      const bls12_377_ate_ell_coeffs *coeffs)
 {
     enter_block("Call to bls12_377_ate_miller_loop");
 
@@ -336,13 +341,13 @@ bls12_377_Fq12 bls12_377_ate_miller_loop(const bls12_377_ate_G1_precomp &prec_P,
            bls12_377_param_p (skipping leading zeros) in MSB to LSB
            order */
 
-        c = prec_Q.coeffs[idx++];
+        c = coeffs[idx++];
         f = f.squared();
         f = f.mul_by_024(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
 
         if (bit)
         {
-            c = prec_Q.coeffs[idx++];
+            c = coeffs[idx++];
             f = f.mul_by_024(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
         }
 
@@ -354,10 +359,10 @@ bls12_377_Fq12 bls12_377_ate_miller_loop(const bls12_377_ate_G1_precomp &prec_P,
     }
 
     /*
-    c = prec_Q.coeffs[idx++];
+    c = coeffs[idx++];
     f = f.mul_by_024(c.ell_0,prec_P.PY * c.ell_VW,prec_P.PX * c.ell_VV);
 
-    c = prec_Q.coeffs[idx++];
+    c = coeffs[idx++];
     f = f.mul_by_024(c.ell_0,prec_P.PY * c.ell_VW,prec_P.PX * c.ell_VV);
     */
 
@@ -365,13 +370,42 @@ bls12_377_Fq12 bls12_377_ate_miller_loop(const bls12_377_ate_G1_precomp &prec_P,
     return f;
 }
 
-bls12_377_Fq12 bls12_377_ate_double_miller_loop(const bls12_377_ate_G1_precomp &prec_P1,
-                                     const bls12_377_ate_G2_precomp &prec_Q1,
-                                     const bls12_377_ate_G1_precomp &prec_P2,
-                                     const bls12_377_ate_G2_precomp &prec_Q2)
+bls12_377_Fq12 bls12_377_ate_miller_loop(const bls12_377_ate_G1_precomp &prec_P,
+                                     const bls12_377_ate_G2_precomp &prec_Q)
 {
-    enter_block("Call to bls12_377_ate_double_miller_loop");
+    return bls12_377_ate_miller_loop_inner(prec_P, prec_Q.coeffs.data());
+}
+
+bls12_377_Fq12 bls12_377_ate_miller_loop(const bls12_377_ate_G1_precomp &prec_P,
+                                     const bls12_377_ate_G2_precomp_view &prec_Q)
+{
+    return bls12_377_ate_miller_loop_inner(prec_P, prec_Q.coeffs.data());
+}
+
+/* multiply f by the lines at position idx of all pairs, two lines at a time */
+static void bls12_377_ate_mul_by_lines(bls12_377_Fq12 &f,
+                                 const std::vector<const bls12_377_ate_G1_precomp*> &prec_P,
+                                 const std::vector<const bls12_377_ate_ell_coeffs*> &coeffs,
+                                 const size_t idx)
+{
+    size_t i = 0;
+    for (; i + 1 < prec_P.size(); i += 2)
+    {
+        const bls12_377_ate_ell_coeffs &c1 = coeffs[i][idx];
+        const bls12_377_ate_ell_coeffs &c2 = coeffs[i+1][idx];
+        f = f.mul_by_01234(bls12_377_Fq12::mul_024_by_024(c1.ell_0, prec_P[i]->PY * c1.ell_VW, prec_P[i]->PX * c1.ell_VV,
+                                                          c2.ell_0, prec_P[i+1]->PY * c2.ell_VW, prec_P[i+1]->PX * c2.ell_VV));
+    }
+    if (i < prec_P.size())
+    {
+        const bls12_377_ate_ell_coeffs &c1 = coeffs[i][idx];
+        f = f.mul_by_024(c1.ell_0, prec_P[i]->PY * c1.ell_VW, prec_P[i]->PX * c1.ell_VV);
+    }
+}
 
+static bls12_377_Fq12 bls12_377_ate_multi_miller_loop_inner(const std::vector<const bls12_377_ate_G1_precomp*> &prec_P,
+                                               const std::vector<const bls12_377_ate_ell_coeffs*> &coeffs)
+{
     bls12_377_Fq12 f = bls12_377_Fq12::one();
 
     bool found_one = false;
@@ -392,23 +426,12 @@ bls12_377_Fq12 bls12_377_ate_double_miller_loop(const bls12_377_ate_G1_precomp &
            bls12_377_param_p (skipping leading zeros) in MSB to LSB
            order */
 
-        bls12_377_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-        bls12_377_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-        ++idx;
-
         f = f.squared();
-
-        f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-        f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+        bls12_377_ate_mul_by_lines(f, prec_P, coeffs, idx++);
 
         if (bit)
         {
-            bls12_377_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-            bls12_377_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-            ++idx;
-
-            f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-            f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+            bls12_377_ate_mul_by_lines(f, prec_P, coeffs, idx++);
         }
     }
 
@@ -417,25 +440,67 @@ bls12_377_Fq12 bls12_377_ate_double_miller_loop(const bls12_377_ate_G1_precomp &
     	f = f.inverse();
     }
 
-    /*
-    bls12_377_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-    bls12_377_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-    ++idx;
-    f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-    f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
-
-    c1 = prec_Q1.coeffs[idx];
-    c2 = prec_Q2.coeffs[idx];
-    ++idx;
-    f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-    f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
-    */
+    return f;
+}
+
+bls12_377_Fq12 bls12_377_ate_double_miller_loop(const bls12_377_ate_G1_precomp &prec_P1,
+                                     const bls12_377_ate_G2_precomp &prec_Q1,
+                                     const bls12_377_ate_G1_precomp &prec_P2,
+                                     const bls12_377_ate_G2_precomp &prec_Q2)
+{
+    enter_block("Call to bls12_377_ate_double_miller_loop");
+    const bls12_377_Fq12 f = bls12_377_ate_multi_miller_loop_inner({ &prec_P1, &prec_P2 }, { prec_Q1.coeffs.data(), prec_Q2.coeffs.data() });
+    leave_block("Call to bls12_377_ate_double_miller_loop");
 
+    return f;
+}
+
+bls12_377_Fq12 bls12_377_ate_double_miller_loop(const bls12_377_ate_G1_precomp &prec_P1,
+                                     const bls12_377_ate_G2_precomp_view &prec_Q1,
+                                     const bls12_377_ate_G1_precomp &prec_P2,
+                                     const bls12_377_ate_G2_precomp_view &prec_Q2)
+{
+    enter_block("Call to bls12_377_ate_double_miller_loop");
+    const bls12_377_Fq12 f = bls12_377_ate_multi_miller_loop_inner({ &prec_P1, &prec_P2 }, { prec_Q1.coeffs.data(), prec_Q2.coeffs.data() });
     leave_block("Call to bls12_377_ate_double_miller_loop");
 
     return f;
 }
 
+template<typename G2_precomp_type>
+static bls12_377_Fq12 bls12_377_ate_multi_miller_loop_of(const std::vector<bls12_377_ate_G1_precomp> &prec_P,
+                                                         const std::vector<G2_precomp_type> &prec_Q)
+{
+    assert(prec_P.size() == prec_Q.size());
+    enter_block("Call to bls12_377_ate_multi_miller_loop");
+
+    std::vector<const bls12_377_ate_G1_precomp*> P_ptrs;
+    std::vector<const bls12_377_ate_ell_coeffs*> Q_ptrs;
+    P_ptrs.reserve(prec_P.size());
+    Q_ptrs.reserve(prec_Q.size());
+    for (size_t i = 0; i < prec_P.size(); ++i)
+    {
+        P_ptrs.emplace_back(&prec_P[i]);
+        Q_ptrs.emplace_back(prec_Q[i].coeffs.data());
+    }
+    const bls12_377_Fq12 f = bls12_377_ate_multi_miller_loop_inner(P_ptrs, Q_ptrs);
+
+    leave_block("Call to bls12_377_ate_multi_miller_loop");
+    return f;
+}
+
+bls12_377_Fq12 bls12_377_ate_multi_miller_loop(const std::vector<bls12_377_ate_G1_precomp> &prec_P,
+                                               const std::vector<bls12_377_ate_G2_precomp> &prec_Q)
+{
+    return bls12_377_ate_multi_miller_loop_of(prec_P, prec_Q);
+}
+
+bls12_377_Fq12 bls12_377_ate_multi_miller_loop(const std::vector<bls12_377_ate_G1_precomp> &prec_P,
+                                               const std::vector<bls12_377_ate_G2_precomp_view> &prec_Q)
+{
+    return bls12_377_ate_multi_miller_loop_of(prec_P, prec_Q);
+}
+
 bls12_377_Fq12 bls12_377_ate_pairing(const bls12_377_G1& P, const bls12_377_G2 &Q)
 {
     enter_block("Call to bls12_377_ate_pairing");
@@ -473,6 +538,12 @@ bls12_377_Fq12 bls12_377_miller_loop(const bls12_377_G1_precomp &prec_P,
     return bls12_377_ate_miller_loop(prec_P, prec_Q);
 }
 
+bls12_377_Fq12 bls12_377_miller_loop(const bls12_377_G1_precomp &prec_P,
+                          const bls12_377_G2_precomp_view &prec_Q)
+{
+    return bls12_377_ate_miller_loop(prec_P, prec_Q);
+}
+
 bls12_377_Fq12 bls12_377_double_miller_loop(const bls12_377_G1_precomp &prec_P1,
                                  const bls12_377_G2_precomp &prec_Q1,
                                  const bls12_377_G1_precomp &prec_P2,
@@ -481,6 +552,26 @@ bls12_377_Fq12 bls12_377_double_miller_loop(const bls12_377_G1_precomp &prec_P1,
     return bls12_377_ate_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
 }
 
+bls12_377_Fq12 bls12_377_double_miller_loop(const bls12_377_G1_precomp &prec_P1,
+                                 const bls12_377_G2_precomp_view &prec_Q1,
+                                 const bls12_377_G1_precomp &prec_P2,
+                                 const bls12_377_G2_precomp_view &prec_Q2)
+{
+    return bls12_377_ate_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
+}
+
+bls12_377_Fq12 bls12_377_multi_miller_loop(const std::vector<bls12_377_G1_precomp> &prec_P,
+                               const std::vector<bls12_377_G2_precomp> &prec_Q)
+{
+    return bls12_377_ate_multi_miller_loop(prec_P, prec_Q);
+}
+
+bls12_377_Fq12 bls12_377_multi_miller_loop(const std::vector<bls12_377_G1_precomp> &prec_P,
+                               const std::vector<bls12_377_G2_precomp_view> &prec_Q)
+{
+    return bls12_377_ate_multi_miller_loop(prec_P, prec_Q);
+}
+
 bls12_377_Fq12 bls12_377_pairing(const bls12_377_G1& P,
                       const bls12_377_G2 &Q)
 {
@@ -35,6 +35,12 @@ bls12_377_Fq12 bls12_377_pp::miller_loop(const bls12_377_G1_precomp &prec_P,
     return bls12_377_miller_loop(prec_P, prec_Q);
 }
 
+bls12_377_Fq12 bls12_377_pp::miller_loop(const bls12_377_G1_precomp &prec_P,
+                                         const bls12_377_G2_precomp_view &prec_Q)
+{
+    return bls12_377_miller_loop(prec_P, prec_Q);
+}
+
 bls12_377_Fq12 bls12_377_pp::double_miller_loop(const bls12_377_G1_precomp &prec_P1,
                                                 const bls12_377_G2_precomp &prec_Q1,
                                                 const bls12_377_G1_precomp &prec_P2,
@@ -43,6 +49,26 @@ bls12_377_Fq12 bls12_377_pp::double_miller_loop(const bls12_377_G1_precomp &prec
     return bls12_377_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
 }
 
+bls12_377_Fq12 bls12_377_pp::double_miller_loop(const bls12_377_G1_precomp &prec_P1,
+                                                const bls12_377_G2_precomp_view &prec_Q1,
+                                                const bls12_377_G1_precomp &prec_P2,
+                                                const bls12_377_G2_precomp_view &prec_Q2)
+{
+    return bls12_377_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
+}
+
+bls12_377_Fq12 bls12_377_pp::multi_miller_loop(const std::vector<bls12_377_G1_precomp> &prec_P,
+                                   const std::vector<bls12_377_G2_precomp> &prec_Q)
+{
+    return bls12_377_multi_miller_loop(prec_P, prec_Q);
+}
+
+bls12_377_Fq12 bls12_377_pp::multi_miller_loop(const std::vector<bls12_377_G1_precomp> &prec_P,
+                                   const std::vector<bls12_377_G2_precomp_view> &prec_Q)
+{
+    return bls12_377_multi_miller_loop(prec_P, prec_Q);
+}
+
 bls12_377_Fq12 bls12_377_pp::pairing(const bls12_377_G1 &P,
                                      const bls12_377_G2 &Q)
 {
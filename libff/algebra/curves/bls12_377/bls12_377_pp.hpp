@@ -22,6 +22,7 @@ public:
     typedef bls12_377_G2 G2_type;
     typedef bls12_377_G1_precomp G1_precomp_type;
     typedef bls12_377_G2_precomp G2_precomp_type;
+    typedef bls12_377_G2_precomp_view G2_precomp_view_type;
     typedef bls12_377_Fq Fq_type;
     typedef bls12_377_Fq2 Fqe_type;
     typedef bls12_377_Fq12 Fqk_type;
@@ -35,10 +36,20 @@ public:
     static bls12_377_G2_precomp precompute_G2(const bls12_377_G2 &Q);
     static bls12_377_Fq12 miller_loop(const bls12_377_G1_precomp &prec_P,
                                       const bls12_377_G2_precomp &prec_Q);
+    static bls12_377_Fq12 miller_loop(const bls12_377_G1_precomp &prec_P,
+                                      const bls12_377_G2_precomp_view &prec_Q);
     static bls12_377_Fq12 double_miller_loop(const bls12_377_G1_precomp &prec_P1,
                                              const bls12_377_G2_precomp &prec_Q1,
                                              const bls12_377_G1_precomp &prec_P2,
                                              const bls12_377_G2_precomp &prec_Q2);
+    static bls12_377_Fq12 double_miller_loop(const bls12_377_G1_precomp &prec_P1,
+                                             const bls12_377_G2_precomp_view &prec_Q1,
+                                             const bls12_377_G1_precomp &prec_P2,
+                                             const bls12_377_G2_precomp_view &prec_Q2);
+    static bls12_377_Fq12 multi_miller_loop(const std::vector<bls12_377_G1_precomp> &prec_P,
+                                      const std::vector<bls12_377_G2_precomp> &prec_Q);
+    static bls12_377_Fq12 multi_miller_loop(const std::vector<bls12_377_G1_precomp> &prec_P,
+                                      const std::vector<bls12_377_G2_precomp_view> &prec_Q);
     static bls12_377_Fq12 pairing(const bls12_377_G1 &P,
                                   const bls12_377_G2 &Q);
     static bls12_377_Fq12 reduced_pairing(const bls12_377_G1 &P,
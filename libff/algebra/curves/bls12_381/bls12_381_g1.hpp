@@ -14,8 +14,8 @@ std::istream& operator>>(std::istream &, bls12_381_G1&);
 class bls12_381_G1 {
 public:
 #ifdef PROFILE_OP_COUNTS
-    static long long add_cnt;
-    static long long dbl_cnt;
+    static op_counter add_cnt;
+    static op_counter dbl_cnt;
 #endif
     static std::vector<size_t> wnaf_window_table;
     static std::vector<size_t> fixed_base_exp_window_table;
@@ -52,6 +52,8 @@ public:
     bls12_381_G1 dbl() const;
 
     bool is_well_formed() const;
+    /* whether a point of the curve (see is_well_formed) is in the subgroup of order r */
+    bool is_in_correct_subgroup() const;
 
     static bls12_381_G1 zero();
     static bls12_381_G1 one();
@@ -65,6 +67,8 @@ public:
     friend std::istream& operator>>(std::istream &in, bls12_381_G1 &g);
 
     static void batch_to_special_all_non_zeros(std::vector<bls12_381_G1> &vec);
+    /* is_in_correct_subgroup for every element, spread over the executor */
+    static bool batch_is_in_correct_subgroup(const std::vector<bls12_381_G1> &vec);
 };
 
 template<mp_size_t m>
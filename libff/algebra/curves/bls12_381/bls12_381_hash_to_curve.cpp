@@ -0,0 +1,546 @@
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+#include <gmp.h>
+#include <openssl/sha.h>
+
+#include <libff/algebra/curves/bls12_381/bls12_381_hash_to_curve.hpp>
+#include <libff/algebra/fields/field_utils.hpp>
+#include <libff/common/execution.hpp>
+
+namespace libff {
+
+/* constants of the simplified SWU map to E': y^2 = x^3 + A x + B and of the isogeny from E' to the curve */
+template<typename FieldT>
+struct bls12_381_sswu_params {
+    FieldT A, B, Z;
+    /* the two values of x1: -B/A, and B/(Z A) when the denominator vanishes */
+    FieldT minus_B_over_A, B_over_ZA;
+    /* polynomials of the isogeny, least significant coefficient first */
+    std::vector<FieldT> x_num, x_den, y_num, y_den;
+};
+
+template<typename FieldT>
+static void bls12_381_set_sswu_derived_params(bls12_381_sswu_params<FieldT> &params)
+{
+    params.minus_B_over_A = -params.B * params.A.inverse();
+    params.B_over_ZA = params.B * (params.Z * params.A).inverse();
+}
+
+/* the 11-isogeny of RFC 9380, appendix E.2 */
+static bls12_381_sswu_params<bls12_381_Fq> bls12_381_compute_G1_sswu_params()
+{
+    const char *x_num[] = {
+        "2712959285290305970661081772124144179193819192423276218370281158706191519995889425075952244140278856085036081760695",
+        "3564859427549639835253027846704205725951033235539816243131874237388832081954622352624080767121604606753339903542203",
+        "2051387046688339481714726479723076305756384619135044672831882917686431912682625619320120082313093891743187631791280",
+        "3612713941521031012780325893181011392520079402153354595775735142359240110423346445050803899623018402874731133626465",
+        "2247053637822768981792833880270996398470828564809439728372634811976089874056583714987807553397615562273407692740057",
+        "3415427104483187489859740871640064348492611444552862448295571438270821994900526625562705192993481400731539293415811",
+        "2067521456483432583860405634125513059912765526223015704616050604591207046392807563217109432457129564962571408764292",
+        "3650721292069012982822225637849018828271936405382082649291891245623305084633066170122780668657208923883092359301262",
+        "1239271775787030039269460763652455868148971086016832054354147730155061349388626624328773377658494412538595239256855",
+        "3479374185711034293956731583912244564891370843071137483962415222733470401948838363051960066766720884717833231600798",
+        "2492756312273161536685660027440158956721981129429869601638362407515627529461742974364729223659746272460004902959995",
+        "1058488477413994682556770863004536636444795456512795473806825292198091015005841418695586811009326456605062948114985",
+    };
+    const char *x_den[] = {
+        "1353092447850172218905095041059784486169131709710991428415161466575141675351394082965234118340787683181925558786844",
+        "2822220997908397120956501031591772354860004534930174057793539372552395729721474912921980407622851861692773516917759",
+        "1717937747208385987946072944131378949849282930538642983149296304709633281382731764122371874602115081850953846504985",
+        "501624051089734157816582944025690868317536915684467868346388760435016044027032505306995281054569109955275640941784",
+        "3025903087998593826923738290305187197829899948335370692927241015584233559365859980023579293766193297662657497834014",
+        "2224140216975189437834161136818943039444741035168992629437640302964164227138031844090123490881551522278632040105125",
+        "1146414465848284837484508420047674663876992808692209238763293935905506532411661921697047880549716175045414621825594",
+        "3179090966864399634396993677377903383656908036827452986467581478509513058347781039562481806409014718357094150199902",
+        "1549317016540628014674302140786462938410429359529923207442151939696344988707002602944342203885692366490121021806145",
+        "1442797143427491432630626390066422021593505165588630398337491100088557278058060064930663878153124164818522816175370",
+        "1",
+    };
+    const char *y_num[] = {
+        "1393399195776646641963150658816615410692049723305861307490980409834842911816308830479576739332720113414154429643571",
+        "2968610969752762946134106091152102846225411740689724909058016729455736597929366401532929068084731548131227395540630",
+        "122933100683284845219599644396874530871261396084070222155796123161881094323788483360414289333111221370374027338230",
+        "303251954782077855462083823228569901064301365507057490567314302006681283228886645653148231378803311079384246777035",
+        "1353972356724735644398279028378555627591260676383150667237975415318226973994509601413730187583692624416197017403099",
+        "3443977503653895028417260979421240655844034880950251104724609885224259484262346958661845148165419691583810082940400",
+        "718493410301850496156792713845282235942975872282052335612908458061560958159410402177452633054233549648465863759602",
+        "1466864076415884313141727877156167508644960317046160398342634861648153052436926062434809922037623519108138661903145",
+        "1536886493137106337339531461344158973554574987550750910027365237255347020572858445054025958480906372033954157667719",
+        "2171468288973248519912068884667133903101171670397991979582205855298465414047741472281361964966463442016062407908400",
+        "3915937073730221072189646057898966011292434045388986394373682715266664498392389619761133407846638689998746172899634",
+        "3802409194827407598156407709510350851173404795262202653149767739163117554648574333789388883640862266596657730112910",
+        "1707589313757812493102695021134258021969283151093981498394095062397393499601961942449581422761005023512037430861560",
+        "349697005987545415860583335313370109325490073856352967581197273584891698473628451945217286148025358795756956811571",
+        "885704436476567581377743161796735879083481447641210566405057346859953524538988296201011389016649354976986251207243",
+        "3370924952219000111210625390420697640496067348723987858345031683392215988129398381698161406651860675722373763741188",
+    };
+    const char *y_den[] = {
+        "3396434800020507717552209507749485772788165484415495716688989613875369612529138640646200921379825018840894888371137",
+        "3907278185868397906991868466757978732688957419873771881240086730384895060595583602347317992689443299391009456758845",
+        "854914566454823955479427412036002165304466268547334760894270240966182605542146252771872707010378658178126128834546",
+        "3496628876382137961119423566187258795236027183112131017519536056628828830323846696121917502443333849318934945158166",
+        "1828256966233331991927609917644344011503610008134915752990581590799656305331275863706710232159635159092657073225757",
+        "1362317127649143894542621413133849052553333099883364300946623208643344298804722863920546222860227051989127113848748",
+        "3443845896188810583748698342858554856823966611538932245284665132724280883115455093457486044009395063504744802318172",
+        "3484671274283470572728732863557945897902920439975203610275006103818288159899345245633896492713412187296754791689945",
+        "3755735109429418587065437067067640634211015783636675372165599470771975919172394156249639331555277748466603540045130",
+        "3459661102222301807083870307127272890283709299202626530836335779816726101522661683404130556379097384249447658110805",
+        "742483168411032072323733249644347333168432665415341249073150659015707795549260947228694495111018381111866512337576",
+        "1662231279858095762833829698537304807741442669992646287950513237989158777254081548205552083108208170765474149568658",
+        "1668238650112823419388205992952852912407572045257706138925379268508860023191233729074751042562151098884528280913356",
+        "369162719928976119195087327055926326601627748362769544198813069133429557026740823593067700396825489145575282378487",
+        "2164195715141237148945939585099633032390257748382945597506236650132835917087090097395995817229686247227784224263055",
+        "1",
+    };
+    bls12_381_sswu_params<bls12_381_Fq> params;
+    params.A = bls12_381_Fq("12190336318893619529228877361869031420615612348429846051986726275283378313155663745811710833465465981901188123677");
+    params.B = bls12_381_Fq("2906670324641927570491258158026293881577086121416628140204402091718288198173574630967936031029026176254968826637280");
+    params.Z = bls12_381_Fq("11");
+    bls12_381_set_sswu_derived_params(params);
+    for (const char *c : x_num) params.x_num.emplace_back(bls12_381_Fq(c));
+    for (const char *c : x_den) params.x_den.emplace_back(bls12_381_Fq(c));
+    for (const char *c : y_num) params.y_num.emplace_back(bls12_381_Fq(c));
+    for (const char *c : y_den) params.y_den.emplace_back(bls12_381_Fq(c));
+    return params;
+}
+
+static bls12_381_Fq2 bls12_381_Fq2_from_strings(const char *const c[2])
+{
+    return bls12_381_Fq2(bls12_381_Fq(c[0]), bls12_381_Fq(c[1]));
+}
+
+/* the 3-isogeny of RFC 9380, appendix E.3 */
+static bls12_381_sswu_params<bls12_381_Fq2> bls12_381_compute_G2_sswu_params()
+{
+    const char *x_num[][2] = {
+        { "889424345604814976315064405719089812568196182208668418962679585805340366775741747653930584250892369786198727235542", "889424345604814976315064405719089812568196182208668418962679585805340366775741747653930584250892369786198727235542" },
+        { "0", "2668273036814444928945193217157269437704588546626005256888038757416021100327225242961791752752677109358596181706522" },
+        { "2668273036814444928945193217157269437704588546626005256888038757416021100327225242961791752752677109358596181706526", "1334136518407222464472596608578634718852294273313002628444019378708010550163612621480895876376338554679298090853261" },
+        { "3557697382419259905260257622876359250272784728834673675850718343221361467102966990615722337003569479144794908942033", "0" },
+    };
+    const char *x_den[][2] = {
+        { "0", "4002409555221667393417789825735904156556882819939007885332058136124031650490837864442687629129015664037894272559715" },
+        { "12", "4002409555221667393417789825735904156556882819939007885332058136124031650490837864442687629129015664037894272559775" },
+        { "1", "0" },
+    };
+    const char *y_num[][2] = {
+        { "3261222600550988246488569487636662646083386001431784202863158481286248011511053074731078808919938689216061999863558", "3261222600550988246488569487636662646083386001431784202863158481286248011511053074731078808919938689216061999863558" },
+        { "0", "889424345604814976315064405719089812568196182208668418962679585805340366775741747653930584250892369786198727235518" },
+        { "2668273036814444928945193217157269437704588546626005256888038757416021100327225242961791752752677109358596181706524", "1334136518407222464472596608578634718852294273313002628444019378708010550163612621480895876376338554679298090853263" },
+        { "2816510427748580758331037284777117739799287910327449993381818688383577828123182200904113516794492504322962636245776", "0" },
+    };
+    const char *y_den[][2] = {
+        { "4002409555221667393417789825735904156556882819939007885332058136124031650490837864442687629129015664037894272559355", "4002409555221667393417789825735904156556882819939007885332058136124031650490837864442687629129015664037894272559355" },
+        { "0", "4002409555221667393417789825735904156556882819939007885332058136124031650490837864442687629129015664037894272559571" },
+        { "18", "4002409555221667393417789825735904156556882819939007885332058136124031650490837864442687629129015664037894272559769" },
+        { "1", "0" },
+    };
+    bls12_381_sswu_params<bls12_381_Fq2> params;
+    params.A = bls12_381_Fq2(bls12_381_Fq::zero(), bls12_381_Fq("240"));
+    params.B = bls12_381_Fq2(bls12_381_Fq("1012"), bls12_381_Fq("1012"));
+    params.Z = -bls12_381_Fq2(bls12_381_Fq("2"), bls12_381_Fq::one());
+    bls12_381_set_sswu_derived_params(params);
+    for (const auto &c : x_num) params.x_num.emplace_back(bls12_381_Fq2_from_strings(c));
+    for (const auto &c : x_den) params.x_den.emplace_back(bls12_381_Fq2_from_strings(c));
+    for (const auto &c : y_num) params.y_num.emplace_back(bls12_381_Fq2_from_strings(c));
+    for (const auto &c : y_den) params.y_den.emplace_back(bls12_381_Fq2_from_strings(c));
+    return params;
+}
+
+/* computed on first use (after init_public_params) */
+static const bls12_381_sswu_params<bls12_381_Fq>& bls12_381_sswu_params_for(const bls12_381_Fq&)
+{
+    static const bls12_381_sswu_params<bls12_381_Fq> params = bls12_381_compute_G1_sswu_params();
+    return params;
+}
+
+static const bls12_381_sswu_params<bls12_381_Fq2>& bls12_381_sswu_params_for(const bls12_381_Fq2&)
+{
+    static const bls12_381_sswu_params<bls12_381_Fq2> params = bls12_381_compute_G2_sswu_params();
+    return params;
+}
+
+/* a if c is false and b otherwise, without branching on c */
+static bls12_381_Fq bls12_381_cmov(const bls12_381_Fq &a, const bls12_381_Fq &b, const bool c)
+{
+    const mp_limb_t mask = -static_cast<mp_limb_t>(c);
+    bls12_381_Fq result = a;
+    for (size_t i = 0; i < bls12_381_q_limbs; ++i)
+    {
+        result.mont_repr.data[i] ^= mask & (a.mont_repr.data[i] ^ b.mont_repr.data[i]);
+    }
+    return result;
+}
+
+static bls12_381_Fq2 bls12_381_cmov(const bls12_381_Fq2 &a, const bls12_381_Fq2 &b, const bool c)
+{
+    return bls12_381_Fq2(bls12_381_cmov(a.c0, b.c0, c), bls12_381_cmov(a.c1, b.c1, c));
+}
+
+/* the Montgomery representations are reduced, so this compares every limb instead of stopping at the first difference */
+static bool bls12_381_ct_eq(const bls12_381_Fq &a, const bls12_381_Fq &b)
+{
+    mp_limb_t diff = 0;
+    for (size_t i = 0; i < bls12_381_q_limbs; ++i)
+    {
+        diff |= a.mont_repr.data[i] ^ b.mont_repr.data[i];
+    }
+    return diff == 0;
+}
+
+static bool bls12_381_ct_eq(const bls12_381_Fq2 &a, const bls12_381_Fq2 &b)
+{
+    return bls12_381_ct_eq(a.c0, b.c0) & bls12_381_ct_eq(a.c1, b.c1);
+}
+
+static bool bls12_381_sgn0(const bls12_381_Fq &x)
+{
+    return x.as_bigint().test_bit(0);
+}
+
+static bool bls12_381_sgn0(const bls12_381_Fq2 &x)
+{
+    return bls12_381_sgn0(x.c0) | (bls12_381_ct_eq(x.c0, bls12_381_Fq::zero()) & bls12_381_sgn0(x.c1));
+}
+
+/*
+  sqrt_ratio of RFC 9380: sets y to a square root of u/v and returns true if
+  u/v is a square; otherwise sets y to a square root of Z u/v and returns
+  false. v must be nonzero. Both take a single exponentiation and select the
+  result without branching.
+*/
+static bool bls12_381_sqrt_ratio(const bls12_381_Fq &u, const bls12_381_Fq &v, bls12_381_Fq &y)
+{
+    /* q = 3 mod 4 (appendix F.2.1.2): y1 = u v (u v^3)^((q-3)/4) satisfies y1^2 v = +-u */
+    assert(bls12_381_Fq::s == 1);
+    static const bls12_381_Fq sqrt_minus_Z = (-bls12_381_sswu_params_for(bls12_381_Fq::zero()).Z).sqrt();
+
+    const bls12_381_Fq uv = u * v;
+    const bls12_381_Fq y1 = uv * ((uv * v.squared()) ^ bls12_381_Fq::t_minus_1_over_2);
+    const bool is_square = bls12_381_ct_eq(y1.squared() * v, u);
+    y = bls12_381_cmov(y1 * sqrt_minus_Z, y1, is_square);
+    return is_square;
+}
+
+/*
+  q^2 = 9 mod 16, so c = u v^7 (u v^15)^((q^2-9)/16) satisfies c^2 v = zeta u
+  for zeta = (u v^15)^((q^2-1)/8), an 8th root of unity. zeta is a 4th root of
+  unity exactly when u/v is a square, and then c/sqrt(zeta) is a square root of
+  u/v; otherwise zeta is a primitive 8th root of unity, a non-square like Z, and
+  c sqrt(Z/zeta) is a square root of Z u/v.
+*/
+struct bls12_381_sqrt_ratio_Fq2_consts {
+    /* 1/sqrt(zeta) for the 4th roots of unity zeta */
+    bls12_381_Fq2 roots[4];
+    /* sqrt(Z/zeta) for the primitive 8th roots of unity zeta */
+    bls12_381_Fq2 etas[4];
+};
+
+static bls12_381_sqrt_ratio_Fq2_consts bls12_381_compute_sqrt_ratio_Fq2_consts()
+{
+    const bls12_381_Fq2 Z = bls12_381_sswu_params_for(bls12_381_Fq2::zero()).Z;
+    /* the non-residue of Fq2 is -1 */
+    const bls12_381_Fq2 i = bls12_381_Fq2(bls12_381_Fq::zero(), bls12_381_Fq::one());
+    const bls12_381_Fq2 sqrt_i = i.sqrt();
+
+    const bls12_381_Fq2 fourth_roots[4] = { bls12_381_Fq2::one(), -bls12_381_Fq2::one(), i, -i };
+    const bls12_381_Fq2 eighth_roots[4] = { sqrt_i, -sqrt_i, sqrt_i * i, -(sqrt_i * i) };
+
+    bls12_381_sqrt_ratio_Fq2_consts consts;
+    for (size_t k = 0; k < 4; ++k)
+    {
+        consts.roots[k] = fourth_roots[k].inverse().sqrt();
+        consts.etas[k] = (Z * eighth_roots[k].inverse()).sqrt();
+    }
+    return consts;
+}
+
+static bool bls12_381_sqrt_ratio(const bls12_381_Fq2 &u, const bls12_381_Fq2 &v, bls12_381_Fq2 &y)
+{
+    assert(bls12_381_Fq2::s == 3);
+    static const bls12_381_sqrt_ratio_Fq2_consts consts = bls12_381_compute_sqrt_ratio_Fq2_consts();
+
+    const bls12_381_Fq2 v2 = v.squared();
+    const bls12_381_Fq2 v7 = v2.squared() * v2 * v;
+    const bls12_381_Fq2 uv7 = u * v7;
+    const bls12_381_Fq2 c = uv7 * ((uv7 * v7 * v) ^ bls12_381_Fq2::t_minus_1_over_2);
+
+    /* try every candidate, keeping the one that fits */
+    const bls12_381_Fq2 Zu = bls12_381_sswu_params_for(u).Z * u;
+    bool is_square = false;
+    bool is_Z_square = false;
+    y = c;
+    for (size_t k = 0; k < 4; ++k)
+    {
+        const bls12_381_Fq2 y1 = c * consts.roots[k];
+        const bool fits1 = bls12_381_ct_eq(y1.squared() * v, u);
+        y = bls12_381_cmov(y, y1, fits1 & !is_square);
+        is_square |= fits1;
+
+        const bls12_381_Fq2 y2 = c * consts.etas[k];
+        const bool fits2 = bls12_381_ct_eq(y2.squared() * v, Zu);
+        y = bls12_381_cmov(y, y2, fits2 & !is_square & !is_Z_square);
+        is_Z_square |= fits2;
+    }
+    assert(is_square || is_Z_square);
+    return is_square;
+}
+
+template<typename FieldT>
+static FieldT bls12_381_evaluate(const std::vector<FieldT> &poly, const FieldT &x)
+{
+    FieldT result = FieldT::zero();
+    for (auto it = poly.rbegin(); it != poly.rend(); ++it)
+    {
+        result = result * x + *it;
+    }
+    return result;
+}
+
+/*
+  The denominator of x1 in the simplified SWU map of u: A (-Z^2 u^4 - Z u^2), or
+  Z A when that vanishes. It is never zero.
+*/
+template<typename FieldT>
+static FieldT bls12_381_sswu_x1_den(const FieldT &u)
+{
+    const bls12_381_sswu_params<FieldT> &params = bls12_381_sswu_params_for(u);
+    const FieldT Zu2 = params.Z * u.squared();
+    const FieldT tv = Zu2.squared() + Zu2;
+    return params.A * bls12_381_cmov(-tv, params.Z, bls12_381_ct_eq(tv, FieldT::zero()));
+}
+
+/*
+  The simplified SWU map of u, following the straight-line description of RFC
+  9380 so that the square root and the choice between x1 and x2 need no
+  branch, followed by the isogeny. x1_den is bls12_381_sswu_x1_den(u) and
+  x1_den_inv its inverse, which only the isogeny needs. The point (x_num/x_den,
+  y y_num/y_den) is returned in Jacobian coordinates with Z = x_den y_den, so
+  that the isogeny needs no inversion.
+*/
+template<typename GroupT, typename FieldT>
+static GroupT bls12_381_sswu_and_isogeny(const FieldT &u, const FieldT &x1_den, const FieldT &x1_den_inv)
+{
+    const bls12_381_sswu_params<FieldT> &params = bls12_381_sswu_params_for(u);
+
+    const FieldT Zu2 = params.Z * u.squared();
+    const FieldT x1_num = params.B * (Zu2.squared() + Zu2 + FieldT::one());
+
+    /* g(x1) = gx1_num / x1_den^3 */
+    const FieldT x1_den2 = x1_den.squared();
+    const FieldT x1_den3 = x1_den2 * x1_den;
+    const FieldT gx1_num = (x1_num.squared() + params.A * x1_den2) * x1_num + params.B * x1_den3;
+
+    /* if g(x1) is not a square, x2 = Z u^2 x1 and g(x2) = Z^3 u^6 g(x1) is, with square root Z u^3 sqrt(Z g(x1)) */
+    FieldT y1;
+    const bool is_gx1_square = bls12_381_sqrt_ratio(gx1_num, x1_den3, y1);
+    const FieldT x = bls12_381_cmov(Zu2 * x1_num, x1_num, is_gx1_square) * x1_den_inv;
+    FieldT y = bls12_381_cmov(Zu2 * u * y1, y1, is_gx1_square);
+    y = bls12_381_cmov(y, -y, bls12_381_sgn0(u) != bls12_381_sgn0(y));
+
+    const FieldT x_num = bls12_381_evaluate(params.x_num, x);
+    const FieldT x_den = bls12_381_evaluate(params.x_den, x);
+    const FieldT y_num = bls12_381_evaluate(params.y_num, x);
+    const FieldT y_den = bls12_381_evaluate(params.y_den, x);
+
+    /* X = x_num x_den y_den^2 and Y = y y_num x_den^3 y_den^2; a zero denominator gives the point at infinity */
+    const FieldT x_den_y_den2 = x_den * y_den.squared();
+    return GroupT(x_num * x_den_y_den2,
+                  y * y_num * x_den.squared() * x_den_y_den2,
+                  x_den * y_den);
+}
+
+/* the map of every element of u, sharing the inversions */
+template<typename GroupT, typename FieldT>
+static std::vector<GroupT> bls12_381_batch_map_to_curve(const std::vector<FieldT> &u)
+{
+    std::vector<FieldT> x1_den(u.size());
+    for (size_t i = 0; i < u.size(); ++i)
+    {
+        x1_den[i] = bls12_381_sswu_x1_den(u[i]);
+    }
+    std::vector<FieldT> x1_den_inv(x1_den);
+    batch_invert(x1_den_inv);
+
+    std::vector<GroupT> result;
+    result.reserve(u.size());
+    for (size_t i = 0; i < u.size(); ++i)
+    {
+        result.emplace_back(bls12_381_sswu_and_isogeny<GroupT>(u[i], x1_den[i], x1_den_inv[i]));
+    }
+    return result;
+}
+
+std::vector<unsigned char> bls12_381_expand_message_xmd(const std::string &msg,
+                                                        const std::string &dst,
+                                                        const size_t len_in_bytes)
+{
+    const size_t ell = (len_in_bytes + SHA256_DIGEST_LENGTH - 1) / SHA256_DIGEST_LENGTH;
+    if (ell > 255 || len_in_bytes > 65535)
+    {
+        throw std::invalid_argument("bls12_381_expand_message_xmd: requested length is too large");
+    }
+
+    unsigned char digest[SHA256_DIGEST_LENGTH];
+    const auto sha256 = [&digest](const std::string &data) {
+        SHA256(reinterpret_cast<const unsigned char*>(data.data()), data.size(), digest);
+        return std::string(reinterpret_cast<const char*>(digest), SHA256_DIGEST_LENGTH);
+    };
+
+    std::string dst_prime = (dst.size() > 255 ? sha256("H2C-OVERSIZE-DST-" + dst) : dst);
+    dst_prime.push_back(static_cast<char>(dst_prime.size()));
+
+    /* Z_pad is one input block of SHA-256 */
+    std::string msg_prime(SHA256_CBLOCK, '\0');
+    msg_prime += msg;
+    msg_prime.push_back(static_cast<char>(len_in_bytes >> 8));
+    msg_prime.push_back(static_cast<char>(len_in_bytes & 0xff));
+    msg_prime.push_back('\0');
+    msg_prime += dst_prime;
+
+    const std::string b_0 = sha256(msg_prime);
+    std::string b_i = sha256(b_0 + '\x01' + dst_prime);
+
+    std::vector<unsigned char> result(b_i.begin(), b_i.end());
+    for (size_t i = 2; i <= ell; ++i)
+    {
+        std::string block(SHA256_DIGEST_LENGTH, '\0');
+        for (size_t k = 0; k < SHA256_DIGEST_LENGTH; ++k)
+        {
+            block[k] = b_0[k] ^ b_i[k];
+        }
+        b_i = sha256(block + static_cast<char>(i) + dst_prime);
+        result.insert(result.end(), b_i.begin(), b_i.end());
+    }
+    result.resize(len_in_bytes);
+    return result;
+}
+
+/* L = 64 bytes per element of Fq, for 128 bits of security */
+static const size_t bls12_381_hash_to_field_L = 64;
+
+static bls12_381_Fq bls12_381_Fq_from_bytes(const unsigned char *bytes)
+{
+    mpz_t value, modulus;
+    mpz_init(value);
+    mpz_init(modulus);
+    mpz_import(value, bls12_381_hash_to_field_L, 1, 1, 1, 0, bytes);
+    bls12_381_modulus_q.to_mpz(modulus);
+    mpz_mod(value, value, modulus);
+    const bls12_381_Fq result = bls12_381_Fq(bigint<bls12_381_q_limbs>(value));
+    mpz_clear(modulus);
+    mpz_clear(value);
+    return result;
+}
+
+/* hash_to_field with count = 2 */
+static void bls12_381_hash_to_field(const std::string &msg, const std::string &dst, bls12_381_Fq *u)
+{
+    const std::vector<unsigned char> bytes = bls12_381_expand_message_xmd(msg, dst, 2 * bls12_381_hash_to_field_L);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        u[i] = bls12_381_Fq_from_bytes(&bytes[i * bls12_381_hash_to_field_L]);
+    }
+}
+
+static void bls12_381_hash_to_field(const std::string &msg, const std::string &dst, bls12_381_Fq2 *u)
+{
+    const std::vector<unsigned char> bytes = bls12_381_expand_message_xmd(msg, dst, 4 * bls12_381_hash_to_field_L);
+    for (size_t i = 0; i < 2; ++i)
+    {
+        u[i] = bls12_381_Fq2(bls12_381_Fq_from_bytes(&bytes[2 * i * bls12_381_hash_to_field_L]),
+                             bls12_381_Fq_from_bytes(&bytes[(2 * i + 1) * bls12_381_hash_to_field_L]));
+    }
+}
+
+bls12_381_G1 bls12_381_map_to_curve_G1(const bls12_381_Fq &u)
+{
+    return bls12_381_batch_map_to_curve<bls12_381_G1>(std::vector<bls12_381_Fq>(1, u))[0];
+}
+
+bls12_381_G2 bls12_381_map_to_curve_G2(const bls12_381_Fq2 &u)
+{
+    return bls12_381_batch_map_to_curve<bls12_381_G2>(std::vector<bls12_381_Fq2>(1, u))[0];
+}
+
+/* [u]P for the curve parameter u */
+template<typename GroupT>
+static GroupT bls12_381_mul_by_u(const GroupT &P)
+{
+    const GroupT result = bls12_381_final_exponent_z * P;
+    return (bls12_381_final_exponent_is_z_neg ? -result : result);
+}
+
+bls12_381_G1 bls12_381_clear_cofactor_G1(const bls12_381_G1 &P)
+{
+    /* h_eff = 1 - u: a 64-bit scalar instead of the 126-bit cofactor */
+    return P - bls12_381_mul_by_u(P);
+}
+
+bls12_381_G2 bls12_381_clear_cofactor_G2(const bls12_381_G2 &P)
+{
+    /*
+      Budroni--Pintore: [h_eff]P = [u^2 - u - 1]P + [u - 1]psi(P) + psi^2(2P),
+      with two multiplications by u. psi is the untwist-Frobenius-twist
+      endomorphism, i.e. mul_by_q.
+    */
+    const bls12_381_G2 t1 = bls12_381_mul_by_u(P);
+    const bls12_381_G2 psi_P = P.mul_by_q();
+    const bls12_381_G2 t2 = bls12_381_mul_by_u(t1 + psi_P);
+    const bls12_381_G2 t3 = P.dbl().mul_by_q().mul_by_q() - psi_P;
+    return t3 + t2 - t1 - P;
+}
+
+template<typename GroupT, typename FieldT>
+static std::vector<GroupT> bls12_381_batch_hash(const std::vector<std::string> &msgs,
+                                                const std::string &dst,
+                                                GroupT (*clear_cofactor)(const GroupT&))
+{
+    std::vector<GroupT> result(msgs.size());
+    const size_t num_chunks = std::max<size_t>(1, std::min(get_executor()->concurrency(), msgs.size()));
+    parallel_for(0, num_chunks, [&](const size_t c) {
+        const size_t begin = msgs.size() * c / num_chunks;
+        const size_t end = msgs.size() * (c + 1) / num_chunks;
+
+        std::vector<FieldT> u(2 * (end - begin));
+        for (size_t i = begin; i < end; ++i)
+        {
+            bls12_381_hash_to_field(msgs[i], dst, &u[2 * (i - begin)]);
+        }
+
+        const std::vector<GroupT> Q = bls12_381_batch_map_to_curve<GroupT>(u);
+        for (size_t i = begin; i < end; ++i)
+        {
+            result[i] = clear_cofactor(Q[2 * (i - begin)] + Q[2 * (i - begin) + 1]);
+        }
+    });
+    return result;
+}
+
+bls12_381_G1 bls12_381_hash_to_G1(const std::string &msg, const std::string &dst)
+{
+    bls12_381_Fq u[2];
+    bls12_381_hash_to_field(msg, dst, u);
+    return bls12_381_clear_cofactor_G1(bls12_381_map_to_curve_G1(u[0]) + bls12_381_map_to_curve_G1(u[1]));
+}
+
+bls12_381_G2 bls12_381_hash_to_G2(const std::string &msg, const std::string &dst)
+{
+    bls12_381_Fq2 u[2];
+    bls12_381_hash_to_field(msg, dst, u);
+    return bls12_381_clear_cofactor_G2(bls12_381_map_to_curve_G2(u[0]) + bls12_381_map_to_curve_G2(u[1]));
+}
+
+std::vector<bls12_381_G1> bls12_381_batch_hash_to_G1(const std::vector<std::string> &msgs, const std::string &dst)
+{
+    return bls12_381_batch_hash<bls12_381_G1, bls12_381_Fq>(msgs, dst, bls12_381_clear_cofactor_G1);
+}
+
+std::vector<bls12_381_G2> bls12_381_batch_hash_to_G2(const std::vector<std::string> &msgs, const std::string &dst)
+{
+    return bls12_381_batch_hash<bls12_381_G2, bls12_381_Fq2>(msgs, dst, bls12_381_clear_cofactor_G2);
+}
+
+} // libff
@@ -0,0 +1,56 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of hashing to the groups G1 and G2 of BLS12-381, following RFC
+ 9380 with the suites BLS12381G1_XMD:SHA-256_SSWU_RO_ and
+ BLS12381G2_XMD:SHA-256_SSWU_RO_.
+
+ A message is expanded with expand_message_xmd into two field elements, each is
+ mapped to the curve with the simplified SWU map on an isogenous curve followed
+ by the isogeny (of degree 11 for G1 and 3 for G2), and the sum of the two
+ points is multiplied by the effective cofactor. The square roots of the map
+ use the sqrt_ratio of the RFC: a single exponentiation, with the result
+ selected without branching.
+
+ The batch functions hash many messages with the same dst. They share the
+ inversions that the isogenies need across a chunk of messages, return the
+ points of the isogeny in Jacobian coordinates without inverting, and spread
+ the chunks over the executor.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef BLS12_381_HASH_TO_CURVE_HPP_
+#define BLS12_381_HASH_TO_CURVE_HPP_
+#include <string>
+#include <vector>
+
+#include <libff/algebra/curves/bls12_381/bls12_381_g1.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_g2.hpp>
+
+namespace libff {
+
+/* len_in_bytes bytes of expand_message_xmd with SHA-256 */
+std::vector<unsigned char> bls12_381_expand_message_xmd(const std::string &msg,
+                                                        const std::string &dst,
+                                                        const size_t len_in_bytes);
+
+/* map_to_curve of the suites: a point of E (G1) or E' (G2), not yet in the subgroup */
+bls12_381_G1 bls12_381_map_to_curve_G1(const bls12_381_Fq &u);
+bls12_381_G2 bls12_381_map_to_curve_G2(const bls12_381_Fq2 &u);
+
+/* clear_cofactor of the suites: [1 - u]P on G1, and [h_eff]P with the psi endomorphism on G2 */
+bls12_381_G1 bls12_381_clear_cofactor_G1(const bls12_381_G1 &P);
+bls12_381_G2 bls12_381_clear_cofactor_G2(const bls12_381_G2 &P);
+
+bls12_381_G1 bls12_381_hash_to_G1(const std::string &msg, const std::string &dst);
+bls12_381_G2 bls12_381_hash_to_G2(const std::string &msg, const std::string &dst);
+
+std::vector<bls12_381_G1> bls12_381_batch_hash_to_G1(const std::vector<std::string> &msgs, const std::string &dst);
+std::vector<bls12_381_G2> bls12_381_batch_hash_to_G2(const std::vector<std::string> &msgs, const std::string &dst);
+
+} // libff
+#endif // BLS12_381_HASH_TO_CURVE_HPP_
@@ -15,6 +15,9 @@ bls12_381_Fq bls12_381_twist_mul_by_b_c1;
 bls12_381_Fq2 bls12_381_twist_mul_by_q_X;
 bls12_381_Fq2 bls12_381_twist_mul_by_q_Y;
 
+bls12_381_Fq bls12_381_g1_endomorphism_beta;
+bigint<bls12_381_r_limbs> bls12_381_g1_endomorphism_u_squared;
+
 bigint<bls12_381_q_limbs> bls12_381_ate_loop_count;
 bool bls12_381_ate_is_loop_count_neg;
 bigint<12*bls12_381_q_limbs> bls12_381_final_exponent;
@@ -26,6 +29,11 @@ void init_bls12_381_params()
     typedef bigint<bls12_381_r_limbs> bigint_r;
     typedef bigint<bls12_381_q_limbs> bigint_q;
 
+#ifdef PROFILE_OP_COUNTS
+    bls12_381_Fr::name_op_counters("bls12_381_Fr");
+    bls12_381_Fq::name_op_counters("bls12_381_Fq");
+#endif
+
     assert(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
 
     /* parameters for scalar field Fr */
@@ -143,6 +151,8 @@ void init_bls12_381_params()
     bls12_381_G1::G1_one = bls12_381_G1(bls12_381_Fq("3685416753713387016781088315183077757961620795782546409894578378688607592378376318836054947676345821548104185464507"),
                                     bls12_381_Fq("1339506544944476473020471379941921221584933875938349620426543736416511423956333506472724655353366534992391756441569"),
                                     bls12_381_Fq::one());
+    bls12_381_g1_endomorphism_beta = bls12_381_Fq("793479390729215512621379701633421447060886740281060493010456487427281649075476305620758731620350");
+    bls12_381_g1_endomorphism_u_squared = bigint_r("228988810152649578064853576960394133504");
 
 
     // TODO: wNAF window table
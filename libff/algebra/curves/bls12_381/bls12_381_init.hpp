@@ -34,6 +34,11 @@ extern bls12_381_Fq bls12_381_twist_mul_by_b_c1;
 extern bls12_381_Fq2 bls12_381_twist_mul_by_q_X;
 extern bls12_381_Fq2 bls12_381_twist_mul_by_q_Y;
 
+// parameters for the subgroup check of G1: the endomorphism phi(x, y) = (beta * x, y)
+// acts on G1 as multiplication by -u^2, and on no other point of E(Fq) (see is_in_correct_subgroup)
+extern bls12_381_Fq bls12_381_g1_endomorphism_beta;
+extern bigint<bls12_381_r_limbs> bls12_381_g1_endomorphism_u_squared;
+
 // parameters for pairing
 extern bigint<bls12_381_q_limbs> bls12_381_ate_loop_count;
 extern bool bls12_381_ate_is_loop_count_neg;
@@ -10,6 +10,8 @@
 #include <vector>
 
 #include <libff/algebra/curves/bls12_381/bls12_381_init.hpp>
+#include <libff/algebra/curves/precomp_coeffs.hpp>
+#include <libff/common/memory_accounting.hpp>
 
 namespace libff {
 
@@ -42,21 +44,41 @@ struct bls12_381_ate_G2_precomp {
     bls12_381_Fq2 QX;
     bls12_381_Fq2 QY;
     std::vector<bls12_381_ate_ell_coeffs> coeffs;
+    mem_charge<mem_tag_pairing_precomp> coeffs_mem;
 
     bool operator==(const bls12_381_ate_G2_precomp &other) const;
     friend std::ostream& operator<<(std::ostream &out, const bls12_381_ate_G2_precomp &prec_Q);
     friend std::istream& operator>>(std::istream &in, bls12_381_ate_G2_precomp &prec_Q);
 };
 
+/* a G2 precomputation whose coefficients are read in place, e.g. from a mapped file (see flat_precomp.hpp) */
+struct bls12_381_ate_G2_precomp_view {
+    bls12_381_Fq2 QX;
+    bls12_381_Fq2 QY;
+    precomp_coeffs_view<bls12_381_ate_ell_coeffs> coeffs;
+};
+
 bls12_381_ate_G1_precomp bls12_381_ate_precompute_G1(const bls12_381_G1& P);
 bls12_381_ate_G2_precomp bls12_381_ate_precompute_G2(const bls12_381_G2& Q);
 
 bls12_381_Fq12 bls12_381_ate_miller_loop(const bls12_381_ate_G1_precomp &prec_P,
                               const bls12_381_ate_G2_precomp &prec_Q);
+bls12_381_Fq12 bls12_381_ate_miller_loop(const bls12_381_ate_G1_precomp &prec_P,
+                              const bls12_381_ate_G2_precomp_view &prec_Q);
 bls12_381_Fq12 bls12_381_ate_double_miller_loop(const bls12_381_ate_G1_precomp &prec_P1,
                                      const bls12_381_ate_G2_precomp &prec_Q1,
                                      const bls12_381_ate_G1_precomp &prec_P2,
                                      const bls12_381_ate_G2_precomp &prec_Q2);
+bls12_381_Fq12 bls12_381_ate_double_miller_loop(const bls12_381_ate_G1_precomp &prec_P1,
+                                     const bls12_381_ate_G2_precomp_view &prec_Q1,
+                                     const bls12_381_ate_G1_precomp &prec_P2,
+                                     const bls12_381_ate_G2_precomp_view &prec_Q2);
+
+/* product of the Miller loops of all pairs (prec_P[i], prec_Q[i]) */
+bls12_381_Fq12 bls12_381_ate_multi_miller_loop(const std::vector<bls12_381_ate_G1_precomp> &prec_P,
+                                   const std::vector<bls12_381_ate_G2_precomp> &prec_Q);
+bls12_381_Fq12 bls12_381_ate_multi_miller_loop(const std::vector<bls12_381_ate_G1_precomp> &prec_P,
+                                   const std::vector<bls12_381_ate_G2_precomp_view> &prec_Q);
 
 bls12_381_Fq12 bls12_381_ate_pairing(const bls12_381_G1& P,
                           const bls12_381_G2 &Q);
@@ -67,6 +89,7 @@ bls12_381_GT bls12_381_ate_reduced_pairing(const bls12_381_G1 &P,
 
 typedef bls12_381_ate_G1_precomp bls12_381_G1_precomp;
 typedef bls12_381_ate_G2_precomp bls12_381_G2_precomp;
+typedef bls12_381_ate_G2_precomp_view bls12_381_G2_precomp_view;
 
 bls12_381_G1_precomp bls12_381_precompute_G1(const bls12_381_G1& P);
 
@@ -74,11 +97,21 @@ bls12_381_G2_precomp bls12_381_precompute_G2(const bls12_381_G2& Q);
 
 bls12_381_Fq12 bls12_381_miller_loop(const bls12_381_G1_precomp &prec_P,
                           const bls12_381_G2_precomp &prec_Q);
+bls12_381_Fq12 bls12_381_miller_loop(const bls12_381_G1_precomp &prec_P,
+                          const bls12_381_G2_precomp_view &prec_Q);
 
 bls12_381_Fq12 bls12_381_double_miller_loop(const bls12_381_G1_precomp &prec_P1,
                                  const bls12_381_G2_precomp &prec_Q1,
                                  const bls12_381_G1_precomp &prec_P2,
                                  const bls12_381_G2_precomp &prec_Q2);
+bls12_381_Fq12 bls12_381_double_miller_loop(const bls12_381_G1_precomp &prec_P1,
+                                 const bls12_381_G2_precomp_view &prec_Q1,
+                                 const bls12_381_G1_precomp &prec_P2,
+                                 const bls12_381_G2_precomp_view &prec_Q2);
+bls12_381_Fq12 bls12_381_multi_miller_loop(const std::vector<bls12_381_G1_precomp> &prec_P,
+                               const std::vector<bls12_381_G2_precomp> &prec_Q);
+bls12_381_Fq12 bls12_381_multi_miller_loop(const std::vector<bls12_381_G1_precomp> &prec_P,
+                               const std::vector<bls12_381_G2_precomp_view> &prec_Q);
 
 bls12_381_Fq12 bls12_381_pairing(const bls12_381_G1& P,
                       const bls12_381_G2 &Q);
@@ -11,8 +11,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long bn128_G1::add_cnt = 0;
-long long bn128_G1::dbl_cnt = 0;
+op_counter bn128_G1::add_cnt("bn128_G1::add");
+op_counter bn128_G1::dbl_cnt("bn128_G1::dbl");
 #endif
 
 std::vector<size_t> bn128_G1::wnaf_window_table;
@@ -341,11 +341,9 @@ bn128_G1 bn128_G1::random_element()
     return bn128_Fr::random_element().as_bigint() * G1_one;
 }
 
-std::ostream& operator<<(std::ostream &out, const bn128_G1 &g)
+/* writes a point already in affine coordinates (see to_affine_coordinates) */
+static void write_affine(std::ostream &out, const bn128_G1 &gcopy)
 {
-    bn128_G1 gcopy(g);
-    gcopy.to_affine_coordinates();
-
     out << (gcopy.is_zero() ? '1' : '0') << OUTPUT_SEPARATOR;
 
 #ifdef NO_PT_COMPRESSION
@@ -366,7 +364,13 @@ std::ostream& operator<<(std::ostream &out, const bn128_G1 &g)
 #endif
     out << OUTPUT_SEPARATOR << (((unsigned char*)&gcopy.coord[1])[0] & 1 ? '1' : '0');
 #endif
+}
 
+std::ostream& operator<<(std::ostream &out, const bn128_G1 &g)
+{
+    bn128_G1 gcopy(g);
+    gcopy.to_affine_coordinates();
+    write_affine(out, gcopy);
     return out;
 }
 
@@ -464,10 +468,15 @@ std::istream& operator>>(std::istream &in, bn128_G1 &g)
 
 std::ostream& operator<<(std::ostream& out, const std::vector<bn128_G1> &v)
 {
+    /* normalize all points with one inversion instead of one per point */
+    std::vector<bn128_G1> normalized(v);
+    bn128_G1::batch_to_affine_coordinates(normalized);
+
     out << v.size() << "\n";
-    for (const bn128_G1& t : v)
+    for (const bn128_G1& t : normalized)
     {
-        out << t << OUTPUT_NEWLINE;
+        write_affine(out, t);
+        out << OUTPUT_NEWLINE;
     }
     return out;
 }
@@ -491,6 +500,39 @@ std::istream& operator>>(std::istream& in, std::vector<bn128_G1> &v)
     return in;
 }
 
+void bn128_G1::batch_to_affine_coordinates(std::vector<bn128_G1> &vec)
+{
+    std::vector<bn::Fp> Z_vec;
+    Z_vec.reserve(vec.size());
+    for (const bn128_G1 &el : vec)
+    {
+        if (!el.is_zero())
+        {
+            Z_vec.emplace_back(el.coord[2]);
+        }
+    }
+    bn_batch_invert<bn::Fp>(Z_vec);
+
+    size_t j = 0;
+    for (bn128_G1 &el : vec)
+    {
+        if (el.is_zero())
+        {
+            el.to_affine_coordinates();
+            continue;
+        }
+
+        bn::Fp Z2, Z3;
+        bn::Fp::square(Z2, Z_vec[j]);
+        bn::Fp::mul(Z3, Z2, Z_vec[j]);
+        ++j;
+
+        bn::Fp::mul(el.coord[0], el.coord[0], Z2);
+        bn::Fp::mul(el.coord[1], el.coord[1], Z3);
+        el.coord[2] = 1;
+    }
+}
+
 void bn128_G1::batch_to_special_all_non_zeros(std::vector<bn128_G1> &vec)
 {
     std::vector<bn::Fp> Z_vec;
@@ -25,8 +25,8 @@ private:
     static bn::Fp sqrt(const bn::Fp &el);
 public:
 #ifdef PROFILE_OP_COUNTS
-    static long long add_cnt;
-    static long long dbl_cnt;
+    static op_counter add_cnt;
+    static op_counter dbl_cnt;
 #endif
     static std::vector<size_t> wnaf_window_table;
     static std::vector<size_t> fixed_base_exp_window_table;
@@ -71,6 +71,8 @@ public:
     friend std::ostream& operator<<(std::ostream &out, const bn128_G1 &g);
     friend std::istream& operator>>(std::istream &in, bn128_G1 &g);
 
+    /* to_affine_coordinates on every element, with a single inversion; zeros are allowed */
+    static void batch_to_affine_coordinates(std::vector<bn128_G1> &vec);
     static void batch_to_special_all_non_zeros(std::vector<bn128_G1> &vec);
 };
 
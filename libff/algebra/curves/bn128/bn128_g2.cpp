@@ -11,8 +11,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long bn128_G2::add_cnt = 0;
-long long bn128_G2::dbl_cnt = 0;
+op_counter bn128_G2::add_cnt("bn128_G2::add");
+op_counter bn128_G2::dbl_cnt("bn128_G2::dbl");
 #endif
 
 std::vector<size_t> bn128_G2::wnaf_window_table;
@@ -371,11 +371,9 @@ bn128_G2 bn128_G2::random_element()
     return bn128_Fr::random_element().as_bigint() * G2_one;
 }
 
-std::ostream& operator<<(std::ostream &out, const bn128_G2 &g)
+/* writes a point already in affine coordinates (see to_affine_coordinates) */
+static void write_affine(std::ostream &out, const bn128_G2 &gcopy)
 {
-    bn128_G2 gcopy(g);
-    gcopy.to_affine_coordinates();
-
     out << (gcopy.is_zero() ? '1' : '0') << OUTPUT_SEPARATOR;
 
 #ifdef NO_PT_COMPRESSION
@@ -400,7 +398,13 @@ std::ostream& operator<<(std::ostream &out, const bn128_G2 &g)
 #endif
     out << OUTPUT_SEPARATOR << (((unsigned char*)&gcopy.coord[1].a_)[0] & 1 ? '1' : '0');
 #endif
+}
 
+std::ostream& operator<<(std::ostream &out, const bn128_G2 &g)
+{
+    bn128_G2 gcopy(g);
+    gcopy.to_affine_coordinates();
+    write_affine(out, gcopy);
     return out;
 }
 
@@ -474,6 +478,75 @@ std::istream& operator>>(std::istream &in, bn128_G2 &g)
     return in;
 }
 
+std::ostream& operator<<(std::ostream& out, const std::vector<bn128_G2> &v)
+{
+    /* normalize all points with one inversion instead of one per point */
+    std::vector<bn128_G2> normalized(v);
+    bn128_G2::batch_to_affine_coordinates(normalized);
+
+    out << v.size() << "\n";
+    for (const bn128_G2& t : normalized)
+    {
+        write_affine(out, t);
+        out << OUTPUT_NEWLINE;
+    }
+    return out;
+}
+
+std::istream& operator>>(std::istream& in, std::vector<bn128_G2> &v)
+{
+    v.clear();
+
+    size_t s;
+    in >> s;
+    consume_newline(in);
+    v.reserve(s);
+
+    for (size_t i = 0; i < s; ++i)
+    {
+        bn128_G2 g;
+        in >> g;
+        consume_OUTPUT_NEWLINE(in);
+        v.emplace_back(g);
+    }
+    return in;
+}
+
+void bn128_G2::batch_to_affine_coordinates(std::vector<bn128_G2> &vec)
+{
+    std::vector<bn::Fp2> Z_vec;
+    Z_vec.reserve(vec.size());
+    for (const bn128_G2 &el : vec)
+    {
+        if (!el.is_zero())
+        {
+            Z_vec.emplace_back(el.coord[2]);
+        }
+    }
+    bn_batch_invert<bn::Fp2>(Z_vec);
+
+    const bn::Fp2 one = 1;
+
+    size_t j = 0;
+    for (bn128_G2 &el : vec)
+    {
+        if (el.is_zero())
+        {
+            el.to_affine_coordinates();
+            continue;
+        }
+
+        bn::Fp2 Z2, Z3;
+        bn::Fp2::square(Z2, Z_vec[j]);
+        bn::Fp2::mul(Z3, Z2, Z_vec[j]);
+        ++j;
+
+        bn::Fp2::mul(el.coord[0], el.coord[0], Z2);
+        bn::Fp2::mul(el.coord[1], el.coord[1], Z3);
+        el.coord[2] = one;
+    }
+}
+
 void bn128_G2::batch_to_special_all_non_zeros(std::vector<bn128_G2> &vec)
 {
     std::vector<bn::Fp2> Z_vec;
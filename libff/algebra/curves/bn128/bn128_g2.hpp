@@ -26,8 +26,8 @@ private:
     static bn::Fp2 sqrt(const bn::Fp2 &el);
 public:
 #ifdef PROFILE_OP_COUNTS
-    static long long add_cnt;
-    static long long dbl_cnt;
+    static op_counter add_cnt;
+    static op_counter dbl_cnt;
 #endif
     static std::vector<size_t> wnaf_window_table;
     static std::vector<size_t> fixed_base_exp_window_table;
@@ -72,6 +72,8 @@ public:
     friend std::ostream& operator<<(std::ostream &out, const bn128_G2 &g);
     friend std::istream& operator>>(std::istream &in, bn128_G2 &g);
 
+    /* to_affine_coordinates on every element, with a single inversion; zeros are allowed */
+    static void batch_to_affine_coordinates(std::vector<bn128_G2> &vec);
     static void batch_to_special_all_non_zeros(std::vector<bn128_G2> &vec);
 };
 
@@ -87,5 +89,8 @@ bn128_G2 operator*(const Fp_model<m, modulus_p> &lhs, const bn128_G2 &rhs)
     return scalar_mul<bn128_G2, m>(rhs, lhs.as_bigint());
 }
 
+std::ostream& operator<<(std::ostream& out, const std::vector<bn128_G2> &v);
+std::istream& operator>>(std::istream& in, std::vector<bn128_G2> &v);
+
 } // libff
 #endif // BN128_G2_HPP_
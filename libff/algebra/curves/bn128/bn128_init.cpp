@@ -6,6 +6,8 @@
 * @copyright  MIT license (see LICENSE file)
 *****************************************************************************/
 
+#include <mutex>
+
 #include <libff/algebra/curves/bn128/bn128_g1.hpp>
 #include <libff/algebra/curves/bn128/bn128_g2.hpp>
 #include <libff/algebra/curves/bn128/bn128_gt.hpp>
@@ -26,13 +28,18 @@ size_t bn128_Fq2_s;
 bn::Fp2 bn128_Fq2_nqr_to_t;
 mie::Vuint bn128_Fq2_t_minus_1_over_2;
 
-void init_bn128_params()
+static void init_bn128_params_once()
 {
   bn::Param::init(); // init ate-pairing library
 
   typedef bigint<bn128_r_limbs> bigint_r;
   typedef bigint<bn128_q_limbs> bigint_q;
 
+#ifdef PROFILE_OP_COUNTS
+  bn128_Fr::name_op_counters("bn128_Fr");
+  bn128_Fq::name_op_counters("bn128_Fq");
+#endif
+
   assert(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
 
   /* parameters for scalar field Fr */
@@ -226,4 +233,12 @@ void init_bn128_params()
 
   bn128_GT::GT_one.elem = bn::Fp12(1);
 }
+
+void init_bn128_params()
+{
+  /* ate-pairing keeps its parameters in globals that every operation reads,
+     so they are set once and never rewritten under concurrent computations */
+  static std::once_flag initialized;
+  std::call_once(initialized, init_bn128_params_once);
+}
 } // libff
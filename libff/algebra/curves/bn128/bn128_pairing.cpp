@@ -9,12 +9,14 @@
  *******************************************************************************/
 
 #include <sstream>
+#include <stdexcept>
 
 #include <libff/algebra/curves/bn128/bn128_g1.hpp>
 #include <libff/algebra/curves/bn128/bn128_g2.hpp>
 #include <libff/algebra/curves/bn128/bn128_gt.hpp>
 #include <libff/algebra/curves/bn128/bn128_init.hpp>
 #include <libff/algebra/curves/bn128/bn128_pairing.hpp>
+#include <libff/common/memory_accounting.hpp>
 #include <libff/common/profiling.hpp>
 
 namespace libff {
@@ -158,6 +160,8 @@ std::istream& operator>>(std::istream &in, bn128_ate_G2_precomp &prec_Q)
         in.read((char*) &prec_Q.coeffs[i].c_.b_, sizeof(prec_Q.coeffs[i].c_.b_));
 #endif
     }
+    prec_Q.coeffs_mem.set(prec_Q.coeffs.capacity() * sizeof(bn128_ate_ell_coeffs));
+
     return in;
 }
 
@@ -179,10 +183,47 @@ bn128_ate_G2_precomp bn128_ate_precompute_G2(const bn128_G2& Q)
     bn128_ate_G2_precomp result;
     bn::components::precomputeG2(result.coeffs, result.Q, Q.coord);
 
+    result.coeffs_mem.set(result.coeffs.capacity() * sizeof(bn128_ate_ell_coeffs));
+
     leave_block("Call to bn128_ate_precompute_G2");
     return result;
 }
 
+std::vector<bn128_ate_G1_precomp> bn128_ate_batch_precompute_G1(const std::vector<bn128_G1> &P)
+{
+    enter_block("Call to bn128_ate_batch_precompute_G1");
+
+    std::vector<bn128_G1> normalized(P);
+    bn128_G1::batch_to_affine_coordinates(normalized);
+
+    std::vector<bn128_ate_G1_precomp> result(P.size());
+    for (size_t i = 0; i < P.size(); ++i)
+    {
+        result[i].P[0] = normalized[i].coord[0];
+        result[i].P[1] = normalized[i].coord[1];
+        result[i].P[2] = normalized[i].coord[2];
+    }
+
+    leave_block("Call to bn128_ate_batch_precompute_G1");
+    return result;
+}
+
+std::vector<bn128_ate_G2_precomp> bn128_ate_batch_precompute_G2(const std::vector<bn128_G2> &Q)
+{
+    enter_block("Call to bn128_ate_batch_precompute_G2");
+
+    /* ate-pairing does not document its routines as thread-safe, so the points are precomputed one at a time */
+    std::vector<bn128_ate_G2_precomp> result(Q.size());
+    for (size_t i = 0; i < Q.size(); ++i)
+    {
+        bn::components::precomputeG2(result[i].coeffs, result[i].Q, Q[i].coord);
+        result[i].coeffs_mem.set(result[i].coeffs.capacity() * sizeof(bn128_ate_ell_coeffs));
+    }
+
+    leave_block("Call to bn128_ate_batch_precompute_G2");
+    return result;
+}
+
 bn128_Fq12 bn128_ate_miller_loop(const bn128_ate_G1_precomp &prec_P,
                                  const bn128_ate_G2_precomp &prec_Q)
 {
@@ -201,6 +242,37 @@ bn128_Fq12 bn128_double_ate_miller_loop(const bn128_ate_G1_precomp &prec_P1,
     return f;
 }
 
+bn128_Fq12 bn128_ate_multi_miller_loop(const std::vector<bn128_ate_G1_precomp> &prec_P,
+                                       const std::vector<bn128_ate_G2_precomp> &prec_Q)
+{
+    if (prec_P.size() != prec_Q.size())
+    {
+        throw std::invalid_argument("bn128_ate_multi_miller_loop: different numbers of G1 and G2 precomputations");
+    }
+
+    /*
+      ate-pairing loops over at most two pairs at a time, so the pairs are
+      taken two by two. Its routines are not documented as thread-safe, so
+      unlike the other curves the loops run one after the other.
+    */
+    bn128_Fq12 result;
+    result.elem = bn::Fp12(1);
+    bn::Fp12 f;
+    for (size_t i = 0; i < prec_P.size(); i += 2)
+    {
+        if (i + 1 < prec_P.size())
+        {
+            bn::components::millerLoop2(f, prec_Q[i].coeffs, prec_P[i].P, prec_Q[i+1].coeffs, prec_P[i+1].P);
+        }
+        else
+        {
+            bn::components::millerLoop(f, prec_Q[i].coeffs, prec_P[i].P);
+        }
+        bn::Fp12::mul(result.elem, result.elem, f);
+    }
+    return result;
+}
+
 bn128_GT bn128_final_exponentiation(const bn128_Fq12 &elt)
 {
     enter_block("Call to bn128_final_exponentiation");
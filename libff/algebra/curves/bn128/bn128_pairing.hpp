@@ -15,6 +15,8 @@
 #include <libff/algebra/curves/bn128/bn128_g1.hpp>
 #include <libff/algebra/curves/bn128/bn128_g2.hpp>
 #include <libff/algebra/curves/bn128/bn128_gt.hpp>
+#include <libff/algebra/curves/flat_precomp.hpp>
+#include <libff/common/memory_accounting.hpp>
 
 namespace libff {
 
@@ -30,16 +32,47 @@ typedef bn::Fp6 bn128_ate_ell_coeffs;
 
 struct bn128_ate_G2_precomp {
     bn::Fp2 Q[3];
+    /* the ate-pairing library fills and reads a std::vector */
     std::vector<bn128_ate_ell_coeffs> coeffs;
+    mem_charge<mem_tag_pairing_precomp> coeffs_mem;
 
     bool operator==(const bn128_ate_G2_precomp &other) const;
     friend std::ostream& operator<<(std::ostream &out, const bn128_ate_G2_precomp &prec_Q);
     friend std::istream& operator>>(std::istream &in, bn128_ate_G2_precomp &prec_Q);
 };
 
+/* the point is stored as the normalized Jacobian coordinates Q[3] */
+template<>
+struct flat_G2_precomp_traits<bn128_ate_G2_precomp, bn128_G2> {
+    typedef bn128_ate_ell_coeffs coeff_type;
+
+    static const size_t head_size = 3 * sizeof(bn::Fp2);
+
+    static void write_head(const bn128_ate_G2_precomp &prec, unsigned char *out)
+    {
+        std::memcpy(out, prec.Q, head_size);
+    }
+
+    static void read_head(bn128_ate_G2_precomp &prec, const unsigned char *in)
+    {
+        std::memcpy(prec.Q, in, head_size);
+    }
+
+    static void point_head(const bn128_G2 &Q, unsigned char *out)
+    {
+        bn::Fp2 normalized[3];
+        bn::ecop::NormalizeJac(normalized, Q.coord);
+        std::memcpy(out, normalized, head_size);
+    }
+};
+
 bn128_ate_G1_precomp bn128_ate_precompute_G1(const bn128_G1& P);
 bn128_ate_G2_precomp bn128_ate_precompute_G2(const bn128_G2& Q);
 
+/* precomputations of all points, normalizing the G1 points with a single inversion */
+std::vector<bn128_ate_G1_precomp> bn128_ate_batch_precompute_G1(const std::vector<bn128_G1> &P);
+std::vector<bn128_ate_G2_precomp> bn128_ate_batch_precompute_G2(const std::vector<bn128_G2> &Q);
+
 bn128_Fq12 bn128_double_ate_miller_loop(const bn128_ate_G1_precomp &prec_P1,
                                         const bn128_ate_G2_precomp &prec_Q1,
                                         const bn128_ate_G1_precomp &prec_P2,
@@ -47,6 +80,10 @@ bn128_Fq12 bn128_double_ate_miller_loop(const bn128_ate_G1_precomp &prec_P1,
 bn128_Fq12 bn128_ate_miller_loop(const bn128_ate_G1_precomp &prec_P,
                                  const bn128_ate_G2_precomp &prec_Q);
 
+/* product of the Miller loops of all pairs (prec_P[i], prec_Q[i]) */
+bn128_Fq12 bn128_ate_multi_miller_loop(const std::vector<bn128_ate_G1_precomp> &prec_P,
+                                       const std::vector<bn128_ate_G2_precomp> &prec_Q);
+
 bn128_GT bn128_final_exponentiation(const bn128_Fq12 &elt);
 
 } // libff
@@ -50,6 +50,15 @@ bn128_Fq12 bn128_pp::double_miller_loop(const bn128_ate_G1_precomp &prec_P1,
     return result;
 }
 
+bn128_Fq12 bn128_pp::multi_miller_loop(const std::vector<bn128_ate_G1_precomp> &prec_P,
+                                       const std::vector<bn128_ate_G2_precomp> &prec_Q)
+{
+    enter_block("Call to multi_miller_loop<bn128_pp>");
+    bn128_Fq12 result = bn128_ate_multi_miller_loop(prec_P, prec_Q);
+    leave_block("Call to multi_miller_loop<bn128_pp>");
+    return result;
+}
+
 bn128_Fq12 bn128_pp::pairing(const bn128_G1 &P,
                              const bn128_G2 &Q)
 {
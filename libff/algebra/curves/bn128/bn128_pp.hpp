@@ -23,6 +23,8 @@ public:
     typedef bn128_G2 G2_type;
     typedef bn128_ate_G1_precomp G1_precomp_type;
     typedef bn128_ate_G2_precomp G2_precomp_type;
+    /* the ate-pairing library reads a std::vector, so views are precomputations */
+    typedef bn128_ate_G2_precomp G2_precomp_view_type;
     typedef bn128_Fq Fq_type;
     typedef bn128_Fq12 Fqk_type;
     typedef bn128_GT GT_type;
@@ -39,6 +41,8 @@ public:
                                          const bn128_ate_G2_precomp &prec_Q1,
                                          const bn128_ate_G1_precomp &prec_P2,
                                          const bn128_ate_G2_precomp &prec_Q2);
+    static bn128_Fq12 multi_miller_loop(const std::vector<bn128_ate_G1_precomp> &prec_P,
+                                        const std::vector<bn128_ate_G2_precomp> &prec_Q);
 
     /* the following are used in test files */
     static bn128_GT pairing(const bn128_G1 &P,
@@ -3,8 +3,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long bw12_446_G1::add_cnt = 0;
-long long bw12_446_G1::dbl_cnt = 0;
+op_counter bw12_446_G1::add_cnt("bw12_446_G1::add");
+op_counter bw12_446_G1::dbl_cnt("bw12_446_G1::dbl");
 #endif
 
 std::vector<size_t> bw12_446_G1::wnaf_window_table;
@@ -172,6 +172,10 @@ bw12_446_G1 bw12_446_G1::operator+(const bw12_446_G1 &other) const
         return this->dbl();
     }
 
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
+
     // rest of add case
     bw12_446_Fq H = U2 - U1;                            // H = U2-U1
     bw12_446_Fq S2_minus_S1 = S2-S1;
@@ -26,6 +26,11 @@ void init_bw12_446_params()
     typedef bigint<bw12_446_r_limbs> bigint_r;
     typedef bigint<bw12_446_q_limbs> bigint_q;
 
+#ifdef PROFILE_OP_COUNTS
+    bw12_446_Fr::name_op_counters("bw12_446_Fr");
+    bw12_446_Fq::name_op_counters("bw12_446_Fq");
+#endif
+
     assert(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
 
     /* bw12_446 Fr parameters */
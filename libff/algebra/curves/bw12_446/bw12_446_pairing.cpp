@@ -4,6 +4,7 @@
 #include <libff/algebra/curves/bw12_446/bw12_446_g2.hpp>
 #include <libff/algebra/curves/bw12_446/bw12_446_init.hpp>
 #include <libff/algebra/curves/bw12_446/bw12_446_pairing.hpp>
+#include <libff/common/memory_accounting.hpp>
 #include <libff/common/profiling.hpp>
 
 namespace libff {
@@ -95,6 +96,8 @@ namespace libff {
       prec_Q.coeffs.emplace_back(c);
     }
 
+    prec_Q.coeffs_mem.set(prec_Q.coeffs.capacity() * sizeof(bw12_446_ate_ell_coeffs));
+
     return in;
   }
 
@@ -411,12 +414,14 @@ bw12_446_ate_G2_precomp bw12_446_ate_precompute_G2(const bw12_446_G2& Q)
     mixed_addition_step_for_flipped_miller_loop(Q2, R, c);
     result.coeffs.push_back(c);
 
+    result.coeffs_mem.set(result.coeffs.capacity() * sizeof(bw12_446_ate_ell_coeffs));
+
     leave_block("Call to bw12_446_ate_precompute_G2");
     return result;
 }
 
-bw12_446_Fq12 bw12_446_ate_miller_loop(const bw12_446_ate_G1_precomp &prec_P,
-                                     const bw12_446_ate_G2_precomp &prec_Q)
+static bw12_446_Fq12 bw12_446_ate_miller_loop_inner(const bw12_446_ate_G1_precomp &prec_P,
+                                                    const bw12_446_ate_ell_coeffs *coeffs)
 {
     enter_block("Call to bw12_446_ate_miller_loop");
 
@@ -442,13 +447,13 @@ bw12_446_Fq12 bw12_446_ate_miller_loop(const bw12_446_ate_G1_precomp &prec_P,
            bw12_446_param_p (skipping leading zeros) in MSB to LSB
            order */
 
-        c = prec_Q.coeffs[idx++];
+        c = coeffs[idx++];
         f = f.squared();
         f = f.mul_by_024(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
 
         if (bit)
         {
-            c = prec_Q.coeffs[idx++];
+            c = coeffs[idx++];
             f = f.mul_by_024(c.ell_0, prec_P.PY * c.ell_VW, prec_P.PX * c.ell_VV);
         }
 
@@ -459,23 +464,52 @@ bw12_446_Fq12 bw12_446_ate_miller_loop(const bw12_446_ate_G1_precomp &prec_P,
     	f = f.inverse();
     }
 
-    c = prec_Q.coeffs[idx++];
+    c = coeffs[idx++];
     f = f.mul_by_024(c.ell_0,prec_P.PY * c.ell_VW,prec_P.PX * c.ell_VV);
 
-    c = prec_Q.coeffs[idx++];
+    c = coeffs[idx++];
     f = f.mul_by_024(c.ell_0,prec_P.PY * c.ell_VW,prec_P.PX * c.ell_VV);
 
     leave_block("Call to bw12_446_ate_miller_loop");
     return f;
 }
 
-bw12_446_Fq12 bw12_446_ate_double_miller_loop(const bw12_446_ate_G1_precomp &prec_P1,
-                                     const bw12_446_ate_G2_precomp &prec_Q1,
-                                     const bw12_446_ate_G1_precomp &prec_P2,
-                                     const bw12_446_ate_G2_precomp &prec_Q2)
+bw12_446_Fq12 bw12_446_ate_miller_loop(const bw12_446_ate_G1_precomp &prec_P,
+                                     const bw12_446_ate_G2_precomp &prec_Q)
 {
-    enter_block("Call to bw12_446_ate_double_miller_loop");
+    return bw12_446_ate_miller_loop_inner(prec_P, prec_Q.coeffs.data());
+}
 
+bw12_446_Fq12 bw12_446_ate_miller_loop(const bw12_446_ate_G1_precomp &prec_P,
+                                     const bw12_446_ate_G2_precomp_view &prec_Q)
+{
+    return bw12_446_ate_miller_loop_inner(prec_P, prec_Q.coeffs.data());
+}
+
+/* multiply f by the lines at position idx of all pairs, two lines at a time */
+static void bw12_446_ate_mul_by_lines(bw12_446_Fq12 &f,
+                                 const std::vector<const bw12_446_ate_G1_precomp*> &prec_P,
+                                 const std::vector<const bw12_446_ate_ell_coeffs*> &coeffs,
+                                 const size_t idx)
+{
+    size_t i = 0;
+    for (; i + 1 < prec_P.size(); i += 2)
+    {
+        const bw12_446_ate_ell_coeffs &c1 = coeffs[i][idx];
+        const bw12_446_ate_ell_coeffs &c2 = coeffs[i+1][idx];
+        f = f.mul_by_01234(bw12_446_Fq12::mul_024_by_024(c1.ell_0, prec_P[i]->PY * c1.ell_VW, prec_P[i]->PX * c1.ell_VV,
+                                                         c2.ell_0, prec_P[i+1]->PY * c2.ell_VW, prec_P[i+1]->PX * c2.ell_VV));
+    }
+    if (i < prec_P.size())
+    {
+        const bw12_446_ate_ell_coeffs &c1 = coeffs[i][idx];
+        f = f.mul_by_024(c1.ell_0, prec_P[i]->PY * c1.ell_VW, prec_P[i]->PX * c1.ell_VV);
+    }
+}
+
+static bw12_446_Fq12 bw12_446_ate_multi_miller_loop_inner(const std::vector<const bw12_446_ate_G1_precomp*> &prec_P,
+                                               const std::vector<const bw12_446_ate_ell_coeffs*> &coeffs)
+{
     bw12_446_Fq12 f = bw12_446_Fq12::one();
 
     bool found_one = false;
@@ -496,23 +530,12 @@ bw12_446_Fq12 bw12_446_ate_double_miller_loop(const bw12_446_ate_G1_precomp &pre
            bw12_446_param_p (skipping leading zeros) in MSB to LSB
            order */
 
-        bw12_446_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-        bw12_446_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-        ++idx;
-
         f = f.squared();
-
-        f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-        f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+        bw12_446_ate_mul_by_lines(f, prec_P, coeffs, idx++);
 
         if (bit)
         {
-            bw12_446_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-            bw12_446_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-            ++idx;
-
-            f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-            f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+            bw12_446_ate_mul_by_lines(f, prec_P, coeffs, idx++);
         }
     }
 
@@ -521,23 +544,70 @@ bw12_446_Fq12 bw12_446_ate_double_miller_loop(const bw12_446_ate_G1_precomp &pre
     	f = f.inverse();
     }
 
-    bw12_446_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-    bw12_446_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-    ++idx;
-    f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-    f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+    bw12_446_ate_mul_by_lines(f, prec_P, coeffs, idx++);
+    bw12_446_ate_mul_by_lines(f, prec_P, coeffs, idx++);
+
+    return f;
+}
+
+bw12_446_Fq12 bw12_446_ate_double_miller_loop(const bw12_446_ate_G1_precomp &prec_P1,
+                                     const bw12_446_ate_G2_precomp &prec_Q1,
+                                     const bw12_446_ate_G1_precomp &prec_P2,
+                                     const bw12_446_ate_G2_precomp &prec_Q2)
+{
+    enter_block("Call to bw12_446_ate_double_miller_loop");
+    const bw12_446_Fq12 f = bw12_446_ate_multi_miller_loop_inner({ &prec_P1, &prec_P2 }, { prec_Q1.coeffs.data(), prec_Q2.coeffs.data() });
+    leave_block("Call to bw12_446_ate_double_miller_loop");
 
-    c1 = prec_Q1.coeffs[idx];
-    c2 = prec_Q2.coeffs[idx];
-    ++idx;
-    f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-    f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+    return f;
+}
 
+bw12_446_Fq12 bw12_446_ate_double_miller_loop(const bw12_446_ate_G1_precomp &prec_P1,
+                                     const bw12_446_ate_G2_precomp_view &prec_Q1,
+                                     const bw12_446_ate_G1_precomp &prec_P2,
+                                     const bw12_446_ate_G2_precomp_view &prec_Q2)
+{
+    enter_block("Call to bw12_446_ate_double_miller_loop");
+    const bw12_446_Fq12 f = bw12_446_ate_multi_miller_loop_inner({ &prec_P1, &prec_P2 }, { prec_Q1.coeffs.data(), prec_Q2.coeffs.data() });
     leave_block("Call to bw12_446_ate_double_miller_loop");
 
     return f;
 }
 
+template<typename G2_precomp_type>
+static bw12_446_Fq12 bw12_446_ate_multi_miller_loop_of(const std::vector<bw12_446_ate_G1_precomp> &prec_P,
+                                                       const std::vector<G2_precomp_type> &prec_Q)
+{
+    assert(prec_P.size() == prec_Q.size());
+    enter_block("Call to bw12_446_ate_multi_miller_loop");
+
+    std::vector<const bw12_446_ate_G1_precomp*> P_ptrs;
+    std::vector<const bw12_446_ate_ell_coeffs*> Q_ptrs;
+    P_ptrs.reserve(prec_P.size());
+    Q_ptrs.reserve(prec_Q.size());
+    for (size_t i = 0; i < prec_P.size(); ++i)
+    {
+        P_ptrs.emplace_back(&prec_P[i]);
+        Q_ptrs.emplace_back(prec_Q[i].coeffs.data());
+    }
+    const bw12_446_Fq12 f = bw12_446_ate_multi_miller_loop_inner(P_ptrs, Q_ptrs);
+
+    leave_block("Call to bw12_446_ate_multi_miller_loop");
+    return f;
+}
+
+bw12_446_Fq12 bw12_446_ate_multi_miller_loop(const std::vector<bw12_446_ate_G1_precomp> &prec_P,
+                                             const std::vector<bw12_446_ate_G2_precomp> &prec_Q)
+{
+    return bw12_446_ate_multi_miller_loop_of(prec_P, prec_Q);
+}
+
+bw12_446_Fq12 bw12_446_ate_multi_miller_loop(const std::vector<bw12_446_ate_G1_precomp> &prec_P,
+                                             const std::vector<bw12_446_ate_G2_precomp_view> &prec_Q)
+{
+    return bw12_446_ate_multi_miller_loop_of(prec_P, prec_Q);
+}
+
 bw12_446_Fq12 bw12_446_ate_pairing(const bw12_446_G1& P, const bw12_446_G2 &Q)
 {
     enter_block("Call to bw12_446_ate_pairing");
@@ -575,6 +645,12 @@ bw12_446_Fq12 bw12_446_miller_loop(const bw12_446_G1_precomp &prec_P,
     return bw12_446_ate_miller_loop(prec_P, prec_Q);
 }
 
+bw12_446_Fq12 bw12_446_miller_loop(const bw12_446_G1_precomp &prec_P,
+                          const bw12_446_G2_precomp_view &prec_Q)
+{
+    return bw12_446_ate_miller_loop(prec_P, prec_Q);
+}
+
 bw12_446_Fq12 bw12_446_double_miller_loop(const bw12_446_G1_precomp &prec_P1,
                                  const bw12_446_G2_precomp &prec_Q1,
                                  const bw12_446_G1_precomp &prec_P2,
@@ -583,6 +659,26 @@ bw12_446_Fq12 bw12_446_double_miller_loop(const bw12_446_G1_precomp &prec_P1,
     return bw12_446_ate_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
 }
 
+bw12_446_Fq12 bw12_446_double_miller_loop(const bw12_446_G1_precomp &prec_P1,
+                                 const bw12_446_G2_precomp_view &prec_Q1,
+                                 const bw12_446_G1_precomp &prec_P2,
+                                 const bw12_446_G2_precomp_view &prec_Q2)
+{
+    return bw12_446_ate_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
+}
+
+bw12_446_Fq12 bw12_446_multi_miller_loop(const std::vector<bw12_446_G1_precomp> &prec_P,
+                               const std::vector<bw12_446_G2_precomp> &prec_Q)
+{
+    return bw12_446_ate_multi_miller_loop(prec_P, prec_Q);
+}
+
+bw12_446_Fq12 bw12_446_multi_miller_loop(const std::vector<bw12_446_G1_precomp> &prec_P,
+                               const std::vector<bw12_446_G2_precomp_view> &prec_Q)
+{
+    return bw12_446_ate_multi_miller_loop(prec_P, prec_Q);
+}
+
 bw12_446_Fq12 bw12_446_pairing(const bw12_446_G1& P,
                       const bw12_446_G2 &Q)
 {
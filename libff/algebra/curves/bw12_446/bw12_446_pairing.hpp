@@ -3,6 +3,8 @@
 #include <vector>
 
 #include <libff/algebra/curves/bw12_446/bw12_446_init.hpp>
+#include <libff/algebra/curves/precomp_coeffs.hpp>
+#include <libff/common/memory_accounting.hpp>
 
 namespace libff {
 
@@ -35,21 +37,41 @@ struct bw12_446_ate_G2_precomp {
     bw12_446_Fq2 QX;
     bw12_446_Fq2 QY;
     std::vector<bw12_446_ate_ell_coeffs> coeffs;
+    mem_charge<mem_tag_pairing_precomp> coeffs_mem;
 
     bool operator==(const bw12_446_ate_G2_precomp &other) const;
     friend std::ostream& operator<<(std::ostream &out, const bw12_446_ate_G2_precomp &prec_Q);
     friend std::istream& operator>>(std::istream &in, bw12_446_ate_G2_precomp &prec_Q);
 };
 
+/* a G2 precomputation whose coefficients are read in place, e.g. from a mapped file (see flat_precomp.hpp) */
+struct bw12_446_ate_G2_precomp_view {
+    bw12_446_Fq2 QX;
+    bw12_446_Fq2 QY;
+    precomp_coeffs_view<bw12_446_ate_ell_coeffs> coeffs;
+};
+
 bw12_446_ate_G1_precomp bw12_446_ate_precompute_G1(const bw12_446_G1& P);
 bw12_446_ate_G2_precomp bw12_446_ate_precompute_G2(const bw12_446_G2& Q);
 
 bw12_446_Fq12 bw12_446_ate_miller_loop(const bw12_446_ate_G1_precomp &prec_P,
                               const bw12_446_ate_G2_precomp &prec_Q);
+bw12_446_Fq12 bw12_446_ate_miller_loop(const bw12_446_ate_G1_precomp &prec_P,
+                              const bw12_446_ate_G2_precomp_view &prec_Q);
 bw12_446_Fq12 bw12_446_ate_double_miller_loop(const bw12_446_ate_G1_precomp &prec_P1,
                                      const bw12_446_ate_G2_precomp &prec_Q1,
                                      const bw12_446_ate_G1_precomp &prec_P2,
                                      const bw12_446_ate_G2_precomp &prec_Q2);
+bw12_446_Fq12 bw12_446_ate_double_miller_loop(const bw12_446_ate_G1_precomp &prec_P1,
+                                     const bw12_446_ate_G2_precomp_view &prec_Q1,
+                                     const bw12_446_ate_G1_precomp &prec_P2,
+                                     const bw12_446_ate_G2_precomp_view &prec_Q2);
+
+/* product of the Miller loops of all pairs (prec_P[i], prec_Q[i]) */
+bw12_446_Fq12 bw12_446_ate_multi_miller_loop(const std::vector<bw12_446_ate_G1_precomp> &prec_P,
+                                   const std::vector<bw12_446_ate_G2_precomp> &prec_Q);
+bw12_446_Fq12 bw12_446_ate_multi_miller_loop(const std::vector<bw12_446_ate_G1_precomp> &prec_P,
+                                   const std::vector<bw12_446_ate_G2_precomp_view> &prec_Q);
 
 bw12_446_Fq12 bw12_446_ate_pairing(const bw12_446_G1& P,
                           const bw12_446_G2 &Q);
@@ -60,6 +82,7 @@ bw12_446_GT bw12_446_ate_reduced_pairing(const bw12_446_G1 &P,
 
 typedef bw12_446_ate_G1_precomp bw12_446_G1_precomp;
 typedef bw12_446_ate_G2_precomp bw12_446_G2_precomp;
+typedef bw12_446_ate_G2_precomp_view bw12_446_G2_precomp_view;
 
 bw12_446_G1_precomp bw12_446_precompute_G1(const bw12_446_G1& P);
 
@@ -67,11 +90,21 @@ bw12_446_G2_precomp bw12_446_precompute_G2(const bw12_446_G2& Q);
 
 bw12_446_Fq12 bw12_446_miller_loop(const bw12_446_G1_precomp &prec_P,
                           const bw12_446_G2_precomp &prec_Q);
+bw12_446_Fq12 bw12_446_miller_loop(const bw12_446_G1_precomp &prec_P,
+                          const bw12_446_G2_precomp_view &prec_Q);
 
 bw12_446_Fq12 bw12_446_double_miller_loop(const bw12_446_G1_precomp &prec_P1,
                                  const bw12_446_G2_precomp &prec_Q1,
                                  const bw12_446_G1_precomp &prec_P2,
                                  const bw12_446_G2_precomp &prec_Q2);
+bw12_446_Fq12 bw12_446_double_miller_loop(const bw12_446_G1_precomp &prec_P1,
+                                 const bw12_446_G2_precomp_view &prec_Q1,
+                                 const bw12_446_G1_precomp &prec_P2,
+                                 const bw12_446_G2_precomp_view &prec_Q2);
+bw12_446_Fq12 bw12_446_multi_miller_loop(const std::vector<bw12_446_G1_precomp> &prec_P,
+                               const std::vector<bw12_446_G2_precomp> &prec_Q);
+bw12_446_Fq12 bw12_446_multi_miller_loop(const std::vector<bw12_446_G1_precomp> &prec_P,
+                               const std::vector<bw12_446_G2_precomp_view> &prec_Q);
 
 bw12_446_Fq12 bw12_446_pairing(const bw12_446_G1& P,
                       const bw12_446_G2 &Q);
@@ -28,6 +28,12 @@ bw12_446_Fq12 bw12_446_pp::miller_loop(const bw12_446_G1_precomp &prec_P,
     return bw12_446_miller_loop(prec_P, prec_Q);
 }
 
+bw12_446_Fq12 bw12_446_pp::miller_loop(const bw12_446_G1_precomp &prec_P,
+                                         const bw12_446_G2_precomp_view &prec_Q)
+{
+    return bw12_446_miller_loop(prec_P, prec_Q);
+}
+
 bw12_446_Fq12 bw12_446_pp::double_miller_loop(const bw12_446_G1_precomp &prec_P1,
                                                 const bw12_446_G2_precomp &prec_Q1,
                                                 const bw12_446_G1_precomp &prec_P2,
@@ -36,6 +42,26 @@ bw12_446_Fq12 bw12_446_pp::double_miller_loop(const bw12_446_G1_precomp &prec_P1
     return bw12_446_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
 }
 
+bw12_446_Fq12 bw12_446_pp::double_miller_loop(const bw12_446_G1_precomp &prec_P1,
+                                                const bw12_446_G2_precomp_view &prec_Q1,
+                                                const bw12_446_G1_precomp &prec_P2,
+                                                const bw12_446_G2_precomp_view &prec_Q2)
+{
+    return bw12_446_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
+}
+
+bw12_446_Fq12 bw12_446_pp::multi_miller_loop(const std::vector<bw12_446_G1_precomp> &prec_P,
+                                   const std::vector<bw12_446_G2_precomp> &prec_Q)
+{
+    return bw12_446_multi_miller_loop(prec_P, prec_Q);
+}
+
+bw12_446_Fq12 bw12_446_pp::multi_miller_loop(const std::vector<bw12_446_G1_precomp> &prec_P,
+                                   const std::vector<bw12_446_G2_precomp_view> &prec_Q)
+{
+    return bw12_446_multi_miller_loop(prec_P, prec_Q);
+}
+
 bw12_446_Fq12 bw12_446_pp::pairing(const bw12_446_G1 &P,
                                      const bw12_446_G2 &Q)
 {
@@ -15,6 +15,7 @@ public:
     typedef bw12_446_G2 G2_type;
     typedef bw12_446_G1_precomp G1_precomp_type;
     typedef bw12_446_G2_precomp G2_precomp_type;
+    typedef bw12_446_G2_precomp_view G2_precomp_view_type;
     typedef bw12_446_Fq Fq_type;
     typedef bw12_446_Fq2 Fqe_type;
     typedef bw12_446_Fq12 Fqk_type;
@@ -28,10 +29,20 @@ public:
     static bw12_446_G2_precomp precompute_G2(const bw12_446_G2 &Q);
     static bw12_446_Fq12 miller_loop(const bw12_446_G1_precomp &prec_P,
                                       const bw12_446_G2_precomp &prec_Q);
+    static bw12_446_Fq12 miller_loop(const bw12_446_G1_precomp &prec_P,
+                                      const bw12_446_G2_precomp_view &prec_Q);
     static bw12_446_Fq12 double_miller_loop(const bw12_446_G1_precomp &prec_P1,
                                              const bw12_446_G2_precomp &prec_Q1,
                                              const bw12_446_G1_precomp &prec_P2,
                                              const bw12_446_G2_precomp &prec_Q2);
+    static bw12_446_Fq12 double_miller_loop(const bw12_446_G1_precomp &prec_P1,
+                                             const bw12_446_G2_precomp_view &prec_Q1,
+                                             const bw12_446_G1_precomp &prec_P2,
+                                             const bw12_446_G2_precomp_view &prec_Q2);
+    static bw12_446_Fq12 multi_miller_loop(const std::vector<bw12_446_G1_precomp> &prec_P,
+                                      const std::vector<bw12_446_G2_precomp> &prec_Q);
+    static bw12_446_Fq12 multi_miller_loop(const std::vector<bw12_446_G1_precomp> &prec_P,
+                                      const std::vector<bw12_446_G2_precomp_view> &prec_Q);
     static bw12_446_Fq12 pairing(const bw12_446_G1 &P,
                                   const bw12_446_G2 &Q);
     static bw12_446_Fq12 reduced_pairing(const bw12_446_G1 &P,
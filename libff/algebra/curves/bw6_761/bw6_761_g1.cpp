@@ -1,10 +1,13 @@
+#include <atomic>
+
 #include <libff/algebra/curves/bw6_761/bw6_761_g1.hpp>
+#include <libff/common/execution.hpp>
 
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long bw6_761_G1::add_cnt = 0;
-long long bw6_761_G1::dbl_cnt = 0;
+op_counter bw6_761_G1::add_cnt("bw6_761_G1::add");
+op_counter bw6_761_G1::dbl_cnt("bw6_761_G1::dbl");
 #endif
 
 std::vector<size_t> bw6_761_G1::wnaf_window_table;
@@ -158,6 +161,9 @@ bw6_761_G1 bw6_761_G1::operator+(const bw6_761_G1 &other) const
     if (X1Z2 == X2Z1 && Y1Z2 == Y2Z1)
     {
         // perform dbl case
+#ifdef PROFILE_OP_COUNTS
+        this->dbl_cnt++;
+#endif
         const bw6_761_Fq XX   = (this->X_).squared();                   // XX  = X1^2
         const bw6_761_Fq w    = XX + XX + XX;                           // w   = 3*XX (a=0)
         const bw6_761_Fq Y1Z1 = (this->Y_) * (this->Z_);
@@ -176,6 +182,9 @@ bw6_761_G1 bw6_761_G1::operator+(const bw6_761_G1 &other) const
     }
 
     // if we have arrived here we are in the add case
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
     const bw6_761_Fq Z1Z2 = (this->Z_) * (other.Z_);      // Z1Z2 = Z1*Z2
     const bw6_761_Fq u    = Y2Z1 - Y1Z2;                  // u    = Y2*Z1-Y1Z2
     const bw6_761_Fq uu   = u.squared();                  // uu   = u^2
@@ -355,6 +364,29 @@ bool bw6_761_G1::is_well_formed() const
     }
 }
 
+bool bw6_761_G1::is_in_correct_subgroup() const
+{
+    /*
+      The points of E(Fq) with [a]P = [b]phi(P) form the kernel of a - b*phi,
+      of order a^2 + ab + b^2. That is a multiple of r coprime to the
+      cofactor, so the check is exact, and a and b have half the size of r.
+    */
+    const bw6_761_G1 minus_phi(bw6_761_g1_endomorphism_beta * this->X_, -this->Y_, this->Z_);
+    return double_scalar_mul(*this, bw6_761_g1_subgroup_check_a, minus_phi, bw6_761_g1_subgroup_check_b).is_zero();
+}
+
+bool bw6_761_G1::batch_is_in_correct_subgroup(const std::vector<bw6_761_G1> &vec)
+{
+    std::atomic<bool> result(true);
+    parallel_for(0, vec.size(), [&](const size_t i) {
+        if (result.load(std::memory_order_relaxed) && !vec[i].is_in_correct_subgroup())
+        {
+            result.store(false, std::memory_order_relaxed);
+        }
+    });
+    return result.load();
+}
+
 bw6_761_G1 bw6_761_G1::zero()
 {
     return G1_zero;
@@ -3,8 +3,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long bw6_761_G2::add_cnt = 0;
-long long bw6_761_G2::dbl_cnt = 0;
+op_counter bw6_761_G2::add_cnt("bw6_761_G2::add");
+op_counter bw6_761_G2::dbl_cnt("bw6_761_G2::dbl");
 #endif
 
 std::vector<size_t> bw6_761_G2::wnaf_window_table;
@@ -166,6 +166,9 @@ bw6_761_G2 bw6_761_G2::operator+(const bw6_761_G2 &other) const
     if (X1Z2 == X2Z1 && Y1Z2 == Y2Z1)
     {
         // perform dbl case
+#ifdef PROFILE_OP_COUNTS
+        this->dbl_cnt++;
+#endif
         const bw6_761_Fq XX   = (this->X_).squared();                   // XX  = X1^2
         const bw6_761_Fq w    = XX + XX + XX;                           // w   = a*ZZ + 3*XX (a=0)
         const bw6_761_Fq Y1Z1 = (this->Y_) * (this->Z_);
@@ -184,6 +187,9 @@ bw6_761_G2 bw6_761_G2::operator+(const bw6_761_G2 &other) const
     }
 
     // if we have arrived here we are in the add case
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
     const bw6_761_Fq Z1Z2 = (this->Z_) * (other.Z_);   // Z1Z2 = Z1*Z2
     const bw6_761_Fq u    = Y2Z1 - Y1Z2;               // u    = Y2*Z1-Y1Z2
     const bw6_761_Fq uu   = u.squared();               // uu   = u^2
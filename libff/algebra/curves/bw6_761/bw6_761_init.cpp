@@ -11,9 +11,12 @@ bw6_761_Fq bw6_761_coeff_b;
 bw6_761_Fq bw6_761_twist;
 bw6_761_Fq bw6_761_twist_coeff_b;
 
+bw6_761_Fq bw6_761_g1_endomorphism_beta;
+bigint<bw6_761_r_limbs> bw6_761_g1_subgroup_check_a;
+bigint<bw6_761_r_limbs> bw6_761_g1_subgroup_check_b;
+
 bigint<bw6_761_q_limbs> bw6_761_ate_loop_count1;
 bigint<bw6_761_q_limbs> bw6_761_ate_loop_count2;
-bool bw6_761_ate_is_loop_count_neg;
 bigint<bw6_761_q_limbs> bw6_761_final_exponent_z;
 bool bw6_761_final_exponent_is_z_neg;
 
@@ -24,6 +27,11 @@ void init_bw6_761_params()
     typedef bigint<bw6_761_r_limbs> bigint_r;
     typedef bigint<bw6_761_q_limbs> bigint_q;
 
+#ifdef PROFILE_OP_COUNTS
+    bw6_761_Fr::name_op_counters("bw6_761_Fr");
+    bw6_761_Fq::name_op_counters("bw6_761_Fq");
+#endif
+
     assert(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
 
     /* parameters for scalar field Fr */
@@ -155,6 +163,10 @@ void init_bw6_761_params()
     bw6_761_G1::G1_one = bw6_761_G1(bw6_761_Fq("6238772257594679368032145693622812838779005809760824733138787810501188623461307351759238099287535516224314149266511977132140828635950940021790489507611754366317801811090811367945064510304504157188661901055903167026722666149426237"),
                                     bw6_761_Fq("2101735126520897423911504562215834951148127555913367997162789335052900271653517958562461315794228241561913734371411178226936527683203879553093934185950470971848972085321797958124416462268292467002957525517188485984766314758624099"),
                                     bw6_761_Fq::one());
+    bw6_761_g1_endomorphism_beta = bw6_761_Fq("1968985824090209297278610739700577151397666382303825728450741611566800370218827257750865013421937292370006175842381275743914023380727582819905021229583192207421122272650305267822868639090213645505120388400344940985710520836292650");
+    /* a = b*lambda mod r for the eigenvalue lambda of phi on G1, and a^2 + ab + b^2 is coprime to the cofactor */
+    bw6_761_g1_subgroup_check_a = bigint_r("293634935485640680722085584138834120315328839056164388863");
+    bw6_761_g1_subgroup_check_b = bigint_r("293634935485640680722085584138834120324914961969255022593");
 
     // TODO: wNAF window table
     bw6_761_G1::wnaf_window_table.resize(0);
@@ -289,11 +301,10 @@ void init_bw6_761_params()
 
 
     /* pairing parameters */
-    // z+1
-    bw6_761_ate_loop_count1 = bigint_q("9586122913090633730");
-    // z^3-z^2-z
-    bw6_761_ate_loop_count2 = bigint_q("880904806456922042166256752416502360955572640081583800319");
-    bw6_761_ate_is_loop_count_neg = false;
+    // z
+    bw6_761_ate_loop_count1 = bigint_q("9586122913090633729");
+    // z^2-z-1
+    bw6_761_ate_loop_count2 = bigint_q("91893752504881257691937156713741811711");
     bw6_761_final_exponent_z = bigint_q("9586122913090633729");
     bw6_761_final_exponent_is_z_neg = false;
 
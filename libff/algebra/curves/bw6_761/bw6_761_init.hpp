@@ -29,10 +29,16 @@ extern bw6_761_Fq bw6_761_twist;
 extern bw6_761_Fq bw6_761_twist_coeff_b;
 extern bool bw6_761_D_twist;
 
-// parameters for pairing
+// parameters for the subgroup check of G1: with the endomorphism phi(x, y) = (beta * x, y),
+// P in E(Fq) is in G1 iff [a]P = [b]phi(P) (see is_in_correct_subgroup)
+extern bw6_761_Fq bw6_761_g1_endomorphism_beta;
+extern bigint<bw6_761_r_limbs> bw6_761_g1_subgroup_check_a;
+extern bigint<bw6_761_r_limbs> bw6_761_g1_subgroup_check_b;
+
+// parameters for pairing: the optimal ate pairing f_{z+1,Q} * f_{z^3-z^2-z,Q}^q is computed with
+// a loop over loop_count1 = z and a loop over loop_count2 = z^2-z-1 (both positive)
 extern bigint<bw6_761_q_limbs> bw6_761_ate_loop_count1;
 extern bigint<bw6_761_q_limbs> bw6_761_ate_loop_count2;
-extern bool bw6_761_ate_is_loop_count_neg;
 extern bigint<bw6_761_q_limbs> bw6_761_final_exponent_z;
 extern bool bw6_761_final_exponent_is_z_neg;
 
@@ -4,6 +4,7 @@
 #include <libff/algebra/curves/bw6_761/bw6_761_g2.hpp>
 #include <libff/algebra/curves/bw6_761/bw6_761_init.hpp>
 #include <libff/algebra/curves/bw6_761/bw6_761_pairing.hpp>
+#include <libff/common/memory_accounting.hpp>
 #include <libff/common/profiling.hpp>
 
 namespace libff {
@@ -95,6 +96,8 @@ std::istream& operator>>(std::istream& in, bw6_761_ate_G2_precomp &prec_Q)
         prec_Q.coeffs.emplace_back(c);
     }
 
+    prec_Q.coeffs_mem.set(prec_Q.coeffs.capacity() * sizeof(bw6_761_ate_ell_coeffs));
+
     return in;
 }
 
@@ -145,6 +148,8 @@ bw6_761_Fq6 bw6_761_final_exponentiation_last_chunk(const bw6_761_Fq6 &elt)
      * f^R0(u)*(f^p)^R1(u) avec R0 et R1 ci-dessus et f^p est un Frobenius dans GF(p^6).
      */
 
+    /* elt is in the cyclotomic subgroup, and so are all the values below */
+
     const bw6_761_Fq6 f0 = elt;
     const bw6_761_Fq6 f0p = f0.Frobenius_map(1);
     const bw6_761_Fq6 f1 = bw6_761_exp_by_z(f0);
@@ -170,46 +175,46 @@ bw6_761_Fq6 bw6_761_final_exponentiation_last_chunk(const bw6_761_Fq6 &elt)
     const bw6_761_Fq6 result1 = f3p * f6p * f5p.unitary_inverse();
 
     // 6
-    const bw6_761_Fq6 result2 = result1.squared();
+    const bw6_761_Fq6 result2 = result1.cyclotomic_squared();
     const bw6_761_Fq6 f4_2p = f4 * f2p;
     const bw6_761_Fq6 result3 = result2 * f5 * f0p * (f0 * f1 * f3 * f4_2p * f8p).unitary_inverse();
 
     // 7
-    const bw6_761_Fq6 result4 = result3.squared();
+    const bw6_761_Fq6 result4 = result3.cyclotomic_squared();
     const bw6_761_Fq6 result5 = result4 * f9p * f7.unitary_inverse();
 
     // 8
-    const bw6_761_Fq6 result6 = result5.squared();
+    const bw6_761_Fq6 result6 = result5.cyclotomic_squared();
     const bw6_761_Fq6 f2_4p = f2 * f4p;
     const bw6_761_Fq6 f4_2p_5p = f4_2p * f5p;
     const bw6_761_Fq6 result7 = result6 * f4_2p_5p * f6 * f7p * (f2_4p * f3 * f3p).unitary_inverse();
 
     // 9
-    const bw6_761_Fq6 result8 = result7.squared();
+    const bw6_761_Fq6 result8 = result7.cyclotomic_squared();
     const bw6_761_Fq6 result9 = result8 * f0 * f7 * f1p * (f0p * f9p).unitary_inverse();
 
     // 10
-    const bw6_761_Fq6 result10 = result9.squared();
+    const bw6_761_Fq6 result10 = result9.cyclotomic_squared();
     const bw6_761_Fq6 f6p_8p = f6p * f8p;
     const bw6_761_Fq6 f5_7p = f5 * f7p;
     const bw6_761_Fq6 result11 = result10 * f5_7p * f2p * (f6p_8p).unitary_inverse();
 
     // 11
-    const bw6_761_Fq6 result12 = result11.squared();
+    const bw6_761_Fq6 result12 = result11.cyclotomic_squared();
     const bw6_761_Fq6 f3_6 = f3 * f6;
     const bw6_761_Fq6 f1_7 = f1 * f7;
     const bw6_761_Fq6 result13 = result12 * f3_6 * f9p * (f1_7 * f2).unitary_inverse();
 
     // 12
-    const bw6_761_Fq6 result14 = result13.squared();
+    const bw6_761_Fq6 result14 = result13.cyclotomic_squared();
     const bw6_761_Fq6 result15 = result14 * f0 * f0p * f3p * f5p * (f4_2p * f5_7p * f6p_8p).unitary_inverse();
 
     // 13
-    const bw6_761_Fq6 result16 = result15.squared();
+    const bw6_761_Fq6 result16 = result15.cyclotomic_squared();
     const bw6_761_Fq6 result17 = result16 * f1p * (f3_6).unitary_inverse();
 
     // 14
-    const bw6_761_Fq6 result18 = result17.squared();
+    const bw6_761_Fq6 result18 = result17.cyclotomic_squared();
     const bw6_761_Fq6 result19 = result18 * f1_7 * f5_7p * f0p * (f2_4p * f4_2p_5p * f9p).unitary_inverse();
 
     leave_block("Call to bw6_761_final_exponentiation_last_chunk");
@@ -313,21 +318,14 @@ bw6_761_ate_G1_precomp bw6_761_ate_precompute_G1(const bw6_761_G1& P)
     return result;
 }
 
-bw6_761_ate_G2_precomp bw6_761_ate_precompute_G2(const bw6_761_G2& Q, const bigint<bw6_761_Fq::num_limbs> &loop_count)
-{
-    enter_block("Call to bw6_761_ate_precompute_G2");
-
-    bw6_761_G2 Qcopy(Q);
-    Qcopy.to_affine_coordinates();
 
-    bw6_761_ate_G2_precomp result;
-    result.QX = Qcopy.X_;
-    result.QY = Qcopy.Y_;
-
-    bw6_761_G2 R;
-    R.X_ = Qcopy.X_;
-    R.Y_ = Qcopy.Y_;
-    R.Z_ = bw6_761_Fq::one();
+/* the lines of f_{n,R} for the NAF of n, from R in affine coordinates; returns [n]R */
+static bw6_761_G2 bw6_761_ate_precompute_loop(const bw6_761_G2 &R_affine,
+                                              const bigint<bw6_761_Fq::num_limbs> &loop_count,
+                                              std::vector<bw6_761_ate_ell_coeffs> &coeffs)
+{
+    bw6_761_G2 R = R_affine;
+    const bw6_761_G2 minus_R_affine = -R_affine;
 
     bool found_nonzero = false;
     bw6_761_ate_ell_coeffs c;
@@ -343,214 +341,186 @@ bw6_761_ate_G2_precomp bw6_761_ate_precompute_G2(const bw6_761_G2& Q, const bigi
         }
 
         doubling_step_for_miller_loop(R, c);
-        result.coeffs.push_back(c);
+        coeffs.push_back(c);
 
         if (NAF[i] != 0)
         {
-          if (NAF[i] > 0)
-          {
-            mixed_addition_step_for_miller_loop(Qcopy, R, c);
-          }
-          else
-          {
-            mixed_addition_step_for_miller_loop(-Qcopy, R, c);
-          }
-          result.coeffs.push_back(c);
+            mixed_addition_step_for_miller_loop(NAF[i] > 0 ? R_affine : minus_R_affine, R, c);
+            coeffs.push_back(c);
         }
     }
 
-    leave_block("Call to bw6_761_ate_precompute_G2");
-    return result;
+    return R;
 }
 
-bw6_761_Fq6 bw6_761_ate_miller_loop(const bw6_761_ate_G1_precomp &prec_P,
-                                     const bw6_761_ate_G2_precomp &prec_Q_1,
-                                     const bw6_761_ate_G2_precomp &prec_Q_2)
+bw6_761_ate_G2_precomp bw6_761_ate_precompute_G2(const bw6_761_G2& Q)
 {
-    enter_block("Call to bw6_761_optimal_ate_miller_loop");
+    enter_block("Call to bw6_761_ate_precompute_G2");
+
+    bw6_761_G2 Qcopy(Q);
+    Qcopy.to_affine_coordinates();
+
+    bw6_761_ate_G2_precomp result;
+    result.QX = Qcopy.X_;
+    result.QY = Qcopy.Y_;
+
+    /* f_{u,Q}, then the line through [u]Q and Q of f_{u+1,Q} */
+    bw6_761_G2 uQ = bw6_761_ate_precompute_loop(Qcopy, bw6_761_ate_loop_count1, result.coeffs);
+    bw6_761_G2 R = uQ;
+    bw6_761_ate_ell_coeffs c;
+    mixed_addition_step_for_miller_loop(Qcopy, R, c);
+    result.coeffs.push_back(c);
 
-    // f_{u+1,Q}(P)
-    bw6_761_Fq6 f_1 = bw6_761_Fq6::one();
+    /* f_{u^2-u-1,[u]Q} */
+    uQ.to_affine_coordinates();
+    bw6_761_ate_precompute_loop(uQ, bw6_761_ate_loop_count2, result.coeffs);
 
-    bool found_nonzero_1 = false;
-    size_t idx_1 = 0;
+    result.coeffs_mem.set(result.coeffs.capacity() * sizeof(bw6_761_ate_ell_coeffs));
 
-    const bigint<bw6_761_Fq::num_limbs> &loop_count_1 = bw6_761_ate_loop_count1;
-    bw6_761_ate_ell_coeffs c_1;
+    leave_block("Call to bw6_761_ate_precompute_G2");
+    return result;
+}
 
-    std::vector<long> NAF_1 = find_wnaf(1, loop_count_1);
-    for (long i = NAF_1.size() - 1; i >= 0; --i)
+/* multiply f by the lines at position idx of all pairs */
+static void bw6_761_ate_mul_by_lines(bw6_761_Fq6 &f,
+                                     const std::vector<const bw6_761_ate_G1_precomp*> &prec_P,
+                                     const std::vector<const bw6_761_ate_G2_precomp*> &prec_Q,
+                                     const size_t idx)
+{
+    for (size_t i = 0; i < prec_P.size(); ++i)
     {
-        if (!found_nonzero_1)
+        const bw6_761_ate_ell_coeffs &c = prec_Q[i]->coeffs[idx];
+        if (bw6_761_D_twist)
         {
-            /* this skips the MSB itself */
-            found_nonzero_1 |= (NAF_1[i] != 0);
-            continue;
+            f = f.mul_by_024(c.ell_0, prec_P[i]->PY * c.ell_VW, prec_P[i]->PX * c.ell_VV);
         }
+        else
+        {
+            f = f.mul_by_045(c.ell_0, prec_P[i]->PY * c.ell_VW, prec_P[i]->PX * c.ell_VV);
+        }
+    }
+}
 
-        /* code below gets executed for all bits (EXCEPT the MSB itself) of
-           bw6_761_param_p (skipping leading zeros) in MSB to LSB
-           order */
+/*
+  The optimal ate pairing is f_{u+1,Q}(P) * f_{u^3-u^2-u,Q}(P)^q, and
 
-        c_1 = prec_Q_1.coeffs[idx_1++];
-        f_1 = f_1.squared();
+    f_{u^3-u^2-u,Q} = f_{u,Q}^{u^2-u-1} * f_{u^2-u-1,[u]Q}
 
-        if(bw6_761_D_twist)
-          f_1 = f_1.mul_by_024(c_1.ell_0, prec_P.PY * c_1.ell_VW, prec_P.PX * c_1.ell_VV);
-        else
-          f_1 = f_1.mul_by_045(c_1.ell_0, prec_P.PY * c_1.ell_VW, prec_P.PX * c_1.ell_VV);
+  (Alg. 5 of El Housni--Guillevic, ePrint 2020/351). The first loop, over u,
+  gives f_{u,Q}, from which f_{u+1,Q} is one line away. The second loop, over
+  u^2-u-1, computes both factors of the product at once: it starts from
+  f_{u,Q} instead of 1 and multiplies by f_{u,Q}^{+-1} at each nonzero digit.
+  Both loops are shared by all pairs, so they square only one accumulator.
+*/
+static bw6_761_Fq6 bw6_761_ate_multi_miller_loop_inner(const std::vector<const bw6_761_ate_G1_precomp*> &prec_P,
+                                                       const std::vector<const bw6_761_ate_G2_precomp*> &prec_Q)
+{
+    size_t idx = 0;
+
+    /* f_{u,Q}(P) */
+    bw6_761_Fq6 f_u = bw6_761_Fq6::one();
 
-        if (NAF_1[i] != 0)
+    bool found_nonzero = false;
+    std::vector<long> NAF = find_wnaf(1, bw6_761_ate_loop_count1);
+    for (long i = NAF.size() - 1; i >= 0; --i)
+    {
+        if (!found_nonzero)
         {
-            c_1 = prec_Q_1.coeffs[idx_1++];
-            if(bw6_761_D_twist)
-              f_1 = f_1.mul_by_024(c_1.ell_0, prec_P.PY * c_1.ell_VW, prec_P.PX * c_1.ell_VV);
-            else
-              f_1 = f_1.mul_by_045(c_1.ell_0, prec_P.PY * c_1.ell_VW, prec_P.PX * c_1.ell_VV);
+            /* this skips the MSB itself */
+            found_nonzero |= (NAF[i] != 0);
+            continue;
         }
 
-    }
+        f_u = f_u.squared();
+        bw6_761_ate_mul_by_lines(f_u, prec_P, prec_Q, idx++);
 
-    if (bw6_761_ate_is_loop_count_neg)
-    {
-    	f_1 = f_1.inverse();
+        if (NAF[i] != 0)
+        {
+            bw6_761_ate_mul_by_lines(f_u, prec_P, prec_Q, idx++);
+        }
     }
 
-    // f_{u^3-u^2-u,Q}(P)
-    bw6_761_Fq6 f_2 = bw6_761_Fq6::one();
-
-    bool found_nonzero_2 = false;
-    size_t idx_2 = 0;
+    /* f_{u+1,Q}(P) */
+    bw6_761_Fq6 f_1 = f_u;
+    bw6_761_ate_mul_by_lines(f_1, prec_P, prec_Q, idx++);
 
-    const bigint<bw6_761_Fq::num_limbs> &loop_count_2 = bw6_761_ate_loop_count2;
-    bw6_761_ate_ell_coeffs c_2;
+    /* f_{u,Q}(P)^{u^2-u-1} * f_{u^2-u-1,[u]Q}(P) */
+    const bw6_761_Fq6 f_u_inv = f_u.inverse();
+    bw6_761_Fq6 f_2 = f_u;
 
-    std::vector<long> NAF_2 = find_wnaf(1, loop_count_2);
-    for (long i = NAF_2.size() - 1; i >= 0; --i)
+    found_nonzero = false;
+    NAF = find_wnaf(1, bw6_761_ate_loop_count2);
+    for (long i = NAF.size() - 1; i >= 0; --i)
     {
-        if (!found_nonzero_2)
+        if (!found_nonzero)
         {
             /* this skips the MSB itself */
-            found_nonzero_2 |= (NAF_2[i] != 0);
+            found_nonzero |= (NAF[i] != 0);
             continue;
         }
 
-        /* code below gets executed for all bits (EXCEPT the MSB itself) of
-           bw6_761_param_p (skipping leading zeros) in MSB to LSB
-           order */
-
-        c_2 = prec_Q_2.coeffs[idx_2++];
         f_2 = f_2.squared();
-        if(bw6_761_D_twist)
-          f_2 = f_2.mul_by_024(c_2.ell_0, prec_P.PY * c_2.ell_VW, prec_P.PX * c_2.ell_VV);
-        else
-          f_2 = f_2.mul_by_045(c_2.ell_0, prec_P.PY * c_2.ell_VW, prec_P.PX * c_2.ell_VV);
+        bw6_761_ate_mul_by_lines(f_2, prec_P, prec_Q, idx++);
 
-        if (NAF_2[i] != 0)
+        if (NAF[i] != 0)
         {
-            c_2 = prec_Q_2.coeffs[idx_2++];
-            if(bw6_761_D_twist)
-              f_2 = f_2.mul_by_024(c_2.ell_0, prec_P.PY * c_2.ell_VW, prec_P.PX * c_2.ell_VV);
-            else
-              f_2 = f_2.mul_by_045(c_2.ell_0, prec_P.PY * c_2.ell_VW, prec_P.PX * c_2.ell_VV);
+            f_2 = f_2 * (NAF[i] > 0 ? f_u : f_u_inv);
+            bw6_761_ate_mul_by_lines(f_2, prec_P, prec_Q, idx++);
         }
-
     }
 
-    if (bw6_761_ate_is_loop_count_neg)
-    {
-    	f_2 = f_2.inverse();
-    }
+    return f_1 * f_2.Frobenius_map(1);
+}
 
+bw6_761_Fq6 bw6_761_ate_miller_loop(const bw6_761_ate_G1_precomp &prec_P,
+                                     const bw6_761_ate_G2_precomp &prec_Q)
+{
+    enter_block("Call to bw6_761_optimal_ate_miller_loop");
+    const bw6_761_Fq6 f = bw6_761_ate_multi_miller_loop_inner({ &prec_P }, { &prec_Q });
     leave_block("Call to bw6_761_optimal_ate_miller_loop");
 
-    f_2 = f_2.Frobenius_map(1);
-
-    return f_1 * f_2;
+    return f;
 }
 
-/*
 bw6_761_Fq6 bw6_761_ate_double_miller_loop(const bw6_761_ate_G1_precomp &prec_P1,
-                                     const bw6_761_ate_G2_precomp &prec_Q1,
-                                     const bw6_761_ate_G1_precomp &prec_P2,
-                                     const bw6_761_ate_G2_precomp &prec_Q2)
+                                            const bw6_761_ate_G2_precomp &prec_Q1,
+                                            const bw6_761_ate_G1_precomp &prec_P2,
+                                            const bw6_761_ate_G2_precomp &prec_Q2)
 {
     enter_block("Call to bw6_761_ate_double_miller_loop");
+    const bw6_761_Fq6 f = bw6_761_ate_multi_miller_loop_inner({ &prec_P1, &prec_P2 }, { &prec_Q1, &prec_Q2 });
+    leave_block("Call to bw6_761_ate_double_miller_loop");
 
-    bw6_761_Fq6 f = bw6_761_Fq6::one();
-
-    bool found_one = false;
-    size_t idx = 0;
-
-    const bigint<bw6_761_Fq::num_limbs> &loop_count = bw6_761_ate_loop_count;
-    for (long i = loop_count.max_bits(); i >= 0; --i)
-    {
-        const bool bit = loop_count.test_bit(i);
-        if (!found_one)
-        {
-            // this skips the MSB itself
-            found_one |= bit;
-            continue;
-        }
-
-        // code below gets executed for all bits (EXCEPT the MSB itself) of
-        // bw6_761_param_p (skipping leading zeros) in MSB to LSB
-        // order
-
-        bw6_761_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-        bw6_761_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-        ++idx;
-
-        f = f.squared();
-
-        if(bw6_761_D_twist)
-        {
-          f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-          f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
-        }
-        else
-        {
-          f = f.mul_by_045(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-          f = f.mul_by_045(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
-        }
-
-        if (bit)
-        {
-            bw6_761_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-            bw6_761_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-            ++idx;
-
-            if(bw6_761_D_twist)
-            {
-              f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-              f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
-            }
-            else
-            {
-              f = f.mul_by_045(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-              f = f.mul_by_045(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
-            }
-        }
-    }
+    return f;
+}
 
-    if (bw6_761_ate_is_loop_count_neg)
+bw6_761_Fq6 bw6_761_ate_multi_miller_loop(const std::vector<bw6_761_ate_G1_precomp> &prec_P,
+                                           const std::vector<bw6_761_ate_G2_precomp> &prec_Q)
+{
+    assert(prec_P.size() == prec_Q.size());
+    enter_block("Call to bw6_761_ate_multi_miller_loop");
+
+    std::vector<const bw6_761_ate_G1_precomp*> P_ptrs;
+    std::vector<const bw6_761_ate_G2_precomp*> Q_ptrs;
+    P_ptrs.reserve(prec_P.size());
+    Q_ptrs.reserve(prec_Q.size());
+    for (size_t i = 0; i < prec_P.size(); ++i)
     {
-    	f = f.inverse();
+        P_ptrs.emplace_back(&prec_P[i]);
+        Q_ptrs.emplace_back(&prec_Q[i]);
     }
+    const bw6_761_Fq6 f = bw6_761_ate_multi_miller_loop_inner(P_ptrs, Q_ptrs);
 
-    leave_block("Call to bw6_761_ate_double_miller_loop");
-
+    leave_block("Call to bw6_761_ate_multi_miller_loop");
     return f;
 }
-*/
 
 bw6_761_Fq6 bw6_761_ate_pairing(const bw6_761_G1& P, const bw6_761_G2 &Q)
 {
     enter_block("Call to bw6_761_ate_pairing");
     bw6_761_ate_G1_precomp prec_P = bw6_761_ate_precompute_G1(P);
-    bw6_761_ate_G2_precomp prec_Q_1 = bw6_761_ate_precompute_G2(Q, bw6_761_ate_loop_count1);
-    bw6_761_ate_G2_precomp prec_Q_2 = bw6_761_ate_precompute_G2(Q, bw6_761_ate_loop_count2);
-    bw6_761_Fq6 result = bw6_761_ate_miller_loop(prec_P, prec_Q_1, prec_Q_2);
+    bw6_761_ate_G2_precomp prec_Q = bw6_761_ate_precompute_G2(Q);
+    bw6_761_Fq6 result = bw6_761_ate_miller_loop(prec_P, prec_Q);
     leave_block("Call to bw6_761_ate_pairing");
     return result;
 }
@@ -571,27 +541,30 @@ bw6_761_G1_precomp bw6_761_precompute_G1(const bw6_761_G1& P)
     return bw6_761_ate_precompute_G1(P);
 }
 
-bw6_761_G2_precomp bw6_761_precompute_G2(const bw6_761_G2& Q, const bigint<bw6_761_Fq::num_limbs> &loop_count)
+bw6_761_G2_precomp bw6_761_precompute_G2(const bw6_761_G2& Q)
 {
-    return bw6_761_ate_precompute_G2(Q, loop_count);
+    return bw6_761_ate_precompute_G2(Q);
 }
 
 bw6_761_Fq6 bw6_761_miller_loop(const bw6_761_G1_precomp &prec_P,
-                          const bw6_761_G2_precomp &prec_Q_1,
-                          const bw6_761_G2_precomp &prec_Q_2)
+                                const bw6_761_G2_precomp &prec_Q)
 {
-    return bw6_761_ate_miller_loop(prec_P, prec_Q_1, prec_Q_2);
+    return bw6_761_ate_miller_loop(prec_P, prec_Q);
 }
 
-/*
 bw6_761_Fq6 bw6_761_double_miller_loop(const bw6_761_G1_precomp &prec_P1,
-                                 const bw6_761_G2_precomp &prec_Q1,
-                                 const bw6_761_G1_precomp &prec_P2,
-                                 const bw6_761_G2_precomp &prec_Q2)
+                                       const bw6_761_G2_precomp &prec_Q1,
+                                       const bw6_761_G1_precomp &prec_P2,
+                                       const bw6_761_G2_precomp &prec_Q2)
 {
     return bw6_761_ate_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
 }
-*/
+
+bw6_761_Fq6 bw6_761_multi_miller_loop(const std::vector<bw6_761_G1_precomp> &prec_P,
+                                      const std::vector<bw6_761_G2_precomp> &prec_Q)
+{
+    return bw6_761_ate_multi_miller_loop(prec_P, prec_Q);
+}
 
 bw6_761_Fq6 bw6_761_pairing(const bw6_761_G1& P,
                       const bw6_761_G2 &Q)
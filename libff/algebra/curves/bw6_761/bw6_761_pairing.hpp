@@ -3,6 +3,7 @@
 #include <vector>
 
 #include <libff/algebra/curves/bw6_761/bw6_761_init.hpp>
+#include <libff/common/memory_accounting.hpp>
 
 namespace libff {
 
@@ -38,6 +39,7 @@ struct bw6_761_ate_G2_precomp {
     bw6_761_Fq QX;
     bw6_761_Fq QY;
     std::vector<bw6_761_ate_ell_coeffs> coeffs;
+    mem_charge<mem_tag_pairing_precomp> coeffs_mem;
 
     bool operator==(const bw6_761_ate_G2_precomp &other) const;
     friend std::ostream& operator<<(std::ostream &out, const bw6_761_ate_G2_precomp &prec_Q);
@@ -45,17 +47,19 @@ struct bw6_761_ate_G2_precomp {
 };
 
 bw6_761_ate_G1_precomp bw6_761_ate_precompute_G1(const bw6_761_G1& P);
-bw6_761_ate_G2_precomp bw6_761_ate_precompute_G2(const bw6_761_G2& Q, const bigint<bw6_761_Fq::num_limbs> &loop_count);
+/* the lines of both Miller loops: f_{u+1,Q}, then f_{u^2-u-1,[u]Q} */
+bw6_761_ate_G2_precomp bw6_761_ate_precompute_G2(const bw6_761_G2& Q);
 
 bw6_761_Fq6 bw6_761_ate_miller_loop(const bw6_761_ate_G1_precomp &prec_P,
-                              const bw6_761_ate_G2_precomp &prec_Q_1,
-                              const bw6_761_ate_G2_precomp &prec_Q_2);
-/*
+                              const bw6_761_ate_G2_precomp &prec_Q);
 bw6_761_Fq6 bw6_761_ate_double_miller_loop(const bw6_761_ate_G1_precomp &prec_P1,
                                      const bw6_761_ate_G2_precomp &prec_Q1,
                                      const bw6_761_ate_G1_precomp &prec_P2,
                                      const bw6_761_ate_G2_precomp &prec_Q2);
-*/
+
+/* product of the Miller loops of all pairs (prec_P[i], prec_Q[i]) */
+bw6_761_Fq6 bw6_761_ate_multi_miller_loop(const std::vector<bw6_761_ate_G1_precomp> &prec_P,
+                                    const std::vector<bw6_761_ate_G2_precomp> &prec_Q);
 
 bw6_761_Fq6 bw6_761_ate_pairing(const bw6_761_G1& P,
                           const bw6_761_G2 &Q);
@@ -69,18 +73,17 @@ typedef bw6_761_ate_G2_precomp bw6_761_G2_precomp;
 
 bw6_761_G1_precomp bw6_761_precompute_G1(const bw6_761_G1& P);
 
-bw6_761_G2_precomp bw6_761_precompute_G2(const bw6_761_G2& Q, const bigint<bw6_761_Fq::num_limbs> &loop_count);
+bw6_761_G2_precomp bw6_761_precompute_G2(const bw6_761_G2& Q);
 
 bw6_761_Fq6 bw6_761_miller_loop(const bw6_761_G1_precomp &prec_P,
-                          const bw6_761_G2_precomp &prec_Q_1,
-                          const bw6_761_G2_precomp &prec_Q_2);
+                          const bw6_761_G2_precomp &prec_Q);
 
-/*
 bw6_761_Fq6 bw6_761_double_miller_loop(const bw6_761_G1_precomp &prec_P1,
                                  const bw6_761_G2_precomp &prec_Q1,
                                  const bw6_761_G1_precomp &prec_P2,
                                  const bw6_761_G2_precomp &prec_Q2);
-*/
+bw6_761_Fq6 bw6_761_multi_miller_loop(const std::vector<bw6_761_G1_precomp> &prec_P,
+                                const std::vector<bw6_761_G2_precomp> &prec_Q);
 
 bw6_761_Fq6 bw6_761_pairing(const bw6_761_G1& P,
                       const bw6_761_G2 &Q);
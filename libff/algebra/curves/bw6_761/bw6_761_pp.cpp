@@ -17,16 +17,29 @@ bw6_761_G1_precomp bw6_761_pp::precompute_G1(const bw6_761_G1 &P)
     return bw6_761_precompute_G1(P);
 }
 
-bw6_761_G2_precomp bw6_761_pp::precompute_G2(const bw6_761_G2& Q, const bigint<bw6_761_Fq::num_limbs> &loop_count)
+bw6_761_G2_precomp bw6_761_pp::precompute_G2(const bw6_761_G2& Q)
 {
-    return bw6_761_precompute_G2(Q, loop_count);
+    return bw6_761_precompute_G2(Q);
 }
 
 bw6_761_Fq6 bw6_761_pp::miller_loop(const bw6_761_G1_precomp &prec_P,
-                              const bw6_761_G2_precomp &prec_Q_1,
-                              const bw6_761_G2_precomp &prec_Q_2)
+                              const bw6_761_G2_precomp &prec_Q)
 {
-    return bw6_761_miller_loop(prec_P, prec_Q_1, prec_Q_2);
+    return bw6_761_miller_loop(prec_P, prec_Q);
+}
+
+bw6_761_Fq6 bw6_761_pp::double_miller_loop(const bw6_761_G1_precomp &prec_P1,
+                                     const bw6_761_G2_precomp &prec_Q1,
+                                     const bw6_761_G1_precomp &prec_P2,
+                                     const bw6_761_G2_precomp &prec_Q2)
+{
+    return bw6_761_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
+}
+
+bw6_761_Fq6 bw6_761_pp::multi_miller_loop(const std::vector<bw6_761_G1_precomp> &prec_P,
+                                    const std::vector<bw6_761_G2_precomp> &prec_Q)
+{
+    return bw6_761_multi_miller_loop(prec_P, prec_Q);
 }
 
 /*
@@ -47,14 +60,6 @@ bw6_761_Fq6 bw6_761_pp::affine_ate_miller_loop(const bw6_761_affine_ate_G1_preco
     return bw6_761_affine_ate_miller_loop(prec_P, prec_Q_1, prec_Q_2);
 }
 
-bw6_761_Fq6 bw6_761_pp::double_miller_loop(const bw6_761_G1_precomp &prec_P1,
-                                     const bw6_761_G2_precomp &prec_Q1,
-                                     const bw6_761_G1_precomp &prec_P2,
-                                     const bw6_761_G2_precomp &prec_Q2)
-{
-    return bw6_761_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
-}
-
 bw6_761_Fq6 bw6_761_pp::affine_ate_e_over_e_miller_loop(const bw6_761_affine_ate_G1_precomputation &prec_P1,
                                                   const bw6_761_affine_ate_G2_precomputation &prec_Q1,
                                                   const bw6_761_affine_ate_G1_precomputation &prec_P2,
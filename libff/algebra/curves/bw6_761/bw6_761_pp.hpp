@@ -30,10 +30,15 @@ public:
     static void init_public_params();
     static bw6_761_GT final_exponentiation(const bw6_761_Fq6 &elt);
     static bw6_761_G1_precomp precompute_G1(const bw6_761_G1 &P);
-    static bw6_761_G2_precomp precompute_G2(const bw6_761_G2& Q, const bigint<bw6_761_Fq::num_limbs> &loop_count);
+    static bw6_761_G2_precomp precompute_G2(const bw6_761_G2& Q);
     static bw6_761_Fq6 miller_loop(const bw6_761_G1_precomp &prec_P,
-                                const bw6_761_G2_precomp &prec_Q_1,
-                                const bw6_761_G2_precomp &prec_Q_2);
+                                const bw6_761_G2_precomp &prec_Q);
+    static bw6_761_Fq6 double_miller_loop(const bw6_761_G1_precomp &prec_P1,
+                                       const bw6_761_G2_precomp &prec_Q1,
+                                       const bw6_761_G1_precomp &prec_P2,
+                                       const bw6_761_G2_precomp &prec_Q2);
+    static bw6_761_Fq6 multi_miller_loop(const std::vector<bw6_761_G1_precomp> &prec_P,
+                                      const std::vector<bw6_761_G2_precomp> &prec_Q);
     /*
     static bw6_761_affine_ate_G1_precomputation affine_ate_precompute_G1(const bw6_761_G1 &P);
     static bw6_761_affine_ate_G2_precomputation affine_ate_precompute_G2(const bw6_761_G2 &Q, const bigint<bw6_761_Fq::num_limbs> &loop_count);
@@ -50,10 +55,6 @@ public:
                                                             const bw6_761_affine_ate_G2_precomputation &prec_Q2,
                                                             const bw6_761_affine_ate_G1_precomputation &prec_P3,
                                                             const bw6_761_affine_ate_G2_precomputation &prec_Q3);
-    static bw6_761_Fq6 double_miller_loop(const bw6_761_G1_precomp &prec_P1,
-                                       const bw6_761_G2_precomp &prec_Q1,
-                                       const bw6_761_G1_precomp &prec_P2,
-                                       const bw6_761_G2_precomp &prec_Q2);
     */
 
     /* the following are used in test files */
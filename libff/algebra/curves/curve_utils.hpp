@@ -16,6 +16,11 @@ namespace libff {
 template<typename GroupT, mp_size_t m>
 GroupT scalar_mul(const GroupT &base, const bigint<m> &scalar);
 
+/* [scalar1]base1 + [scalar2]base2, sharing the doublings (Shamir's trick) */
+template<typename GroupT, mp_size_t m>
+GroupT double_scalar_mul(const GroupT &base1, const bigint<m> &scalar1,
+                         const GroupT &base2, const bigint<m> &scalar2);
+
 } // libff
 #include <libff/algebra/curves/curve_utils.tcc>
 
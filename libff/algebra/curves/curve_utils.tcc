@@ -33,5 +33,32 @@ GroupT scalar_mul(const GroupT &base, const bigint<m> &scalar)
     return result;
 }
 
+template<typename GroupT, mp_size_t m>
+GroupT double_scalar_mul(const GroupT &base1, const bigint<m> &scalar1,
+                         const GroupT &base2, const bigint<m> &scalar2)
+{
+    const GroupT sum = base1 + base2;
+    GroupT result = GroupT::zero();
+
+    bool found_one = false;
+    for (long i = static_cast<long>(scalar1.max_bits() - 1); i >= 0; --i)
+    {
+        if (found_one)
+        {
+            result = result.dbl();
+        }
+
+        const bool bit1 = scalar1.test_bit(i);
+        const bool bit2 = scalar2.test_bit(i);
+        if (bit1 || bit2)
+        {
+            found_one = true;
+            result = result + (bit1 && bit2 ? sum : (bit1 ? base1 : base2));
+        }
+    }
+
+    return result;
+}
+
 } // libff
 #endif // CURVE_UTILS_TCC_
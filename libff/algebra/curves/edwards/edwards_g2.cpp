@@ -10,8 +10,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long edwards_G2::add_cnt = 0;
-long long edwards_G2::dbl_cnt = 0;
+op_counter edwards_G2::add_cnt("edwards_G2::add");
+op_counter edwards_G2::dbl_cnt("edwards_G2::dbl");
 #endif
 
 std::vector<size_t> edwards_G2::wnaf_window_table;
@@ -39,6 +39,11 @@ void init_edwards_params()
     typedef bigint<edwards_r_limbs> bigint_r;
     typedef bigint<edwards_q_limbs> bigint_q;
 
+#ifdef PROFILE_OP_COUNTS
+    edwards_Fr::name_op_counters("edwards_Fr");
+    edwards_Fq::name_op_counters("edwards_Fq");
+#endif
+
     assert(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
 
     /* parameters for scalar field Fr */
@@ -11,6 +11,7 @@
 #include <libff/algebra/curves/edwards/edwards_g2.hpp>
 #include <libff/algebra/curves/edwards/edwards_init.hpp>
 #include <libff/algebra/curves/edwards/edwards_pairing.hpp>
+#include <libff/common/memory_accounting.hpp>
 #include <libff/common/profiling.hpp>
 
 namespace libff {
@@ -143,6 +144,8 @@ std::istream& operator>>(std::istream& in, edwards_ate_G2_precomp &prec_Q)
         prec_Q.emplace_back(cc);
     }
 
+    prec_Q.coeffs_mem.set(prec_Q.capacity() * sizeof(edwards_Fq3_conic_coefficients));
+
     return in;
 }
 
@@ -621,6 +624,8 @@ edwards_ate_G2_precomp edwards_ate_precompute_G2(const edwards_G2& Q)
         }
     }
 
+    result.coeffs_mem.set(result.capacity() * sizeof(edwards_Fq3_conic_coefficients));
+
     leave_block("Call to edwards_ate_precompute_G2");
     return result;
 }
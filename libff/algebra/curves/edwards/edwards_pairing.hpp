@@ -10,6 +10,7 @@
 #include <vector>
 
 #include <libff/algebra/curves/edwards/edwards_init.hpp>
+#include <libff/common/memory_accounting.hpp>
 
 namespace libff {
 
@@ -67,7 +68,10 @@ struct edwards_Fq3_conic_coefficients {
     friend std::ostream& operator<<(std::ostream &out, const edwards_Fq3_conic_coefficients &cc);
     friend std::istream& operator>>(std::istream &in, edwards_Fq3_conic_coefficients &cc);
 };
-typedef std::vector<edwards_Fq3_conic_coefficients> edwards_ate_G2_precomp;
+/* still a std::vector of the coefficients, which it accounts for its lifetime */
+struct edwards_ate_G2_precomp : public std::vector<edwards_Fq3_conic_coefficients> {
+    mem_charge<mem_tag_pairing_precomp> coeffs_mem;
+};
 
 std::ostream& operator<<(std::ostream& out, const edwards_ate_G2_precomp &prec_Q);
 std::istream& operator>>(std::istream& in, edwards_ate_G2_precomp &prec_Q);
@@ -0,0 +1,99 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of the file mapping used by the flat layout of G2
+ precomputations.
+
+ See flat_precomp.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+
+#include <libff/algebra/curves/flat_precomp.hpp>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace libff {
+
+std::shared_ptr<void> allocate_aligned_buffer(const size_t size)
+{
+    void *p = nullptr;
+#ifdef _WIN32
+    p = _aligned_malloc(size == 0 ? 1 : size, flat_G2_precomp_alignment);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return std::shared_ptr<void>(p, [](void *q) { _aligned_free(q); });
+#else
+    if (posix_memalign(&p, flat_G2_precomp_alignment, size == 0 ? 1 : size) != 0)
+    {
+        throw std::bad_alloc();
+    }
+    return std::shared_ptr<void>(p, [](void *q) { std::free(q); });
+#endif
+}
+
+std::shared_ptr<const void> map_file_readonly(const std::string &path, size_t &size)
+{
+#ifndef _WIN32
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::runtime_error("cannot open " + path);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        throw std::runtime_error("cannot stat " + path);
+    }
+    size = st.st_size;
+    if (size == 0)
+    {
+        close(fd);
+        return allocate_aligned_buffer(0);
+    }
+
+    void *p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    /* the mapping stays valid after the descriptor is closed */
+    close(fd);
+    if (p == MAP_FAILED)
+    {
+        throw std::runtime_error("cannot map " + path);
+    }
+
+    const size_t mapped_size = size;
+    return std::shared_ptr<const void>(p, [mapped_size](const void *q) { munmap(const_cast<void*>(q), mapped_size); });
+#else
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in)
+    {
+        throw std::runtime_error("cannot open " + path);
+    }
+    size = in.tellg();
+    in.seekg(0);
+    const std::shared_ptr<void> buffer = allocate_aligned_buffer(size);
+    if (!in.read((char*) buffer.get(), size))
+    {
+        throw std::runtime_error("cannot read " + path);
+    }
+    return buffer;
+#endif
+}
+
+} // libff
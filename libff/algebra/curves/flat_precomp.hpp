@@ -0,0 +1,159 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of a flat, fixed-size layout for G2 precomputations of the ate
+ pairing, and of a process-wide cache of G2 precomputations.
+
+ In the flat layout every precomputation of a curve takes the same number of
+ bytes: the coordinates of the point, then its line coefficients, both in
+ their in-memory (Montgomery) representation, padded to 64-byte cache lines.
+ A file of such records, written once for e.g. the G2 points of a
+ verification key, is used in place: map_flat_G2_precomps memory-maps it and
+ returns G2_precomp_views whose coefficients are read directly from the
+ mapping (see precomp_coeffs.hpp), without parsing or copying. The curve's
+ Miller loops accept these views in place of G2 precomputations. The mapping
+ is released when the last of these views is destroyed.
+
+ The layout depends on the limb size and byte order of the machine, which
+ are recorded in the file header together with a hash of the curve's base
+ and scalar field moduli, the number of coefficients and the sizes of the
+ records. The loaders check all of them against the curve before touching a
+ record, so reading a file written for another curve or architecture, or
+ with a corrupt header, throws std::runtime_error.
+
+ Supported are the curves whose G2 precomputation is a point and one array
+ of line coefficients: alt_bn128, bls12_377, bls12_381, bw12_446 and bn128.
+ For bn128, whose ate-pairing library reads the coefficients from a
+ std::vector, a view is a G2 precomputation and the coefficients are copied
+ out of the mapping instead.
+
+ cached_precompute_G2 returns a view of the precomputation of a point,
+ computing it on first use and sharing it afterwards; views loaded from a
+ file can be added to the cache up front with add_to_G2_precomp_cache.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef FLAT_PRECOMP_HPP_
+#define FLAT_PRECOMP_HPP_
+
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libff/algebra/curves/precomp_coeffs.hpp>
+#include <libff/algebra/fields/bigint.hpp>
+#include <libff/algebra/curves/public_params.hpp>
+
+namespace libff {
+
+/**
+ * How a G2 precomputation is laid out flat: the "head" is the point (in the
+ * representation stored in the precomputation), followed by the
+ * coefficients. Works for precomputations with members QX, QY and coeffs;
+ * other layouts specialize it.
+ */
+template<typename PrecompT, typename GroupT>
+struct flat_G2_precomp_traits {
+    typedef decltype(PrecompT::QX) coord_type;
+    typedef typename std::decay<decltype(std::declval<const PrecompT&>().coeffs[0])>::type coeff_type;
+
+    static const size_t head_size = 2 * sizeof(coord_type);
+
+    /* for the precomputation and its view alike */
+    template<typename T>
+    static void write_head(const T &prec, unsigned char *out)
+    {
+        std::memcpy(out, &prec.QX, sizeof(coord_type));
+        std::memcpy(out + sizeof(coord_type), &prec.QY, sizeof(coord_type));
+    }
+
+    template<typename T>
+    static void read_head(T &prec, const unsigned char *in)
+    {
+        std::memcpy(&prec.QX, in, sizeof(coord_type));
+        std::memcpy(&prec.QY, in + sizeof(coord_type), sizeof(coord_type));
+    }
+
+    /* the head of the precomputation of Q, without computing it */
+    static void point_head(const GroupT &Q, unsigned char *out)
+    {
+        GroupT Qcopy(Q);
+        Qcopy.to_affine_coordinates();
+        std::memcpy(out, &Qcopy.X, sizeof(coord_type));
+        std::memcpy(out + sizeof(coord_type), &Qcopy.Y, sizeof(coord_type));
+    }
+};
+
+/* Size of one record of the flat layout. */
+template<typename ppT>
+size_t flat_G2_precomp_record_size(const size_t num_coeffs);
+
+/**
+ * Write the precomputations in the flat layout. All of them must have the
+ * number of coefficients of the curve's precomputations; throws
+ * std::invalid_argument otherwise.
+ */
+template<typename ppT>
+void write_flat_G2_precomps(std::ostream &out, const std::vector<G2_precomp<ppT> > &precomps);
+
+/* A view of the precomputation, which keeps it alive. */
+template<typename ppT>
+G2_precomp_view<ppT> make_G2_precomp_view(const std::shared_ptr<const G2_precomp<ppT> > &prec);
+
+/**
+ * Views whose coefficients point into data (size bytes in the flat layout,
+ * aligned to 64 bytes), which owner keeps alive.
+ */
+template<typename ppT>
+std::vector<G2_precomp_view<ppT> > view_flat_G2_precomps(const void *data, const size_t size,
+                                                    const std::shared_ptr<const void> &owner);
+
+/* Read a stream in the flat layout into one buffer, which the results then share. */
+template<typename ppT>
+std::vector<G2_precomp_view<ppT> > read_flat_G2_precomps(std::istream &in);
+
+/* Memory-map a file in the flat layout (read into memory where mmap is not available). */
+template<typename ppT>
+std::vector<G2_precomp_view<ppT> > map_flat_G2_precomps(const std::string &path);
+
+/**
+ * The precomputation of Q from the process-wide cache of curve ppT,
+ * computing (and caching) it if it is not cached yet. Thread-safe.
+ */
+template<typename ppT>
+std::shared_ptr<const G2_precomp_view<ppT> > cached_precompute_G2(const G2<ppT> &Q);
+
+/* Add views, e.g. from map_flat_G2_precomps, to the cache under their points. */
+template<typename ppT>
+void add_to_G2_precomp_cache(const std::vector<G2_precomp_view<ppT> > &precomps);
+
+/* Maximum number of cached precomputations (default 1024); the oldest are evicted first. */
+template<typename ppT>
+void set_G2_precomp_cache_capacity(const size_t capacity);
+
+template<typename ppT>
+size_t G2_precomp_cache_size();
+
+template<typename ppT>
+void clear_G2_precomp_cache();
+
+/* Contents of a whole file, memory-mapped read-only where possible; throws std::runtime_error. */
+std::shared_ptr<const void> map_file_readonly(const std::string &path, size_t &size);
+
+/* A buffer of the given size, aligned to 64 bytes. */
+std::shared_ptr<void> allocate_aligned_buffer(const size_t size);
+
+} // libff
+
+#include <libff/algebra/curves/flat_precomp.tcc>
+
+#endif // FLAT_PRECOMP_HPP_
@@ -0,0 +1,361 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of the flat layout and the cache of G2 precomputations.
+
+ See flat_precomp.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef FLAT_PRECOMP_TCC_
+#define FLAT_PRECOMP_TCC_
+
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace libff {
+
+struct flat_G2_precomp_header {
+    char magic[8];
+    uint32_t version;
+    /* flat_G2_precomp_byte_order as written by the machine */
+    uint32_t byte_order;
+    /* hash of the base and scalar field moduli, identifies the curve */
+    uint64_t curve_id;
+    uint32_t head_size;
+    uint32_t coeff_size;
+    uint64_t num_coeffs;
+    uint64_t record_size;
+    uint64_t count;
+    uint64_t reserved;
+};
+
+static_assert(sizeof(flat_G2_precomp_header) == 64, "the records must start on a cache line");
+
+const char flat_G2_precomp_magic[8] = { 'l', 'i', 'b', 'f', 'f', 'G', '2', 'P' };
+const uint32_t flat_G2_precomp_version = 2;
+const uint32_t flat_G2_precomp_byte_order = 0x01020304;
+const size_t flat_G2_precomp_alignment = 64;
+
+inline size_t flat_G2_precomp_round_up(const size_t n)
+{
+    return (n + flat_G2_precomp_alignment - 1) / flat_G2_precomp_alignment * flat_G2_precomp_alignment;
+}
+
+template<typename ppT>
+using flat_G2_precomp_traits_for = flat_G2_precomp_traits<G2_precomp<ppT>, G2<ppT> >;
+
+template<typename ppT>
+size_t flat_G2_precomp_record_size(const size_t num_coeffs)
+{
+    typedef flat_G2_precomp_traits_for<ppT> traits;
+    return flat_G2_precomp_round_up(flat_G2_precomp_round_up(traits::head_size) +
+                                    num_coeffs * sizeof(typename traits::coeff_type));
+}
+
+/* FNV-1a over the limbs of a modulus */
+template<mp_size_t n>
+uint64_t flat_G2_precomp_hash(uint64_t h, const bigint<n> &mod)
+{
+    const unsigned char *bytes = (const unsigned char*) mod.data;
+    for (size_t i = 0; i < sizeof(mod.data); ++i)
+    {
+        h = (h ^ bytes[i]) * 0x100000001b3ull;
+    }
+    return h;
+}
+
+template<typename ppT>
+uint64_t flat_G2_precomp_curve_id()
+{
+    return flat_G2_precomp_hash(flat_G2_precomp_hash(0xcbf29ce484222325ull, Fq<ppT>::mod), Fr<ppT>::mod);
+}
+
+/* Number of coefficients of every G2 precomputation of the curve. */
+template<typename ppT>
+size_t flat_G2_precomp_num_coeffs()
+{
+    static const size_t num_coeffs = ppT::precompute_G2(G2<ppT>::one()).coeffs.size();
+    return num_coeffs;
+}
+
+/* The header this curve and machine write, except for the number of coefficients and the record size. */
+template<typename ppT>
+flat_G2_precomp_header flat_G2_precomp_curve_header(const size_t count)
+{
+    typedef flat_G2_precomp_traits_for<ppT> traits;
+    static_assert(std::is_trivially_copyable<typename traits::coeff_type>::value,
+                  "the flat layout stores the coefficients as they are in memory");
+
+    flat_G2_precomp_header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, flat_G2_precomp_magic, sizeof(header.magic));
+    header.version = flat_G2_precomp_version;
+    header.byte_order = flat_G2_precomp_byte_order;
+    header.curve_id = flat_G2_precomp_curve_id<ppT>();
+    header.head_size = traits::head_size;
+    header.coeff_size = sizeof(typename traits::coeff_type);
+    header.count = count;
+    return header;
+}
+
+template<typename ppT>
+flat_G2_precomp_header flat_G2_precomp_expected_header(const size_t count)
+{
+    flat_G2_precomp_header header = flat_G2_precomp_curve_header<ppT>(count);
+    header.num_coeffs = flat_G2_precomp_num_coeffs<ppT>();
+    header.record_size = flat_G2_precomp_record_size<ppT>(header.num_coeffs);
+    return header;
+}
+
+template<typename ppT>
+void write_flat_G2_precomps(std::ostream &out, const std::vector<G2_precomp<ppT> > &precomps)
+{
+    typedef flat_G2_precomp_traits_for<ppT> traits;
+    typedef typename traits::coeff_type coeff_type;
+
+    const flat_G2_precomp_header header = flat_G2_precomp_expected_header<ppT>(precomps.size());
+    const size_t num_coeffs = header.num_coeffs;
+    out.write((const char*) &header, sizeof(header));
+
+    const size_t coeffs_offset = flat_G2_precomp_round_up(traits::head_size);
+    std::vector<unsigned char> record(header.record_size);
+    for (const G2_precomp<ppT> &prec : precomps)
+    {
+        if (prec.coeffs.size() != num_coeffs)
+        {
+            throw std::invalid_argument("write_flat_G2_precomps: not a precomputation of this curve");
+        }
+        std::fill(record.begin(), record.end(), 0);
+        traits::write_head(prec, record.data());
+        if (num_coeffs > 0)
+        {
+            std::memcpy(record.data() + coeffs_offset, &prec.coeffs[0], num_coeffs * sizeof(coeff_type));
+        }
+        out.write((const char*) record.data(), record.size());
+    }
+}
+
+/* Throws std::runtime_error unless the header is the one this curve and machine would write. */
+template<typename ppT>
+void check_flat_G2_precomp_header(const flat_G2_precomp_header &header)
+{
+    /* the curve is identified first, as computing its number of coefficients needs its parameters */
+    const flat_G2_precomp_header expected = flat_G2_precomp_curve_header<ppT>(header.count);
+    if (std::memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+        header.version != expected.version)
+    {
+        throw std::runtime_error("flat G2 precomputations: not a file of precomputations");
+    }
+    if (header.byte_order != expected.byte_order ||
+        header.curve_id != expected.curve_id ||
+        header.head_size != expected.head_size ||
+        header.coeff_size != expected.coeff_size)
+    {
+        throw std::runtime_error("flat G2 precomputations: written for another curve or architecture");
+    }
+    /* the number of coefficients is the curve's, not the file's, so records cannot be shorter than the Miller loop reads */
+    const size_t num_coeffs = flat_G2_precomp_num_coeffs<ppT>();
+    if (header.num_coeffs != num_coeffs ||
+        header.record_size != flat_G2_precomp_record_size<ppT>(num_coeffs))
+    {
+        throw std::runtime_error("flat G2 precomputations: records do not match the curve's precomputations");
+    }
+}
+
+template<typename ppT>
+G2_precomp_view<ppT> make_G2_precomp_view(const std::shared_ptr<const G2_precomp<ppT> > &prec)
+{
+    typedef flat_G2_precomp_traits_for<ppT> traits;
+    unsigned char head[traits::head_size];
+    traits::write_head(*prec, head);
+
+    G2_precomp_view<ppT> result;
+    traits::read_head(result, head);
+    attach_precomp_coeffs(result.coeffs, prec->coeffs.data(), prec->coeffs.size(), prec);
+    return result;
+}
+
+template<typename ppT>
+std::vector<G2_precomp_view<ppT> > view_flat_G2_precomps(const void *data, const size_t size,
+                                                         const std::shared_ptr<const void> &owner)
+{
+    typedef flat_G2_precomp_traits_for<ppT> traits;
+    typedef typename traits::coeff_type coeff_type;
+
+    if (size < sizeof(flat_G2_precomp_header))
+    {
+        throw std::runtime_error("flat G2 precomputations: truncated header");
+    }
+    if ((uintptr_t) data % flat_G2_precomp_alignment != 0)
+    {
+        throw std::runtime_error("flat G2 precomputations: buffer is not aligned to 64 bytes");
+    }
+
+    flat_G2_precomp_header header;
+    std::memcpy(&header, data, sizeof(header));
+    check_flat_G2_precomp_header<ppT>(header);
+    if ((size - sizeof(header)) / header.record_size < header.count)
+    {
+        throw std::runtime_error("flat G2 precomputations: truncated records");
+    }
+
+    const unsigned char *records = (const unsigned char*) data + sizeof(header);
+    const size_t coeffs_offset = flat_G2_precomp_round_up(traits::head_size);
+
+    std::vector<G2_precomp_view<ppT> > result(header.count);
+    for (size_t i = 0; i < header.count; ++i)
+    {
+        const unsigned char *record = records + i * header.record_size;
+        traits::read_head(result[i], record);
+        attach_precomp_coeffs(result[i].coeffs, (const coeff_type*) (record + coeffs_offset),
+                              header.num_coeffs, owner);
+    }
+    return result;
+}
+
+template<typename ppT>
+std::vector<G2_precomp_view<ppT> > read_flat_G2_precomps(std::istream &in)
+{
+    flat_G2_precomp_header header;
+    if (!in.read((char*) &header, sizeof(header)))
+    {
+        throw std::runtime_error("flat G2 precomputations: truncated header");
+    }
+
+    check_flat_G2_precomp_header<ppT>(header);
+    if (header.count > (std::numeric_limits<size_t>::max() - sizeof(header)) / header.record_size)
+    {
+        throw std::runtime_error("flat G2 precomputations: too many records");
+    }
+
+    const size_t size = sizeof(header) + header.count * header.record_size;
+    const std::shared_ptr<void> buffer = allocate_aligned_buffer(size);
+    std::memcpy(buffer.get(), &header, sizeof(header));
+    if (!in.read((char*) buffer.get() + sizeof(header), size - sizeof(header)))
+    {
+        throw std::runtime_error("flat G2 precomputations: truncated records");
+    }
+
+    return view_flat_G2_precomps<ppT>(buffer.get(), size, buffer);
+}
+
+template<typename ppT>
+std::vector<G2_precomp_view<ppT> > map_flat_G2_precomps(const std::string &path)
+{
+    size_t size;
+    const std::shared_ptr<const void> mapping = map_file_readonly(path, size);
+    return view_flat_G2_precomps<ppT>(mapping.get(), size, mapping);
+}
+
+template<typename ppT>
+struct G2_precomp_cache_state {
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<const G2_precomp_view<ppT> > > entries;
+    /* keys in the order they were added, for eviction */
+    std::deque<std::string> order;
+    size_t capacity = 1024;
+
+    void insert(const std::string &key, const std::shared_ptr<const G2_precomp_view<ppT> > &prec)
+    {
+        if (capacity == 0 || !entries.emplace(key, prec).second)
+        {
+            return;
+        }
+        order.emplace_back(key);
+        while (entries.size() > capacity)
+        {
+            entries.erase(order.front());
+            order.pop_front();
+        }
+    }
+};
+
+template<typename ppT>
+G2_precomp_cache_state<ppT>& G2_precomp_cache()
+{
+    static G2_precomp_cache_state<ppT> state;
+    return state;
+}
+
+template<typename ppT>
+std::shared_ptr<const G2_precomp_view<ppT> > cached_precompute_G2(const G2<ppT> &Q)
+{
+    typedef flat_G2_precomp_traits_for<ppT> traits;
+    std::string key(traits::head_size, '\0');
+    traits::point_head(Q, (unsigned char*) &key[0]);
+
+    G2_precomp_cache_state<ppT> &cache = G2_precomp_cache<ppT>();
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        const auto it = cache.entries.find(key);
+        if (it != cache.entries.end())
+        {
+            return it->second;
+        }
+    }
+
+    /* computed without holding the lock; if two threads race, both results are equal */
+    const std::shared_ptr<const G2_precomp_view<ppT> > prec = std::make_shared<const G2_precomp_view<ppT> >(
+        make_G2_precomp_view<ppT>(std::make_shared<const G2_precomp<ppT> >(ppT::precompute_G2(Q))));
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.insert(key, prec);
+    return prec;
+}
+
+template<typename ppT>
+void add_to_G2_precomp_cache(const std::vector<G2_precomp_view<ppT> > &precomps)
+{
+    typedef flat_G2_precomp_traits_for<ppT> traits;
+    G2_precomp_cache_state<ppT> &cache = G2_precomp_cache<ppT>();
+    for (const G2_precomp_view<ppT> &prec : precomps)
+    {
+        std::string key(traits::head_size, '\0');
+        traits::write_head(prec, (unsigned char*) &key[0]);
+        const std::shared_ptr<const G2_precomp_view<ppT> > shared = std::make_shared<const G2_precomp_view<ppT> >(prec);
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        cache.insert(key, shared);
+    }
+}
+
+template<typename ppT>
+void set_G2_precomp_cache_capacity(const size_t capacity)
+{
+    G2_precomp_cache_state<ppT> &cache = G2_precomp_cache<ppT>();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.capacity = capacity;
+    while (cache.entries.size() > capacity)
+    {
+        cache.entries.erase(cache.order.front());
+        cache.order.pop_front();
+    }
+}
+
+template<typename ppT>
+size_t G2_precomp_cache_size()
+{
+    G2_precomp_cache_state<ppT> &cache = G2_precomp_cache<ppT>();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    return cache.entries.size();
+}
+
+template<typename ppT>
+void clear_G2_precomp_cache()
+{
+    G2_precomp_cache_state<ppT> &cache = G2_precomp_cache<ppT>();
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    cache.entries.clear();
+    cache.order.clear();
+}
+
+} // libff
+
+#endif // FLAT_PRECOMP_TCC_
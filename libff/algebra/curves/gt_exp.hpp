@@ -0,0 +1,72 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of exponentiation and multi-exponentiation in the target group
+ GT of a pairing, using the Frobenius map.
+
+ On GT, which has prime order r, the p-th power Frobenius map acts as
+ exponentiation by lambda = p mod r: g^p = g^lambda. Writing the exponent in
+ base |lambda| (or |lambda - r| when that is shorter),
+
+   e = e_0 + e_1 * lambda + ... + e_{d-1} * lambda^{d-1},
+
+ turns g^e into a product of d powers of the conjugates of g under the
+ Frobenius map, with exponents about d times shorter. For BLS12 curves
+ lambda is the curve parameter u, so d = 4 and the e_i have 64 bits; for BN
+ curves lambda = 6u^2 and d = 2. The d powers are computed together by
+ interleaved wNAF exponentiation, which shares the squarings between them;
+ the squarings are cyclotomic squarings and inverses are conjugations.
+
+ GT_multi_exp computes products of powers, decomposing every exponent the
+ same way.
+
+ The bases must be in GT, e.g. results of reduced_pairing; the result for
+ other elements of Fqk is meaningless.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef GT_EXP_HPP_
+#define GT_EXP_HPP_
+
+#include <vector>
+
+#include <libff/algebra/curves/public_params.hpp>
+#include <libff/algebra/fields/bigint.hpp>
+
+namespace libff {
+
+template<typename ppT>
+struct GT_frobenius_decomposition {
+    /* |lambda| with g^p = g^lambda on GT, i.e. lambda = p mod r or lambda = (p mod r) - r */
+    bigint<Fr<ppT>::num_limbs> base;
+    /* whether lambda is negative, i.e. g^base is the conjugate of g^p */
+    bool negative;
+    /* number of digits of an exponent in base |lambda|; 1 means the decomposition is not used */
+    size_t num_digits;
+};
+
+/* The decomposition of curve ppT, computed on first use (after init_public_params). */
+template<typename ppT>
+const GT_frobenius_decomposition<ppT>& GT_frobenius_decomposition_params();
+
+/* The digits of e in base |lambda|, least significant first. */
+template<typename ppT>
+std::vector<bigint<Fr<ppT>::num_limbs> > GT_decompose_exponent(const Fr<ppT> &e);
+
+/* g^e for g in GT. */
+template<typename ppT>
+GT<ppT> GT_exp(const GT<ppT> &g, const Fr<ppT> &e);
+
+/* The product of bases[i]^exponents[i], for bases in GT; uses the executor for many bases. */
+template<typename ppT>
+GT<ppT> GT_multi_exp(const std::vector<GT<ppT> > &bases, const std::vector<Fr<ppT> > &exponents);
+
+} // libff
+
+#include <libff/algebra/curves/gt_exp.tcc>
+
+#endif // GT_EXP_HPP_
@@ -0,0 +1,255 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of exponentiation and multi-exponentiation in GT.
+
+ See gt_exp.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef GT_EXP_TCC_
+#define GT_EXP_TCC_
+
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+#include <stdexcept>
+
+#include <gmp.h>
+
+#include <libff/algebra/scalar_multiplication/wnaf.hpp>
+#include <libff/common/execution.hpp>
+
+namespace libff {
+
+template<typename ppT>
+GT_frobenius_decomposition<ppT> GT_compute_frobenius_decomposition()
+{
+    mpz_t p, r, lambda, power;
+    mpz_init(p);
+    mpz_init(r);
+    mpz_init(lambda);
+    mpz_init(power);
+
+    Fq<ppT>::field_char().to_mpz(p);
+    Fr<ppT>::field_char().to_mpz(r);
+    mpz_mod(lambda, p, r);
+
+    GT_frobenius_decomposition<ppT> result;
+    result.negative = false;
+    /* the shorter of lambda and r - lambda */
+    mpz_mul_2exp(power, lambda, 1);
+    if (mpz_cmp(power, r) > 0)
+    {
+        mpz_sub(lambda, r, lambda);
+        result.negative = true;
+    }
+    result.base = bigint<Fr<ppT>::num_limbs>(lambda);
+
+    result.num_digits = 1;
+    if (mpz_cmp_ui(lambda, 1) > 0)
+    {
+        /* the smallest d with lambda^d >= r */
+        mpz_set(power, lambda);
+        while (mpz_cmp(power, r) < 0)
+        {
+            mpz_mul(power, power, lambda);
+            ++result.num_digits;
+        }
+    }
+
+    mpz_clear(power);
+    mpz_clear(lambda);
+    mpz_clear(r);
+    mpz_clear(p);
+    return result;
+}
+
+template<typename ppT>
+const GT_frobenius_decomposition<ppT>& GT_frobenius_decomposition_params()
+{
+    static const GT_frobenius_decomposition<ppT> params = GT_compute_frobenius_decomposition<ppT>();
+    return params;
+}
+
+template<typename ppT>
+std::vector<bigint<Fr<ppT>::num_limbs> > GT_decompose_exponent(const Fr<ppT> &e)
+{
+    const GT_frobenius_decomposition<ppT> &params = GT_frobenius_decomposition_params<ppT>();
+    if (params.num_digits == 1)
+    {
+        return { e.as_bigint() };
+    }
+
+    mpz_t rest, base, digit;
+    mpz_init(rest);
+    mpz_init(base);
+    mpz_init(digit);
+    e.as_bigint().to_mpz(rest);
+    params.base.to_mpz(base);
+
+    std::vector<bigint<Fr<ppT>::num_limbs> > digits;
+    digits.reserve(params.num_digits);
+    for (size_t i = 0; i < params.num_digits; ++i)
+    {
+        mpz_tdiv_qr(rest, digit, rest, base);
+        digits.emplace_back(bigint<Fr<ppT>::num_limbs>(digit));
+    }
+    assert(mpz_sgn(rest) == 0);
+
+    mpz_clear(digit);
+    mpz_clear(base);
+    mpz_clear(rest);
+    return digits;
+}
+
+/* g^(lambda^i) on GT, i.e. the i-th Frobenius conjugate of g up to inversion */
+template<typename ppT>
+GT<ppT> GT_frobenius_power(const GT<ppT> &g, const size_t i)
+{
+    const GT<ppT> result = (i == 0 ? g : g.Frobenius_map(i));
+    return (GT_frobenius_decomposition_params<ppT>().negative && i % 2 == 1) ? result.unitary_inverse() : result;
+}
+
+inline size_t GT_exp_window_size(const size_t exponent_bits)
+{
+    if (exponent_bits <= 96)
+    {
+        return 3;
+    }
+    return (exponent_bits <= 192 ? 4 : 5);
+}
+
+/* the product of bases[i]^exponents[i], by interleaved wNAF exponentiation */
+template<typename ppT>
+GT<ppT> GT_interleaved_wnaf_exp(const std::vector<GT<ppT> > &bases,
+                                const std::vector<bigint<Fr<ppT>::num_limbs> > &exponents)
+{
+    assert(bases.size() == exponents.size());
+
+    size_t max_bits = 0;
+    for (const bigint<Fr<ppT>::num_limbs> &e : exponents)
+    {
+        max_bits = std::max(max_bits, e.num_bits());
+    }
+    const size_t window = GT_exp_window_size(max_bits);
+
+    std::vector<std::vector<long> > wnafs;
+    std::vector<std::vector<GT<ppT> > > tables;
+    wnafs.reserve(bases.size());
+    tables.reserve(bases.size());
+    size_t length = 0;
+    for (size_t i = 0; i < bases.size(); ++i)
+    {
+        if (exponents[i].is_zero())
+        {
+            continue;
+        }
+        std::vector<long> wnaf = find_wnaf(window, exponents[i]);
+        while (!wnaf.empty() && wnaf.back() == 0)
+        {
+            wnaf.pop_back();
+        }
+        length = std::max(length, wnaf.size());
+        wnafs.emplace_back(std::move(wnaf));
+
+        /* odd powers bases[i]^1, bases[i]^3, ..., bases[i]^(2^window - 1) */
+        std::vector<GT<ppT> > table(1ul << (window - 1));
+        table[0] = bases[i];
+        const GT<ppT> square = bases[i].cyclotomic_squared();
+        for (size_t j = 1; j < table.size(); ++j)
+        {
+            table[j] = table[j-1] * square;
+        }
+        tables.emplace_back(std::move(table));
+    }
+
+    GT<ppT> result = GT<ppT>::one();
+    bool found_nonzero = false;
+    for (long j = length - 1; j >= 0; --j)
+    {
+        if (found_nonzero)
+        {
+            result = result.cyclotomic_squared();
+        }
+
+        for (size_t i = 0; i < wnafs.size(); ++i)
+        {
+            if ((size_t) j >= wnafs[i].size() || wnafs[i][j] == 0)
+            {
+                continue;
+            }
+            const long digit = wnafs[i][j];
+            const GT<ppT> &power = tables[i][(std::abs(digit) - 1) / 2];
+            result = result * (digit > 0 ? power : power.unitary_inverse());
+            found_nonzero = true;
+        }
+    }
+
+    return result;
+}
+
+template<typename ppT>
+GT<ppT> GT_exp(const GT<ppT> &g, const Fr<ppT> &e)
+{
+    const std::vector<bigint<Fr<ppT>::num_limbs> > digits = GT_decompose_exponent<ppT>(e);
+
+    std::vector<GT<ppT> > bases;
+    bases.reserve(digits.size());
+    for (size_t i = 0; i < digits.size(); ++i)
+    {
+        bases.emplace_back(GT_frobenius_power<ppT>(g, i));
+    }
+    return GT_interleaved_wnaf_exp<ppT>(bases, digits);
+}
+
+template<typename ppT>
+GT<ppT> GT_multi_exp(const std::vector<GT<ppT> > &bases, const std::vector<Fr<ppT> > &exponents)
+{
+    if (bases.size() != exponents.size())
+    {
+        throw std::invalid_argument("GT_multi_exp: different numbers of bases and exponents");
+    }
+
+    /* below a few bases per worker, splitting the work costs more squarings than it saves */
+    const size_t min_bases_per_chunk = 4;
+    const size_t num_chunks =
+        std::max<size_t>(1, std::min(get_executor()->concurrency(), bases.size() / min_bases_per_chunk));
+
+    std::vector<GT<ppT> > partial(num_chunks, GT<ppT>::one());
+    parallel_for(0, num_chunks, [&](const size_t c) {
+        const size_t begin = bases.size() * c / num_chunks;
+        const size_t end = bases.size() * (c + 1) / num_chunks;
+
+        std::vector<GT<ppT> > chunk_bases;
+        std::vector<bigint<Fr<ppT>::num_limbs> > chunk_exponents;
+        for (size_t i = begin; i < end; ++i)
+        {
+            const std::vector<bigint<Fr<ppT>::num_limbs> > digits = GT_decompose_exponent<ppT>(exponents[i]);
+            for (size_t k = 0; k < digits.size(); ++k)
+            {
+                if (!digits[k].is_zero())
+                {
+                    chunk_bases.emplace_back(GT_frobenius_power<ppT>(bases[i], k));
+                    chunk_exponents.emplace_back(digits[k]);
+                }
+            }
+        }
+        partial[c] = GT_interleaved_wnaf_exp<ppT>(chunk_bases, chunk_exponents);
+    });
+
+    GT<ppT> result = GT<ppT>::one();
+    for (const GT<ppT> &p : partial)
+    {
+        result = result * p;
+    }
+    return result;
+}
+
+} // libff
+
+#endif // GT_EXP_TCC_
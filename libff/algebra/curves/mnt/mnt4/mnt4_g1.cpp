@@ -16,8 +16,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long mnt4_G1::add_cnt = 0;
-long long mnt4_G1::dbl_cnt = 0;
+op_counter mnt4_G1::add_cnt("mnt4_G1::add");
+op_counter mnt4_G1::dbl_cnt("mnt4_G1::dbl");
 #endif
 
 std::vector<size_t> mnt4_G1::wnaf_window_table;
@@ -172,6 +172,9 @@ mnt4_G1 mnt4_G1::operator+(const mnt4_G1 &other) const
     if (X1Z2 == X2Z1 && Y1Z2 == Y2Z1)
     {
         // perform dbl case
+#ifdef PROFILE_OP_COUNTS
+        this->dbl_cnt++;
+#endif
         const mnt4_Fq XX   = (this->X_).squared();                   // XX  = X1^2
         const mnt4_Fq ZZ   = (this->Z_).squared();                   // ZZ  = Z1^2
         const mnt4_Fq w    = mnt4_G1::coeff_a * ZZ + (XX + XX + XX); // w   = a*ZZ + 3*XX
@@ -191,6 +194,9 @@ mnt4_G1 mnt4_G1::operator+(const mnt4_G1 &other) const
     }
 
     // if we have arrived here we are in the add case
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
     const mnt4_Fq Z1Z2 = (this->Z_) * (other.Z_);        // Z1Z2 = Z1*Z2
     const mnt4_Fq u    = Y2Z1 - Y1Z2; // u    = Y2*Z1-Y1Z2
     const mnt4_Fq uu   = u.squared();                  // uu   = u^2
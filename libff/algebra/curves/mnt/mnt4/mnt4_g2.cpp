@@ -16,8 +16,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long mnt4_G2::add_cnt = 0;
-long long mnt4_G2::dbl_cnt = 0;
+op_counter mnt4_G2::add_cnt("mnt4_G2::add");
+op_counter mnt4_G2::dbl_cnt("mnt4_G2::dbl");
 #endif
 
 std::vector<size_t> mnt4_G2::wnaf_window_table;
@@ -188,6 +188,9 @@ mnt4_G2 mnt4_G2::operator+(const mnt4_G2 &other) const
     if (X1Z2 == X2Z1 && Y1Z2 == Y2Z1)
     {
         // perform dbl case
+#ifdef PROFILE_OP_COUNTS
+        this->dbl_cnt++;
+#endif
         const mnt4_Fq2 XX   = (this->X_).squared();                   // XX  = X1^2
         const mnt4_Fq2 ZZ   = (this->Z_).squared();                   // ZZ  = Z1^2
         const mnt4_Fq2 w    = mnt4_G2::mul_by_a(ZZ) + (XX + XX + XX); // w   = a*ZZ + 3*XX
@@ -207,6 +210,9 @@ mnt4_G2 mnt4_G2::operator+(const mnt4_G2 &other) const
     }
 
     // if we have arrived here we are in the add case
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
     const mnt4_Fq2 Z1Z2 = (this->Z_) * (other.Z_);      // Z1Z2 = Z1*Z2
     const mnt4_Fq2 u    = Y2Z1 - Y1Z2;                  // u    = Y2*Z1-Y1Z2
     const mnt4_Fq2 uu   = u.squared();                  // uu   = u^2
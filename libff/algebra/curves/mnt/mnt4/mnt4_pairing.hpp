@@ -15,6 +15,7 @@
 #include <vector>
 
 #include <libff/algebra/curves/mnt/mnt4/mnt4_init.hpp>
+#include <libff/common/memory_accounting.hpp>
 
 namespace libff {
 
@@ -96,6 +97,7 @@ struct mnt4_ate_G2_precomp {
     mnt4_Fq2 QY_over_twist;
     std::vector<mnt4_ate_dbl_coeffs> dbl_coeffs;
     std::vector<mnt4_ate_add_coeffs> add_coeffs;
+    mem_charge<mem_tag_pairing_precomp> coeffs_mem;
 
     bool operator==(const mnt4_ate_G2_precomp &other) const;
     friend std::ostream& operator<<(std::ostream &out, const mnt4_ate_G2_precomp &prec_Q);
@@ -112,6 +114,21 @@ mnt4_Fq4 mnt4_ate_double_miller_loop(const mnt4_ate_G1_precomp &prec_P1,
                                            const mnt4_ate_G1_precomp &prec_P2,
                                            const mnt4_ate_G2_precomp &prec_Q2);
 
+/**
+ * The Miller loop of mnt4_ate_miller_loop for a G2 point that is not
+ * precomputed: the doubling and addition steps run in projective coordinates
+ * alongside the loop, and each line is evaluated at P as soon as it is
+ * computed, so no coefficients are stored. Its result equals that of the
+ * precomputed loop.
+ *
+ * The pairing of two points (mnt4_ate_pairing, mnt4_pairing, mnt4_reduced_pairing)
+ * uses this loop; miller_loop and double_miller_loop use the coefficients of
+ * G2 precomputations, which pay off when a G2 point takes part in several
+ * pairings.
+ */
+mnt4_Fq4 mnt4_ate_streaming_miller_loop(const mnt4_ate_G1_precomp &prec_P,
+                                       const mnt4_G2 &Q);
+
 mnt4_Fq4 mnt4_ate_pairing(const mnt4_G1& P,
                           const mnt4_G2 &Q);
 mnt4_GT mnt4_ate_reduced_pairing(const mnt4_G1 &P,
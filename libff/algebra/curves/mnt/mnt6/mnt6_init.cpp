@@ -42,6 +42,11 @@ void init_mnt6_params()
     typedef bigint<mnt6_r_limbs> bigint_r;
     typedef bigint<mnt6_q_limbs> bigint_q;
 
+#ifdef PROFILE_OP_COUNTS
+    mnt6_Fr::name_op_counters("mnt6_Fr");
+    mnt6_Fq::name_op_counters("mnt6_Fq");
+#endif
+
     assert(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
 
     /* parameters for scalar field Fr */
@@ -15,6 +15,7 @@
 #include <vector>
 
 #include <libff/algebra/curves/mnt/mnt6/mnt6_init.hpp>
+#include <libff/common/memory_accounting.hpp>
 
 namespace libff {
 
@@ -96,6 +97,7 @@ struct mnt6_ate_G2_precomp {
     mnt6_Fq3 QY_over_twist;
     std::vector<mnt6_ate_dbl_coeffs> dbl_coeffs;
     std::vector<mnt6_ate_add_coeffs> add_coeffs;
+    mem_charge<mem_tag_pairing_precomp> coeffs_mem;
 
     bool operator==(const mnt6_ate_G2_precomp &other) const;
     friend std::ostream& operator<<(std::ostream &out, const mnt6_ate_G2_precomp &prec_Q);
@@ -112,6 +114,21 @@ mnt6_Fq6 mnt6_ate_double_miller_loop(const mnt6_ate_G1_precomp &prec_P1,
                                      const mnt6_ate_G1_precomp &prec_P2,
                                      const mnt6_ate_G2_precomp &prec_Q2);
 
+/**
+ * The Miller loop of mnt6_ate_miller_loop for a G2 point that is not
+ * precomputed: the doubling and addition steps run in projective coordinates
+ * alongside the loop, and each line is evaluated at P as soon as it is
+ * computed, so no coefficients are stored. Its result equals that of the
+ * precomputed loop.
+ *
+ * The pairing of two points (mnt6_ate_pairing, mnt6_pairing, mnt6_reduced_pairing)
+ * uses this loop; miller_loop and double_miller_loop use the coefficients of
+ * G2 precomputations, which pay off when a G2 point takes part in several
+ * pairings.
+ */
+mnt6_Fq6 mnt6_ate_streaming_miller_loop(const mnt6_ate_G1_precomp &prec_P,
+                                       const mnt6_G2 &Q);
+
 mnt6_Fq6 mnt6_ate_pairing(const mnt6_G1& P,
                           const mnt6_G2 &Q);
 mnt6_GT mnt6_ate_reduced_pairing(const mnt6_G1 &P,
@@ -40,6 +40,11 @@ void init_mnt4753_params()
     typedef bigint<mnt4753_r_limbs> bigint_r;
     typedef bigint<mnt4753_q_limbs> bigint_q;
 
+#ifdef PROFILE_OP_COUNTS
+    mnt4753_Fr::name_op_counters("mnt4753_Fr");
+    mnt4753_Fq::name_op_counters("mnt4753_Fq");
+#endif
+
     assert(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
 
     /* parameters for scalar field Fr */
@@ -3,8 +3,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long mnt6753_G2::add_cnt = 0;
-long long mnt6753_G2::dbl_cnt = 0;
+op_counter mnt6753_G2::add_cnt("mnt6753_G2::add");
+op_counter mnt6753_G2::dbl_cnt("mnt6753_G2::dbl");
 #endif
 
 std::vector<size_t> mnt6753_G2::wnaf_window_table;
@@ -181,6 +181,9 @@ mnt6753_G2 mnt6753_G2::operator+(const mnt6753_G2 &other) const
     if (X1Z2 == X2Z1 && Y1Z2 == Y2Z1)
     {
         // perform dbl case
+#ifdef PROFILE_OP_COUNTS
+        this->dbl_cnt++;
+#endif
         const mnt6753_Fq3 XX   = (this->X_).squared();                   // XX  = X1^2
         const mnt6753_Fq3 ZZ   = (this->Z_).squared();                   // ZZ  = Z1^2
         const mnt6753_Fq3 w    = mnt6753_G2::mul_by_a(ZZ) + (XX + XX + XX); // w   = a*ZZ + 3*XX
@@ -200,6 +203,9 @@ mnt6753_G2 mnt6753_G2::operator+(const mnt6753_G2 &other) const
     }
 
     // if we have arrived here we are in the add case
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
     const mnt6753_Fq3 Z1Z2 = (this->Z_) * (other.Z_);   // Z1Z2 = Z1*Z2
     const mnt6753_Fq3 u    = Y2Z1 - Y1Z2;               // u    = Y2*Z1-Y1Z2
     const mnt6753_Fq3 uu   = u.squared();               // uu   = u^2
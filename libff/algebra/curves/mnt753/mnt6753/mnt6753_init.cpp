@@ -32,6 +32,11 @@ void init_mnt6753_params()
     typedef bigint<mnt6753_r_limbs> bigint_r;
     typedef bigint<mnt6753_q_limbs> bigint_q;
 
+#ifdef PROFILE_OP_COUNTS
+    mnt6753_Fr::name_op_counters("mnt6753_Fr");
+    mnt6753_Fq::name_op_counters("mnt6753_Fq");
+#endif
+
     assert(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
 
     /* parameters for scalar field Fr */
@@ -15,6 +15,7 @@
 #include <libff/algebra/curves/mnt753/mnt6753/mnt6753_init.hpp>
 #include <libff/algebra/curves/mnt753/mnt6753/mnt6753_pairing.hpp>
 #include <libff/algebra/scalar_multiplication/wnaf.hpp>
+#include <libff/common/memory_accounting.hpp>
 #include <libff/common/profiling.hpp>
 
 namespace libff {
@@ -171,6 +172,9 @@ std::istream& operator>>(std::istream& in, mnt6753_ate_G2_precomp &prec_Q)
         prec_Q.add_coeffs.emplace_back(ac);
     }
 
+    prec_Q.coeffs_mem.set(prec_Q.dbl_coeffs.capacity() * sizeof(mnt6753_ate_dbl_coeffs) +
+                          prec_Q.add_coeffs.capacity() * sizeof(mnt6753_ate_add_coeffs));
+
     return in;
 }
 
@@ -538,6 +542,9 @@ mnt6753_ate_G2_precomp mnt6753_ate_precompute_G2(const mnt6753_G2& Q)
         result.add_coeffs.push_back(ac);
     }
 
+    result.coeffs_mem.set(result.dbl_coeffs.capacity() * sizeof(mnt6753_ate_dbl_coeffs) +
+                          result.add_coeffs.capacity() * sizeof(mnt6753_ate_add_coeffs));
+
     leave_block("Call to mnt6753_ate_precompute_G2");
     return result;
 }
@@ -677,12 +684,90 @@ mnt6753_Fq6 mnt6753_ate_double_miller_loop(const mnt6753_ate_G1_precomp &prec_P1
     return f;
 }
 
+mnt6753_Fq6 mnt6753_ate_streaming_miller_loop(const mnt6753_ate_G1_precomp &prec_P,
+                                       const mnt6753_G2 &Q)
+{
+    enter_block("Call to mnt6753_ate_streaming_miller_loop");
+
+    mnt6753_G2 Qcopy(Q);
+    Qcopy.to_affine_coordinates();
+
+    const mnt6753_Fq3 QX = Qcopy.X();
+    const mnt6753_Fq3 QY = Qcopy.Y();
+    const mnt6753_Fq3 QY2 = QY.squared();
+    const mnt6753_Fq3 mnt6753_twist_inv = mnt6753_twist.inverse();
+    const mnt6753_Fq3 QY_over_twist = QY * mnt6753_twist_inv;
+    const mnt6753_Fq3 L1_coeff = mnt6753_Fq3(prec_P.PX, mnt6753_Fq::zero(), mnt6753_Fq::zero()) - QX * mnt6753_twist_inv;
+
+    extended_mnt6753_G2_projective R;
+    R.X = QX;
+    R.Y = QY;
+    R.Z = mnt6753_Fq3::one();
+    R.T = mnt6753_Fq3::one();
+
+    mnt6753_Fq6 f = mnt6753_Fq6::one();
+
+    bool found_one = false;
+
+    const bigint<mnt6753_Fr::num_limbs> &loop_count = mnt6753_ate_loop_count;
+    for (long i = loop_count.max_bits() - 1; i >= 0; --i)
+    {
+        const bool bit = loop_count.test_bit(i);
+
+        if (!found_one)
+        {
+            /* this skips the MSB itself */
+            found_one |= bit;
+            continue;
+        }
+
+        /* the same steps as mnt6753_ate_precompute_G2, whose coefficients are
+           evaluated at P right away instead of being stored */
+        mnt6753_ate_dbl_coeffs dc;
+        doubling_step_for_flipped_miller_loop(R, dc);
+
+        mnt6753_Fq6 g_RR_at_P = mnt6753_Fq6(- dc.c_4C - dc.c_J * prec_P.PX_twist + dc.c_L,
+                                      dc.c_H * prec_P.PY_twist);
+        f = f.squared() * g_RR_at_P;
+
+        if (bit)
+        {
+            mnt6753_ate_add_coeffs ac;
+            mixed_addition_step_for_flipped_miller_loop(QX, QY, QY2, R, ac);
+
+            mnt6753_Fq6 g_RQ_at_P = mnt6753_Fq6(ac.c_RZ * prec_P.PY_twist,
+                                          -(QY_over_twist * ac.c_RZ + L1_coeff * ac.c_L1));
+            f = f * g_RQ_at_P;
+        }
+    }
+
+    if (mnt6753_ate_is_loop_count_neg)
+    {
+        mnt6753_Fq3 RZ_inv = R.Z.inverse();
+        mnt6753_Fq3 RZ2_inv = RZ_inv.squared();
+        mnt6753_Fq3 RZ3_inv = RZ2_inv * RZ_inv;
+        mnt6753_Fq3 minus_R_affine_X = R.X * RZ2_inv;
+        mnt6753_Fq3 minus_R_affine_Y = - R.Y * RZ3_inv;
+        mnt6753_Fq3 minus_R_affine_Y2 = minus_R_affine_Y.squared();
+        mnt6753_ate_add_coeffs ac;
+        mixed_addition_step_for_flipped_miller_loop(minus_R_affine_X, minus_R_affine_Y, minus_R_affine_Y2, R, ac);
+
+        mnt6753_Fq6 g_RnegR_at_P = mnt6753_Fq6(ac.c_RZ * prec_P.PY_twist,
+                                         -(QY_over_twist * ac.c_RZ + L1_coeff * ac.c_L1));
+        f = (f * g_RnegR_at_P).inverse();
+    }
+
+    leave_block("Call to mnt6753_ate_streaming_miller_loop");
+
+    return f;
+}
+
 mnt6753_Fq6 mnt6753_ate_pairing(const mnt6753_G1& P, const mnt6753_G2 &Q)
 {
     enter_block("Call to mnt6753_ate_pairing");
     mnt6753_ate_G1_precomp prec_P = mnt6753_ate_precompute_G1(P);
-    mnt6753_ate_G2_precomp prec_Q = mnt6753_ate_precompute_G2(Q);
-    mnt6753_Fq6 result = mnt6753_ate_miller_loop(prec_P, prec_Q);
+    /* a one-shot pairing does not keep the G2 precomputation, so stream it */
+    mnt6753_Fq6 result = mnt6753_ate_streaming_miller_loop(prec_P, Q);
     leave_block("Call to mnt6753_ate_pairing");
     return result;
 }
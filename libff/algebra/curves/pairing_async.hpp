@@ -0,0 +1,39 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of asynchronous pairing entry points (see async.hpp).
+
+ The overloads taking async_value arguments start once those are ready, e.g.
+ a reduced pairing of the results of a G1 and a G2 multi_exp_async, or a
+ final exponentiation of a Miller loop computed in another task.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef PAIRING_ASYNC_HPP_
+#define PAIRING_ASYNC_HPP_
+
+#include <libff/algebra/curves/public_params.hpp>
+#include <libff/common/async.hpp>
+
+namespace libff {
+
+template<typename ppT>
+async_value<GT<ppT> > reduced_pairing_async(const G1<ppT> &P, const G2<ppT> &Q);
+
+template<typename ppT>
+async_value<GT<ppT> > reduced_pairing_async(const async_value<G1<ppT> > &P, const async_value<G2<ppT> > &Q);
+
+template<typename ppT>
+async_value<GT<ppT> > final_exponentiation_async(const Fqk<ppT> &f);
+
+template<typename ppT>
+async_value<GT<ppT> > final_exponentiation_async(const async_value<Fqk<ppT> > &f);
+
+} // libff
+#include <libff/algebra/curves/pairing_async.tcc>
+
+#endif // PAIRING_ASYNC_HPP_
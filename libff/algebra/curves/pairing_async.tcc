@@ -0,0 +1,47 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of asynchronous pairing entry points.
+
+ See pairing_async.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef PAIRING_ASYNC_TCC_
+#define PAIRING_ASYNC_TCC_
+
+namespace libff {
+
+template<typename ppT>
+async_value<GT<ppT> > reduced_pairing_async(const G1<ppT> &P, const G2<ppT> &Q)
+{
+    return async_submit([P, Q]() -> GT<ppT> { return ppT::reduced_pairing(P, Q); });
+}
+
+template<typename ppT>
+async_value<GT<ppT> > reduced_pairing_async(const async_value<G1<ppT> > &P, const async_value<G2<ppT> > &Q)
+{
+    return async_submit([P, Q]() -> GT<ppT> { return ppT::reduced_pairing(P.get(), Q.get()); },
+                        { P, Q });
+}
+
+template<typename ppT>
+async_value<GT<ppT> > final_exponentiation_async(const Fqk<ppT> &f)
+{
+    return async_submit([f]() -> GT<ppT> { return ppT::final_exponentiation(f); });
+}
+
+template<typename ppT>
+async_value<GT<ppT> > final_exponentiation_async(const async_value<Fqk<ppT> > &f)
+{
+    return async_submit([f]() -> GT<ppT> { return ppT::final_exponentiation(f.get()); },
+                        { f });
+}
+
+} // libff
+
+#endif // PAIRING_ASYNC_TCC_
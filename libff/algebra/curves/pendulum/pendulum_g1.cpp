@@ -3,8 +3,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long pendulum_G1::add_cnt = 0;
-long long pendulum_G1::dbl_cnt = 0;
+op_counter pendulum_G1::add_cnt("pendulum_G1::add");
+op_counter pendulum_G1::dbl_cnt("pendulum_G1::dbl");
 #endif
 
 std::vector<size_t> pendulum_G1::wnaf_window_table;
@@ -159,6 +159,9 @@ pendulum_G1 pendulum_G1::operator+(const pendulum_G1 &other) const
     if (X1Z2 == X2Z1 && Y1Z2 == Y2Z1)
     {
         // perform dbl case
+#ifdef PROFILE_OP_COUNTS
+        this->dbl_cnt++;
+#endif
         const pendulum_Fq XX   = (this->X_).squared();                   // XX  = X1^2
         const pendulum_Fq ZZ   = (this->Z_).squared();                   // ZZ  = Z1^2
         const pendulum_Fq w    = pendulum_G1::coeff_a * ZZ + (XX + XX + XX); // w   = a*ZZ + 3*XX
@@ -178,6 +181,9 @@ pendulum_G1 pendulum_G1::operator+(const pendulum_G1 &other) const
     }
 
     // if we have arrived here we are in the add case
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
     const pendulum_Fq Z1Z2 = (this->Z_) * (other.Z_);      // Z1Z2 = Z1*Z2
     const pendulum_Fq u    = Y2Z1 - Y1Z2;                  // u    = Y2*Z1-Y1Z2
     const pendulum_Fq uu   = u.squared();                  // uu   = u^2
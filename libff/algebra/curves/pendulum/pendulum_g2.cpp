@@ -3,8 +3,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long pendulum_G2::add_cnt = 0;
-long long pendulum_G2::dbl_cnt = 0;
+op_counter pendulum_G2::add_cnt("pendulum_G2::add");
+op_counter pendulum_G2::dbl_cnt("pendulum_G2::dbl");
 #endif
 
 std::vector<size_t> pendulum_G2::wnaf_window_table;
@@ -181,6 +181,9 @@ pendulum_G2 pendulum_G2::operator+(const pendulum_G2 &other) const
     if (X1Z2 == X2Z1 && Y1Z2 == Y2Z1)
     {
         // perform dbl case
+#ifdef PROFILE_OP_COUNTS
+        this->dbl_cnt++;
+#endif
         const pendulum_Fq3 XX   = (this->X_).squared();                   // XX  = X1^2
         const pendulum_Fq3 ZZ   = (this->Z_).squared();                   // ZZ  = Z1^2
         const pendulum_Fq3 w    = pendulum_G2::mul_by_a(ZZ) + (XX + XX + XX); // w   = a*ZZ + 3*XX
@@ -200,6 +203,9 @@ pendulum_G2 pendulum_G2::operator+(const pendulum_G2 &other) const
     }
 
     // if we have arrived here we are in the add case
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
     const pendulum_Fq3 Z1Z2 = (this->Z_) * (other.Z_);   // Z1Z2 = Z1*Z2
     const pendulum_Fq3 u    = Y2Z1 - Y1Z2;               // u    = Y2*Z1-Y1Z2
     const pendulum_Fq3 uu   = u.squared();               // uu   = u^2
@@ -34,6 +34,11 @@ void init_pendulum_params()
     typedef bigint<pendulum_r_limbs> bigint_r;
     typedef bigint<pendulum_q_limbs> bigint_q;
 
+#ifdef PROFILE_OP_COUNTS
+    pendulum_Fr::name_op_counters("pendulum_Fr");
+    pendulum_Fq::name_op_counters("pendulum_Fq");
+#endif
+
     assert(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
 
      /* pendulum Fr parameters */
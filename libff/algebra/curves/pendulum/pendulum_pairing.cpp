@@ -5,6 +5,7 @@
 #include <libff/algebra/curves/pendulum/pendulum_init.hpp>
 #include <libff/algebra/curves/pendulum/pendulum_pairing.hpp>
 #include <libff/algebra/scalar_multiplication/wnaf.hpp>
+#include <libff/common/memory_accounting.hpp>
 #include <libff/common/profiling.hpp>
 
 namespace libff {
@@ -161,6 +162,9 @@ std::istream& operator>>(std::istream& in, pendulum_ate_G2_precomp &prec_Q)
         prec_Q.add_coeffs.emplace_back(ac);
     }
 
+    prec_Q.coeffs_mem.set(prec_Q.dbl_coeffs.capacity() * sizeof(pendulum_ate_dbl_coeffs) +
+                          prec_Q.add_coeffs.capacity() * sizeof(pendulum_ate_add_coeffs));
+
     return in;
 }
 
@@ -534,6 +538,9 @@ pendulum_ate_G2_precomp pendulum_ate_precompute_G2(const pendulum_G2& Q)
         result.add_coeffs.push_back(ac);
     }
 
+    result.coeffs_mem.set(result.dbl_coeffs.capacity() * sizeof(pendulum_ate_dbl_coeffs) +
+                          result.add_coeffs.capacity() * sizeof(pendulum_ate_add_coeffs));
+
     leave_block("Call to pendulum_ate_precompute_G2");
     return result;
 }
@@ -0,0 +1,69 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of a read-only view of the line coefficients of G2
+ precomputations.
+
+ precomp_coeffs_view refers to a contiguous array of coefficients owned by
+ someone else, such as a memory-mapped file of precomputations (see
+ flat_precomp.hpp) or a precomputation held in a std::shared_ptr, and keeps
+ that owner alive. The curves that read their precomputations in place pair
+ it with the point in a G2_precomp_view, which their Miller loops accept in
+ place of a G2_precomp.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef PRECOMP_COEFFS_HPP_
+#define PRECOMP_COEFFS_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace libff {
+
+template<typename T>
+class precomp_coeffs_view {
+private:
+    const T *ptr;
+    size_t num;
+    std::shared_ptr<const void> owner;
+public:
+    typedef T value_type;
+    typedef const T* const_iterator;
+
+    precomp_coeffs_view() : ptr(nullptr), num(0) {}
+    /* the n coefficients at data, which owner keeps alive */
+    precomp_coeffs_view(const T *data, const size_t n, const std::shared_ptr<const void> &owner) :
+        ptr(data), num(n), owner(owner) {}
+
+    size_t size() const { return num; }
+    bool empty() const { return num == 0; }
+    const T* data() const { return ptr; }
+    const T& operator[](const size_t i) const { return ptr[i]; }
+    const_iterator begin() const { return ptr; }
+    const_iterator end() const { return ptr + num; }
+};
+
+/* Point a precomputation's coefficients at the given memory; containers that cannot refer to it get a copy. */
+template<typename T>
+void attach_precomp_coeffs(precomp_coeffs_view<T> &coeffs, const T *data, const size_t n,
+                           const std::shared_ptr<const void> &owner)
+{
+    coeffs = precomp_coeffs_view<T>(data, n, owner);
+}
+
+template<typename T, typename Alloc>
+void attach_precomp_coeffs(std::vector<T, Alloc> &coeffs, const T *data, const size_t n,
+                           const std::shared_ptr<const void> &)
+{
+    coeffs.assign(data, data + n);
+}
+
+} // libff
+
+#endif // PRECOMP_COEFFS_HPP_
@@ -20,6 +20,7 @@ namespace libff {
   G2_type
   G1_precomp_type
   G2_precomp_type
+  G2_precomp_view_type (only curves with flat precomputations, see flat_precomp.hpp)
   affine_ate_G1_precomp_type
   affine_ate_G2_precomp_type
   Fq_type
@@ -79,6 +80,8 @@ using G1_precomp = typename EC_ppT::G1_precomp_type;
 template<typename EC_ppT>
 using G2_precomp = typename EC_ppT::G2_precomp_type;
 template<typename EC_ppT>
+using G2_precomp_view = typename EC_ppT::G2_precomp_view_type;
+template<typename EC_ppT>
 using affine_ate_G1_precomp = typename EC_ppT::affine_ate_G1_precomp_type;
 template<typename EC_ppT>
 using affine_ate_G2_precomp = typename EC_ppT::affine_ate_G2_precomp_type;
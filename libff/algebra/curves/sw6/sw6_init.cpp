@@ -34,6 +34,11 @@ void init_sw6_params()
     typedef bigint<sw6_r_limbs> bigint_r;
     typedef bigint<sw6_q_limbs> bigint_q;
 
+#ifdef PROFILE_OP_COUNTS
+    sw6_Fr::name_op_counters("sw6_Fr");
+    sw6_Fq::name_op_counters("sw6_Fq");
+#endif
+
     assert(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
 
     /* parameters for scalar field Fr */
@@ -18,6 +18,7 @@
 #include <libff/algebra/curves/sw6/sw6_init.hpp>
 #include <libff/algebra/curves/sw6/sw6_pairing.hpp>
 #include <libff/algebra/scalar_multiplication/wnaf.hpp>
+#include <libff/common/memory_accounting.hpp>
 #include <libff/common/profiling.hpp>
 
 namespace libff {
@@ -174,6 +175,9 @@ std::istream& operator>>(std::istream& in, sw6_ate_G2_precomp &prec_Q)
         prec_Q.add_coeffs.emplace_back(ac);
     }
 
+    prec_Q.coeffs_mem.set(prec_Q.dbl_coeffs.capacity() * sizeof(sw6_ate_dbl_coeffs) +
+                          prec_Q.add_coeffs.capacity() * sizeof(sw6_ate_add_coeffs));
+
     return in;
 }
 
@@ -546,6 +550,9 @@ sw6_ate_G2_precomp sw6_ate_precompute_G2(const sw6_G2& Q)
         result.add_coeffs.push_back(ac);
     }
 
+    result.coeffs_mem.set(result.dbl_coeffs.capacity() * sizeof(sw6_ate_dbl_coeffs) +
+                          result.add_coeffs.capacity() * sizeof(sw6_ate_add_coeffs));
+
     leave_block("Call to sw6_ate_precompute_G2");
     return result;
 }
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include <libff/algebra/curves/sw6/sw6_init.hpp>
+#include <libff/common/memory_accounting.hpp>
 
 namespace libff {
 
@@ -85,6 +86,7 @@ struct sw6_ate_G2_precomp {
     sw6_Fq3 QY_over_twist;
     std::vector<sw6_ate_dbl_coeffs> dbl_coeffs;
     std::vector<sw6_ate_add_coeffs> add_coeffs;
+    mem_charge<mem_tag_pairing_precomp> coeffs_mem;
 
     bool operator==(const sw6_ate_G2_precomp &other) const;
     friend std::ostream& operator<<(std::ostream &out, const sw6_ate_G2_precomp &prec_Q);
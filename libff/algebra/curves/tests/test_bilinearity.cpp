@@ -9,6 +9,12 @@
 #include <libff/algebra/curves/bw6_761/bw6_761_pp.hpp>
 #include <libff/algebra/curves/pendulum/pendulum_pp.hpp>
 #include <libff/algebra/curves/edwards/edwards_pp.hpp>
+#include <libff/algebra/curves/batch_verify.hpp>
+#include <libff/algebra/curves/flat_precomp.hpp>
+#include <libff/algebra/curves/gt_exp.hpp>
+#include <libff/algebra/curves/pairing_async.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <libff/common/execution.hpp>
 #include <libff/common/profiling.hpp>
 #ifdef CURVE_BN128
 #include <libff/algebra/curves/bn128/bn128_pp.hpp>
@@ -22,6 +28,14 @@
 #include <libff/algebra/curves/mnt753/mnt6753/mnt6753_pp.hpp>
 #include <libff/algebra/curves/mnt753/mnt4753/mnt4753_pp.hpp>
 
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
 using namespace libff;
 
 template<typename ppT>
@@ -117,6 +131,321 @@ void double_miller_loop_test()
     assert(ans_1 * ans_2 == ans_12);
 }
 
+template<typename ppT>
+void GT_exp_test()
+{
+    const GT<ppT> g = ppT::reduced_pairing((Fr<ppT>::random_element()) * G1<ppT>::one(),
+                                           (Fr<ppT>::random_element()) * G2<ppT>::one());
+    const Fr<ppT> e = Fr<ppT>::random_element();
+    assert(GT_exp<ppT>(g, e) == (g ^ e));
+    assert(GT_exp<ppT>(g, Fr<ppT>::zero()) == GT<ppT>::one());
+    assert(GT_exp<ppT>(g, -Fr<ppT>::one()) == g.unitary_inverse());
+
+    std::vector<GT<ppT> > bases;
+    std::vector<Fr<ppT> > exponents;
+    GT<ppT> expected = GT<ppT>::one();
+    for (size_t i = 0; i < 9; ++i)
+    {
+        bases.emplace_back(i == 0 ? g : bases.back() * g);
+        exponents.emplace_back(i == 3 ? Fr<ppT>::zero() : Fr<ppT>::random_element());
+        expected = expected * (bases.back() ^ exponents.back());
+    }
+    assert(GT_multi_exp<ppT>(bases, exponents) == expected);
+    assert(GT_multi_exp<ppT>(std::vector<GT<ppT> >(), std::vector<Fr<ppT> >()) == GT<ppT>::one());
+}
+
+template<typename ppT>
+void streaming_pairing_test()
+{
+    const G1<ppT> P = (Fr<ppT>::random_element()) * G1<ppT>::one();
+    const G2<ppT> Q = (Fr<ppT>::random_element()) * G2<ppT>::one();
+
+    /* the one-shot pairing does not precompute Q */
+    const Fqk<ppT> precomputed = ppT::miller_loop(ppT::precompute_G1(P), ppT::precompute_G2(Q));
+    assert(ppT::pairing(P, Q) == precomputed);
+}
+
+template<typename ppT>
+void multi_miller_loop_test()
+{
+    std::vector<G1_precomp<ppT> > prec_P;
+    std::vector<G2_precomp<ppT> > prec_Q;
+    Fqk<ppT> expected = Fqk<ppT>::one();
+    /* odd counts leave one pair whose lines are not multiplied with another pair's */
+    for (size_t n = 1; n <= 4; ++n)
+    {
+        const G1<ppT> P = (Fr<ppT>::random_element()) * G1<ppT>::one();
+        const G2<ppT> Q = (Fr<ppT>::random_element()) * G2<ppT>::one();
+        prec_P.emplace_back(ppT::precompute_G1(P));
+        prec_Q.emplace_back(ppT::precompute_G2(Q));
+        expected = expected * ppT::miller_loop(prec_P.back(), prec_Q.back());
+        assert(ppT::multi_miller_loop(prec_P, prec_Q) == expected);
+    }
+    assert(ppT::multi_miller_loop(std::vector<G1_precomp<ppT> >(), std::vector<G2_precomp<ppT> >()) == Fqk<ppT>::one());
+}
+
+template<typename ppT>
+void batch_verify_test()
+{
+    /* Groth16-like equations e(A, B) * e(-C, delta) = e(alpha, beta), sharing delta and the right-hand side */
+    const Fr<ppT> alpha = Fr<ppT>::random_element();
+    const Fr<ppT> beta = Fr<ppT>::random_element();
+    const Fr<ppT> delta = Fr<ppT>::random_element();
+    const G2<ppT> delta_g2 = delta * G2<ppT>::one();
+    const GT<ppT> alpha_beta = ppT::reduced_pairing(alpha * G1<ppT>::one(), beta * G2<ppT>::one());
+
+    std::vector<pairing_product_equation<ppT> > equations(5);
+    for (pairing_product_equation<ppT> &eq : equations)
+    {
+        const Fr<ppT> a = Fr<ppT>::random_element();
+        const Fr<ppT> b = Fr<ppT>::random_element();
+        const Fr<ppT> c = (a * b - alpha * beta) * delta.inverse();
+        eq.add_term(a * G1<ppT>::one(), b * G2<ppT>::one());
+        eq.add_term(-(c * G1<ppT>::one()), delta_g2);
+        eq.rhs = alpha_beta;
+    }
+    /* an equation with a right-hand side of one */
+    pairing_product_equation<ppT> trivial;
+    trivial.add_term(G1<ppT>::one(), delta_g2);
+    trivial.add_term(-G1<ppT>::one(), delta_g2);
+    equations.emplace_back(trivial);
+
+    assert(batch_verify_pairing_products<ppT>(equations));
+    assert(batch_verify_pairing_products<ppT>(std::vector<pairing_product_equation<ppT> >()));
+
+    std::vector<pairing_product_equation<ppT> > tampered(equations);
+    tampered[3].P[1] = tampered[3].P[1] + G1<ppT>::one();
+    assert(!batch_verify_pairing_products<ppT>(tampered));
+    tampered = equations;
+    tampered[0].rhs = alpha_beta * alpha_beta;
+    assert(!batch_verify_pairing_products<ppT>(tampered));
+}
+
+/* equations with G1 points outside the subgroup of order r are rejected, even if they hold */
+template<typename ppT>
+void batch_verify_subgroup_test(const Fq<ppT> &coeff_b)
+{
+    Fq<ppT> x, y2;
+    do
+    {
+        x = Fq<ppT>::random_element();
+        y2 = x.squared() * x + coeff_b;
+    } while ((y2 ^ Fq<ppT>::euler) != Fq<ppT>::one());
+    const G1<ppT> outside(x, y2.sqrt(), Fq<ppT>::one());
+    assert(outside.is_well_formed() && !outside.is_in_correct_subgroup());
+
+    pairing_product_equation<ppT> eq;
+    eq.add_term(G1<ppT>::one(), G2<ppT>::one());
+    eq.add_term(-G1<ppT>::one(), G2<ppT>::one());
+    assert(batch_verify_pairing_products<ppT>({ eq }));
+
+    eq.P[0] = eq.P[0] + outside;
+    eq.P[1] = eq.P[1] - outside;
+    assert(!batch_verify_pairing_products<ppT>({ eq }));
+
+    /* so are points that are not on the curve */
+    eq.P[0] = G1<ppT>(x, x, Fq<ppT>::one());
+    eq.P[1] = -eq.P[0];
+    assert(!batch_verify_pairing_products<ppT>({ eq }));
+}
+
+template<typename ppT>
+void async_pairing_test(const std::shared_ptr<executor> &exec)
+{
+    set_executor(exec);
+
+    const G1<ppT> P = (Fr<ppT>::random_element()) * G1<ppT>::one();
+    const G2<ppT> Q = (Fr<ppT>::random_element()) * G2<ppT>::one();
+    const GT<ppT> expected = ppT::reduced_pairing(P, Q);
+
+    /* from values, and from handles of earlier submissions */
+    const async_value<GT<ppT> > direct = reduced_pairing_async<ppT>(P, Q);
+    const async_value<G1<ppT> > P_async = async_submit([P]() { return P; });
+    const async_value<G2<ppT> > Q_async = async_submit([Q]() { return Q; });
+    const async_value<GT<ppT> > chained = reduced_pairing_async<ppT>(P_async, Q_async);
+
+    const async_value<Fqk<ppT> > f = async_submit([P, Q]() -> Fqk<ppT> {
+        return ppT::miller_loop(ppT::precompute_G1(P), ppT::precompute_G2(Q));
+    });
+    const async_value<GT<ppT> > final = final_exponentiation_async<ppT>(f);
+
+    assert(direct.get() == expected);
+    assert(chained.get() == expected);
+    assert(final.get() == expected);
+
+    /* several G1 and G2 multiexps in flight at once, each pair feeding a pairing */
+    const size_t n = 20;
+    std::vector<G1<ppT> > bases1(n);
+    std::vector<G2<ppT> > bases2(n);
+    std::vector<Fr<ppT> > scalars(n);
+    G1<ppT> sum1 = G1<ppT>::zero();
+    G2<ppT> sum2 = G2<ppT>::zero();
+    for (size_t i = 0; i < n; ++i)
+    {
+        bases1[i] = G1<ppT>::random_element();
+        bases2[i] = G2<ppT>::random_element();
+        scalars[i] = Fr<ppT>::random_element();
+        sum1 = sum1 + scalars[i] * bases1[i];
+        sum2 = sum2 + scalars[i] * bases2[i];
+    }
+    const GT<ppT> expected_sums = ppT::reduced_pairing(sum1, sum2);
+    std::vector<async_value<GT<ppT> > > pairings;
+    for (size_t k = 0; k < 4; ++k)
+    {
+        const async_value<G1<ppT> > A = multi_exp_async<G1<ppT>, Fr<ppT>, multi_exp_method_BDLO12>(
+            bases1.cbegin(), bases1.cend(), scalars.cbegin(), scalars.cend(), exec->concurrency());
+        const async_value<G2<ppT> > B = multi_exp_async<G2<ppT>, Fr<ppT>, multi_exp_method_BDLO12>(
+            bases2.cbegin(), bases2.cend(), scalars.cbegin(), scalars.cend(), exec->concurrency());
+        pairings.emplace_back(reduced_pairing_async<ppT>(A, B));
+    }
+    for (const async_value<GT<ppT> > &e : pairings)
+    {
+        assert(e.get() == expected_sums);
+    }
+
+    set_executor(nullptr);
+}
+
+template<typename ppT>
+void async_pairing_test()
+{
+    async_pairing_test<ppT>(std::make_shared<thread_pool_executor>(2));
+#ifdef MULTICORE
+    async_pairing_test<ppT>(std::make_shared<openmp_executor>());
+#endif
+}
+
+/* the view has the point and the coefficients of the precomputation */
+template<typename ppT>
+bool view_matches(const G2_precomp_view<ppT> &view, const G2_precomp<ppT> &prec)
+{
+    typedef flat_G2_precomp_traits_for<ppT> traits;
+    std::string view_head(traits::head_size, '\0'), prec_head(traits::head_size, '\0');
+    traits::write_head(view, (unsigned char*) &view_head[0]);
+    traits::write_head(prec, (unsigned char*) &prec_head[0]);
+    return (view_head == prec_head && view.coeffs.size() == prec.coeffs.size() &&
+            std::equal(view.coeffs.begin(), view.coeffs.end(), prec.coeffs.begin()));
+}
+
+template<typename ppT, typename other_ppT>
+void flat_precomp_test()
+{
+    const G1<ppT> P = Fr<ppT>::random_element() * G1<ppT>::one();
+    std::vector<G2<ppT> > Q;
+    std::vector<G2_precomp<ppT> > precomps;
+    for (size_t i = 0; i < 3; ++i)
+    {
+        Q.emplace_back(Fr<ppT>::random_element() * G2<ppT>::one());
+        precomps.emplace_back(ppT::precompute_G2(Q[i]));
+    }
+    const G1_precomp<ppT> prec_P = ppT::precompute_G1(P);
+
+    /* through a stream */
+    std::stringstream ss;
+    write_flat_G2_precomps<ppT>(ss, precomps);
+    const std::vector<G2_precomp_view<ppT> > read = read_flat_G2_precomps<ppT>(ss);
+    assert(read.size() == precomps.size());
+    for (size_t i = 0; i < read.size(); ++i)
+    {
+        assert(view_matches<ppT>(read[i], precomps[i]));
+        assert(ppT::miller_loop(prec_P, read[i]) == ppT::miller_loop(prec_P, precomps[i]));
+    }
+    const G1_precomp<ppT> prec_P2 = ppT::precompute_G1(G1<ppT>::one());
+    assert(ppT::double_miller_loop(prec_P, read[0], prec_P2, read[1]) ==
+           ppT::double_miller_loop(prec_P, precomps[0], prec_P2, precomps[1]));
+    const std::vector<G1_precomp<ppT> > prec_Ps(read.size(), prec_P);
+    assert(ppT::multi_miller_loop(prec_Ps, read) == ppT::multi_miller_loop(prec_Ps, precomps));
+
+    /* headers that do not match the curve are rejected before any record is used or allocated */
+    const std::string good = ss.str();
+    for (size_t i = 0; i < 3; ++i)
+    {
+        std::string bad = good;
+        flat_G2_precomp_header header;
+        std::memcpy(&header, &bad[0], sizeof(header));
+        if (i == 0)
+        {
+            /* records too short for the Miller loop, with a consistent record size */
+            header.num_coeffs -= 1;
+            header.record_size = flat_G2_precomp_record_size<ppT>(header.num_coeffs);
+        }
+        else if (i == 1)
+        {
+            header.curve_id ^= 1;
+        }
+        else
+        {
+            /* count * record_size overflows */
+            header.count = std::numeric_limits<uint64_t>::max() / 2;
+        }
+        std::memcpy(&bad[0], &header, sizeof(header));
+
+        std::stringstream bad_ss(bad);
+        bool caught = false;
+        try
+        {
+            read_flat_G2_precomps<ppT>(bad_ss);
+        }
+        catch (const std::runtime_error &)
+        {
+            caught = true;
+        }
+        assert(caught);
+    }
+
+    /* through a memory-mapped file; the precomputations keep the mapping alive */
+    const std::string path = "flat_precomp_test.bin";
+    {
+        std::ofstream out(path, std::ios::binary);
+        write_flat_G2_precomps<ppT>(out, precomps);
+    }
+    G2_precomp_view<ppT> kept;
+    {
+        const std::vector<G2_precomp_view<ppT> > mapped = map_flat_G2_precomps<ppT>(path);
+        assert(mapped.size() == precomps.size() && view_matches<ppT>(mapped[1], precomps[1]));
+        kept = mapped[2];
+
+        bool caught = false;
+        try
+        {
+            map_flat_G2_precomps<other_ppT>(path);
+        }
+        catch (const std::runtime_error &)
+        {
+            caught = true;
+        }
+        assert(caught);
+
+        /* the cache hands out the mapped precomputations */
+        clear_G2_precomp_cache<ppT>();
+        add_to_G2_precomp_cache<ppT>(mapped);
+        assert(G2_precomp_cache_size<ppT>() == 3);
+    }
+    std::remove(path.c_str());
+    assert(view_matches<ppT>(kept, precomps[2]));
+    assert(ppT::reduced_pairing(P, Q[2]) ==
+           ppT::final_exponentiation(ppT::miller_loop(prec_P, kept)));
+
+    /* looked up by the point, whatever its projective representation */
+    const std::shared_ptr<const G2_precomp_view<ppT> > cached = cached_precompute_G2<ppT>(Q[0] + G2<ppT>::one() - G2<ppT>::one());
+    assert(view_matches<ppT>(*cached, precomps[0]));
+    assert(G2_precomp_cache_size<ppT>() == 3);
+
+    /* a new point is computed once, then shared */
+    const G2<ppT> R = Fr<ppT>::random_element() * G2<ppT>::one();
+    const std::shared_ptr<const G2_precomp_view<ppT> > first = cached_precompute_G2<ppT>(R);
+    assert(view_matches<ppT>(*first, ppT::precompute_G2(R)));
+    assert(cached_precompute_G2<ppT>(R) == first);
+    assert(G2_precomp_cache_size<ppT>() == 4);
+
+    set_G2_precomp_cache_capacity<ppT>(2);
+    assert(G2_precomp_cache_size<ppT>() == 2);
+    assert(cached_precompute_G2<ppT>(R) == first);
+    set_G2_precomp_cache_capacity<ppT>(1024);
+    clear_G2_precomp_cache<ppT>();
+    assert(G2_precomp_cache_size<ppT>() == 0);
+}
+
 template<typename ppT>
 void affine_pairing_test()
 {
@@ -150,7 +479,13 @@ int main(void)
     bls12_381_pp::init_public_params();
     pairing_test<bls12_381_pp>();
     double_miller_loop_test<bls12_381_pp>();
+    multi_miller_loop_test<bls12_381_pp>();
+    GT_exp_test<bls12_381_pp>();
+    batch_verify_test<bls12_381_pp>();
+    batch_verify_subgroup_test<bls12_381_pp>(bls12_381_coeff_b);
+    async_pairing_test<bls12_381_pp>();
     pairing_batching_test<bls12_381_pp>();
+    flat_precomp_test<bls12_381_pp, bls12_377_pp>();
 
     printf("edwards:\n");
     edwards_pp::init_public_params();
@@ -161,17 +496,26 @@ int main(void)
     alt_bn128_pp::init_public_params();
     pairing_test<alt_bn128_pp>();
     double_miller_loop_test<alt_bn128_pp>();
+    multi_miller_loop_test<alt_bn128_pp>();
+    GT_exp_test<alt_bn128_pp>();
+    async_pairing_test<alt_bn128_pp>();
+    flat_precomp_test<alt_bn128_pp, bls12_381_pp>();
 
     printf("bw12_446:\n");
     bw12_446_pp::init_public_params();
     pairing_test<bw12_446_pp>();
     double_miller_loop_test<bw12_446_pp>();
+    multi_miller_loop_test<bw12_446_pp>();
+    flat_precomp_test<bw12_446_pp, alt_bn128_pp>();
 
     printf("bls12_377:\n");
     bls12_377_pp::init_public_params();
     pairing_test<bls12_377_pp>();
     double_miller_loop_test<bls12_377_pp>();
+    multi_miller_loop_test<bls12_377_pp>();
+    GT_exp_test<bls12_377_pp>();
     pairing_batching_test<bls12_377_pp>();
+    flat_precomp_test<bls12_377_pp, bls12_381_pp>();
 
     printf("sw6:\n");
     sw6_pp::init_public_params();
@@ -182,17 +526,26 @@ int main(void)
     printf("bw6_761:\n");
     bw6_761_pp::init_public_params();
     pairing_test<bw6_761_pp>();
+    double_miller_loop_test<bw6_761_pp>();
+    multi_miller_loop_test<bw6_761_pp>();
+    GT_exp_test<bw6_761_pp>();
+    batch_verify_test<bw6_761_pp>();
 
     printf("mnt4:\n");
     mnt4_pp::init_public_params();
     pairing_test<mnt4_pp>();
     double_miller_loop_test<mnt4_pp>();
+    streaming_pairing_test<mnt4_pp>();
+    GT_exp_test<mnt4_pp>();
+    batch_verify_test<mnt4_pp>();
     affine_pairing_test<mnt4_pp>();
 
     printf("mnt6:\n");
     mnt6_pp::init_public_params();
     pairing_test<mnt6_pp>();
     double_miller_loop_test<mnt6_pp>();
+    streaming_pairing_test<mnt6_pp>();
+    GT_exp_test<mnt6_pp>();
     affine_pairing_test<mnt6_pp>();
 
     printf("pendulum:\n");
@@ -204,12 +557,14 @@ int main(void)
     mnt4753_pp::init_public_params();
     pairing_test<mnt4753_pp>();
     double_miller_loop_test<mnt4753_pp>();
+    streaming_pairing_test<mnt4753_pp>();
     affine_pairing_test<mnt4753_pp>();
 
     printf("mnt6753:\n");
     mnt6753_pp::init_public_params();
     pairing_test<mnt6753_pp>();
     double_miller_loop_test<mnt6753_pp>();
+    streaming_pairing_test<mnt6753_pp>();
     affine_pairing_test<mnt6753_pp>();
 
     printf("toy_curve:\n");
@@ -221,5 +576,8 @@ int main(void)
     bn128_pp::init_public_params();
     pairing_test<bn128_pp>();
     double_miller_loop_test<bn128_pp>();
+    multi_miller_loop_test<bn128_pp>();
+    batch_verify_test<bn128_pp>();
+    flat_precomp_test<bn128_pp, alt_bn128_pp>();
 #endif
 }
@@ -22,6 +22,7 @@
 #include <libff/algebra/curves/toy_curve/toy_curve_pp.hpp>
 #include <libff/algebra/curves/bls12_377/bls12_377_pp.hpp>
 #include <libff/algebra/curves/bls12_381/bls12_381_pp.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_hash_to_curve.hpp>
 
 using namespace libff;
 
@@ -129,6 +130,38 @@ void test_mul_by_q()
     assert(b == c);
 }
 
+template<typename GroupT>
+void test_subgroup_check(const typename GroupT::base_field &coeff_b)
+{
+    typedef typename GroupT::base_field FieldT;
+
+    /* a point of the curve y^2 = x^3 + b that is (almost surely) outside the subgroup */
+    FieldT x, y2;
+    do
+    {
+        x = FieldT::random_element();
+        y2 = x.squared() * x + coeff_b;
+    } while ((y2 ^ FieldT::euler) != FieldT::one());
+    const GroupT outside(x, y2.sqrt(), FieldT::one());
+    assert(outside.is_well_formed());
+    assert(!(GroupT::order() * outside).is_zero());
+
+    std::vector<GroupT> points;
+    for (size_t i = 0; i < 8; ++i)
+    {
+        points.emplace_back(i == 2 ? GroupT::zero() : GroupT::random_element());
+        assert(points.back().is_in_correct_subgroup());
+    }
+    assert(!outside.is_in_correct_subgroup());
+    /* adding a point of the subgroup does not help */
+    assert(!(outside + GroupT::one()).is_in_correct_subgroup());
+
+    assert(GroupT::batch_is_in_correct_subgroup(points));
+    assert(GroupT::batch_is_in_correct_subgroup(std::vector<GroupT>()));
+    points[5] = points[5] + outside;
+    assert(!GroupT::batch_is_in_correct_subgroup(points));
+}
+
 template<typename GroupT>
 void test_output()
 {
@@ -146,15 +179,74 @@ void test_output()
     }
 }
 
+template<typename GroupT>
+void test_vector_output()
+{
+    std::vector<GroupT> v;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        v.emplace_back(i == 4 ? GroupT::zero() : GroupT::random_element());
+    }
+
+    std::stringstream ss;
+    ss << v;
+    std::vector<GroupT> vv;
+    ss >> vv;
+    assert(v == vv);
+}
+
+void test_bls12_381_hash_to_curve()
+{
+    /* the first test vectors of RFC 9380, appendices J.9.1 and J.10.1 */
+    const bls12_381_G1 P = bls12_381_hash_to_G1("", "QUUX-V01-CS02-with-BLS12381G1_XMD:SHA-256_SSWU_RO_");
+    assert(P == bls12_381_G1(
+        bls12_381_Fq("794311575721400831362957049303781044852006323422624111893352859557450008308620925451441746926395141598720928151969"),
+        bls12_381_Fq("1343412193624222137939591894701031123123641958980729764240763391191550653712890272928110356903136085217047453540965"),
+        bls12_381_Fq::one()));
+    const bls12_381_G2 Q = bls12_381_hash_to_G2("", "QUUX-V01-CS02-with-BLS12381G2_XMD:SHA-256_SSWU_RO_");
+    assert(Q == bls12_381_G2(
+        bls12_381_Fq2(bls12_381_Fq("193548053368451749411421515628510806626565736652086807419354395577367693778571452628423727082668900187036482254730"),
+                      bls12_381_Fq("891930009643099423308102777951250899694559203647724988361022851024990473423938537113948850338098230396747396259901")),
+        bls12_381_Fq2(bls12_381_Fq("771717272055834152378281705972671257005357145478800908373659404991537354153455452961747174765859335819766715637138"),
+                      bls12_381_Fq("2810310118582126634041133454180705304393079139103252956502404531123692847658283858246402311867775854528543237781718")),
+        bls12_381_Fq2::one()));
+
+    const std::string dst = "BLS_SIG_BLS12381G2_XMD:SHA-256_SSWU_RO_POP_";
+    std::vector<std::string> msgs;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        msgs.emplace_back(std::string(i * 30, 'a' + i));
+    }
+    const std::vector<bls12_381_G1> batch_G1 = bls12_381_batch_hash_to_G1(msgs, dst);
+    const std::vector<bls12_381_G2> batch_G2 = bls12_381_batch_hash_to_G2(msgs, dst);
+    for (size_t i = 0; i < msgs.size(); ++i)
+    {
+        assert(batch_G1[i] == bls12_381_hash_to_G1(msgs[i], dst));
+        assert(batch_G2[i] == bls12_381_hash_to_G2(msgs[i], dst));
+        assert(batch_G1[i].is_well_formed() && batch_G1[i].is_in_correct_subgroup());
+        assert(batch_G2[i].is_well_formed() && (bls12_381_G2::order() * batch_G2[i]).is_zero());
+    }
+    assert(batch_G1[1] != batch_G1[2]);
+    assert(bls12_381_hash_to_G1(msgs[1], dst) != bls12_381_hash_to_G1(msgs[1], dst + "x"));
+    assert(bls12_381_batch_hash_to_G1(std::vector<std::string>(), dst).empty());
+
+    /* an oversize dst is hashed first */
+    const std::string long_dst(300, 'd');
+    assert(bls12_381_expand_message_xmd("abc", long_dst, 50).size() == 50);
+    assert(bls12_381_hash_to_G2("abc", long_dst).is_well_formed());
+}
+
 int main(void)
 {
     printf("bls12_381: \n");
     bls12_381_pp::init_public_params();
     test_group<G1<bls12_381_pp> >();
     test_output<G1<bls12_381_pp> >();
+    test_subgroup_check<G1<bls12_381_pp> >(bls12_381_coeff_b);
     test_group<G2<bls12_381_pp> >();
     test_output<G2<bls12_381_pp> >();
     test_mul_by_q<G2<bls12_381_pp> >();
+    test_bls12_381_hash_to_curve();
 
     printf("edwards: \n");
     edwards_pp::init_public_params();
@@ -183,6 +275,7 @@ int main(void)
     bls12_377_pp::init_public_params();
     test_group<G1<bls12_377_pp> >();
     test_output<G1<bls12_377_pp> >();
+    test_subgroup_check<G1<bls12_377_pp> >(bls12_377_coeff_b);
     test_group<G2<bls12_377_pp> >();
     test_output<G2<bls12_377_pp> >();
     test_mul_by_q<G2<bls12_377_pp> >();
@@ -197,6 +290,7 @@ int main(void)
     printf("bw6_761: \n");
     bw6_761_pp::init_public_params();
     test_group<G1<bw6_761_pp> >();
+    test_subgroup_check<G1<bw6_761_pp> >(bw6_761_G1::coeff_b);
     test_group<G2<bw6_761_pp> >();
     test_output<G2<bw6_761_pp> >();
     test_mul_by_q<G2<bw6_761_pp> >();
@@ -253,7 +347,9 @@ int main(void)
     bn128_pp::init_public_params();
     test_group<G1<bn128_pp> >();
     test_output<G1<bn128_pp> >();
+    test_vector_output<G1<bn128_pp> >();
     test_group<G2<bn128_pp> >();
     test_output<G2<bn128_pp> >();
+    test_vector_output<G2<bn128_pp> >();
 #endif
 }
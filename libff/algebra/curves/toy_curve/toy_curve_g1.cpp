@@ -3,8 +3,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long toy_curve_G1::add_cnt = 0;
-long long toy_curve_G1::dbl_cnt = 0;
+op_counter toy_curve_G1::add_cnt("toy_curve_G1::add");
+op_counter toy_curve_G1::dbl_cnt("toy_curve_G1::dbl");
 #endif
 
 std::vector<size_t> toy_curve_G1::wnaf_window_table;
@@ -172,6 +172,10 @@ toy_curve_G1 toy_curve_G1::operator+(const toy_curve_G1 &other) const
         return this->dbl();
     }
 
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
+
     // rest of add case
     toy_curve_Fq H = U2 - U1;                            // H = U2-U1
     toy_curve_Fq S2_minus_S1 = S2-S1;
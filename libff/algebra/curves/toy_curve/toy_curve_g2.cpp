@@ -3,8 +3,8 @@
 namespace libff {
 
 #ifdef PROFILE_OP_COUNTS
-long long toy_curve_G2::add_cnt = 0;
-long long toy_curve_G2::dbl_cnt = 0;
+op_counter toy_curve_G2::add_cnt("toy_curve_G2::add");
+op_counter toy_curve_G2::dbl_cnt("toy_curve_G2::dbl");
 #endif
 
 std::vector<size_t> toy_curve_G2::wnaf_window_table;
@@ -182,6 +182,10 @@ toy_curve_G2 toy_curve_G2::operator+(const toy_curve_G2 &other) const
         return this->dbl();
     }
 
+#ifdef PROFILE_OP_COUNTS
+    this->add_cnt++;
+#endif
+
     // rest of add case
     toy_curve_Fq2 H = U2 - U1;                            // H = U2-U1
     toy_curve_Fq2 S2_minus_S1 = S2-S1;
@@ -26,6 +26,11 @@ void init_toy_curve_params()
     typedef bigint<toy_curve_r_limbs> bigint_r;
     typedef bigint<toy_curve_q_limbs> bigint_q;
 
+#ifdef PROFILE_OP_COUNTS
+    toy_curve_Fr::name_op_counters("toy_curve_Fr");
+    toy_curve_Fq::name_op_counters("toy_curve_Fq");
+#endif
+
     assert(sizeof(mp_limb_t) == 8 || sizeof(mp_limb_t) == 4); // Montgomery assumes this
 
     /* parameters for scalar field Fr */
@@ -1,7 +1,10 @@
+#include <cassert>
+
 #include <libff/algebra/curves/toy_curve/toy_curve_g1.hpp>
 #include <libff/algebra/curves/toy_curve/toy_curve_g2.hpp>
 #include <libff/algebra/curves/toy_curve/toy_curve_init.hpp>
 #include <libff/algebra/curves/toy_curve/toy_curve_pairing.hpp>
+#include <libff/common/memory_accounting.hpp>
 #include <libff/common/profiling.hpp>
 
 namespace libff {
@@ -93,6 +96,8 @@ std::istream& operator>>(std::istream& in, toy_curve_ate_G2_precomp &prec_Q)
         prec_Q.coeffs.emplace_back(c);
     }
 
+    prec_Q.coeffs_mem.set(prec_Q.coeffs.capacity() * sizeof(toy_curve_ate_ell_coeffs));
+
     return in;
 }
 
@@ -353,6 +358,8 @@ toy_curve_ate_G2_precomp toy_curve_ate_precompute_G2(const toy_curve_G2& Q)
     mixed_addition_step_for_flipped_miller_loop(Q2, R, c);
     result.coeffs.push_back(c);
 
+    result.coeffs_mem.set(result.coeffs.capacity() * sizeof(toy_curve_ate_ell_coeffs));
+
     leave_block("Call to toy_curve_ate_precompute_G2");
     return result;
 }
@@ -411,13 +418,30 @@ toy_curve_Fq12 toy_curve_ate_miller_loop(const toy_curve_ate_G1_precomp &prec_P,
     return f;
 }
 
-toy_curve_Fq12 toy_curve_ate_double_miller_loop(const toy_curve_ate_G1_precomp &prec_P1,
-                                     const toy_curve_ate_G2_precomp &prec_Q1,
-                                     const toy_curve_ate_G1_precomp &prec_P2,
-                                     const toy_curve_ate_G2_precomp &prec_Q2)
+/* multiply f by the lines at position idx of all pairs, two lines at a time */
+static void toy_curve_ate_mul_by_lines(toy_curve_Fq12 &f,
+                                 const std::vector<const toy_curve_ate_G1_precomp*> &prec_P,
+                                 const std::vector<const toy_curve_ate_G2_precomp*> &prec_Q,
+                                 const size_t idx)
 {
-    enter_block("Call to toy_curve_ate_double_miller_loop");
+    size_t i = 0;
+    for (; i + 1 < prec_P.size(); i += 2)
+    {
+        const toy_curve_ate_ell_coeffs &c1 = prec_Q[i]->coeffs[idx];
+        const toy_curve_ate_ell_coeffs &c2 = prec_Q[i+1]->coeffs[idx];
+        f = f.mul_by_01234(toy_curve_Fq12::mul_024_by_024(c1.ell_0, prec_P[i]->PY * c1.ell_VW, prec_P[i]->PX * c1.ell_VV,
+                                                          c2.ell_0, prec_P[i+1]->PY * c2.ell_VW, prec_P[i+1]->PX * c2.ell_VV));
+    }
+    if (i < prec_P.size())
+    {
+        const toy_curve_ate_ell_coeffs &c1 = prec_Q[i]->coeffs[idx];
+        f = f.mul_by_024(c1.ell_0, prec_P[i]->PY * c1.ell_VW, prec_P[i]->PX * c1.ell_VV);
+    }
+}
 
+static toy_curve_Fq12 toy_curve_ate_multi_miller_loop_inner(const std::vector<const toy_curve_ate_G1_precomp*> &prec_P,
+                                               const std::vector<const toy_curve_ate_G2_precomp*> &prec_Q)
+{
     toy_curve_Fq12 f = toy_curve_Fq12::one();
 
     bool found_one = false;
@@ -438,23 +462,12 @@ toy_curve_Fq12 toy_curve_ate_double_miller_loop(const toy_curve_ate_G1_precomp &
            toy_curve_param_p (skipping leading zeros) in MSB to LSB
            order */
 
-        toy_curve_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-        toy_curve_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-        ++idx;
-
         f = f.squared();
-
-        f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-        f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+        toy_curve_ate_mul_by_lines(f, prec_P, prec_Q, idx++);
 
         if (bit)
         {
-            toy_curve_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-            toy_curve_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-            ++idx;
-
-            f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-            f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+            toy_curve_ate_mul_by_lines(f, prec_P, prec_Q, idx++);
         }
     }
 
@@ -463,23 +476,45 @@ toy_curve_Fq12 toy_curve_ate_double_miller_loop(const toy_curve_ate_G1_precomp &
     	f = f.inverse();
     }
 
-    toy_curve_ate_ell_coeffs c1 = prec_Q1.coeffs[idx];
-    toy_curve_ate_ell_coeffs c2 = prec_Q2.coeffs[idx];
-    ++idx;
-    f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-    f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+    toy_curve_ate_mul_by_lines(f, prec_P, prec_Q, idx++);
+    toy_curve_ate_mul_by_lines(f, prec_P, prec_Q, idx++);
 
-    c1 = prec_Q1.coeffs[idx];
-    c2 = prec_Q2.coeffs[idx];
-    ++idx;
-    f = f.mul_by_024(c1.ell_0, prec_P1.PY * c1.ell_VW, prec_P1.PX * c1.ell_VV);
-    f = f.mul_by_024(c2.ell_0, prec_P2.PY * c2.ell_VW, prec_P2.PX * c2.ell_VV);
+    return f;
+}
 
+toy_curve_Fq12 toy_curve_ate_double_miller_loop(const toy_curve_ate_G1_precomp &prec_P1,
+                                     const toy_curve_ate_G2_precomp &prec_Q1,
+                                     const toy_curve_ate_G1_precomp &prec_P2,
+                                     const toy_curve_ate_G2_precomp &prec_Q2)
+{
+    enter_block("Call to toy_curve_ate_double_miller_loop");
+    const toy_curve_Fq12 f = toy_curve_ate_multi_miller_loop_inner({ &prec_P1, &prec_P2 }, { &prec_Q1, &prec_Q2 });
     leave_block("Call to toy_curve_ate_double_miller_loop");
 
     return f;
 }
 
+toy_curve_Fq12 toy_curve_ate_multi_miller_loop(const std::vector<toy_curve_ate_G1_precomp> &prec_P,
+                                   const std::vector<toy_curve_ate_G2_precomp> &prec_Q)
+{
+    assert(prec_P.size() == prec_Q.size());
+    enter_block("Call to toy_curve_ate_multi_miller_loop");
+
+    std::vector<const toy_curve_ate_G1_precomp*> P_ptrs;
+    std::vector<const toy_curve_ate_G2_precomp*> Q_ptrs;
+    P_ptrs.reserve(prec_P.size());
+    Q_ptrs.reserve(prec_Q.size());
+    for (size_t i = 0; i < prec_P.size(); ++i)
+    {
+        P_ptrs.emplace_back(&prec_P[i]);
+        Q_ptrs.emplace_back(&prec_Q[i]);
+    }
+    const toy_curve_Fq12 f = toy_curve_ate_multi_miller_loop_inner(P_ptrs, Q_ptrs);
+
+    leave_block("Call to toy_curve_ate_multi_miller_loop");
+    return f;
+}
+
 toy_curve_Fq12 toy_curve_ate_pairing(const toy_curve_G1& P, const toy_curve_G2 &Q)
 {
     enter_block("Call to toy_curve_ate_pairing");
@@ -525,6 +560,12 @@ toy_curve_Fq12 toy_curve_double_miller_loop(const toy_curve_G1_precomp &prec_P1,
     return toy_curve_ate_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
 }
 
+toy_curve_Fq12 toy_curve_multi_miller_loop(const std::vector<toy_curve_G1_precomp> &prec_P,
+                               const std::vector<toy_curve_G2_precomp> &prec_Q)
+{
+    return toy_curve_ate_multi_miller_loop(prec_P, prec_Q);
+}
+
 toy_curve_Fq12 toy_curve_pairing(const toy_curve_G1& P,
                       const toy_curve_G2 &Q)
 {
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include <libff/algebra/curves/toy_curve/toy_curve_init.hpp>
+#include <libff/common/memory_accounting.hpp>
 
 namespace libff {
 
@@ -35,6 +36,7 @@ struct toy_curve_ate_G2_precomp {
     toy_curve_Fq2 QX;
     toy_curve_Fq2 QY;
     std::vector<toy_curve_ate_ell_coeffs> coeffs;
+    mem_charge<mem_tag_pairing_precomp> coeffs_mem;
 
     bool operator==(const toy_curve_ate_G2_precomp &other) const;
     friend std::ostream& operator<<(std::ostream &out, const toy_curve_ate_G2_precomp &prec_Q);
@@ -51,6 +53,10 @@ toy_curve_Fq12 toy_curve_ate_double_miller_loop(const toy_curve_ate_G1_precomp &
                                      const toy_curve_ate_G1_precomp &prec_P2,
                                      const toy_curve_ate_G2_precomp &prec_Q2);
 
+/* product of the Miller loops of all pairs (prec_P[i], prec_Q[i]) */
+toy_curve_Fq12 toy_curve_ate_multi_miller_loop(const std::vector<toy_curve_ate_G1_precomp> &prec_P,
+                                   const std::vector<toy_curve_ate_G2_precomp> &prec_Q);
+
 toy_curve_Fq12 toy_curve_ate_pairing(const toy_curve_G1& P,
                           const toy_curve_G2 &Q);
 toy_curve_GT toy_curve_ate_reduced_pairing(const toy_curve_G1 &P,
@@ -72,6 +78,8 @@ toy_curve_Fq12 toy_curve_double_miller_loop(const toy_curve_G1_precomp &prec_P1,
                                  const toy_curve_G2_precomp &prec_Q1,
                                  const toy_curve_G1_precomp &prec_P2,
                                  const toy_curve_G2_precomp &prec_Q2);
+toy_curve_Fq12 toy_curve_multi_miller_loop(const std::vector<toy_curve_G1_precomp> &prec_P,
+                               const std::vector<toy_curve_G2_precomp> &prec_Q);
 
 toy_curve_Fq12 toy_curve_pairing(const toy_curve_G1& P,
                       const toy_curve_G2 &Q);
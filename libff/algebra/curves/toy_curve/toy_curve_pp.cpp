@@ -36,6 +36,12 @@ toy_curve_Fq12 toy_curve_pp::double_miller_loop(const toy_curve_G1_precomp &prec
     return toy_curve_double_miller_loop(prec_P1, prec_Q1, prec_P2, prec_Q2);
 }
 
+toy_curve_Fq12 toy_curve_pp::multi_miller_loop(const std::vector<toy_curve_G1_precomp> &prec_P,
+                                   const std::vector<toy_curve_G2_precomp> &prec_Q)
+{
+    return toy_curve_multi_miller_loop(prec_P, prec_Q);
+}
+
 toy_curve_Fq12 toy_curve_pp::pairing(const toy_curve_G1 &P,
                                      const toy_curve_G2 &Q)
 {
@@ -32,6 +32,8 @@ public:
                                              const toy_curve_G2_precomp &prec_Q1,
                                              const toy_curve_G1_precomp &prec_P2,
                                              const toy_curve_G2_precomp &prec_Q2);
+    static toy_curve_Fq12 multi_miller_loop(const std::vector<toy_curve_G1_precomp> &prec_P,
+                                      const std::vector<toy_curve_G2_precomp> &prec_Q);
     static toy_curve_Fq12 pairing(const toy_curve_G1 &P,
                                   const toy_curve_G2 &Q);
     static toy_curve_Fq12 reduced_pairing(const toy_curve_G1 &P,
@@ -51,6 +51,16 @@ FieldT convert_bit_vector_to_field_element(const bit_vector &v);
 template<typename FieldT>
 void batch_invert(std::vector<FieldT> &vec);
 
+/**
+ * Converts a vector of field elements to their canonical (not Montgomery)
+ * bigint representations. When compiled with MULTICORE, the conversion is
+ * done in parallel. The result can be passed to the multi-exponentiation
+ * routines in place of the field elements, which avoids repeating the
+ * conversion in every call that uses the same scalars.
+ */
+template<typename FieldT>
+std::vector<bigint<FieldT::num_limbs> > batch_as_bigint(const std::vector<FieldT> &vec);
+
 } // libff
 #include <libff/algebra/fields/field_utils.tcc>
 
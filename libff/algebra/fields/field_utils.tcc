@@ -14,6 +14,7 @@
 #include <stdexcept>
 
 #include <libff/common/double.hpp>
+#include <libff/common/execution.hpp>
 #include <libff/common/utils.hpp>
 
 namespace libff {
@@ -231,5 +232,17 @@ void batch_invert(std::vector<FieldT> &vec)
     }
 }
 
+template<typename FieldT>
+std::vector<bigint<FieldT::num_limbs> > batch_as_bigint(const std::vector<FieldT> &vec)
+{
+    std::vector<bigint<FieldT::num_limbs> > res(vec.size());
+
+    parallel_for(0, vec.size(), [&](const size_t i) {
+        res[i] = vec[i].as_bigint();
+    });
+
+    return res;
+}
+
 } // libff
 #endif // FIELD_UTILS_TCC_
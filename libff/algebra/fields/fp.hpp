@@ -12,6 +12,7 @@
 
 #include <libff/algebra/exponentiation/exponentiation.hpp>
 #include <libff/algebra/fields/bigint.hpp>
+#include <libff/common/op_counts.hpp>
 
 namespace libff {
 
@@ -44,11 +45,13 @@ public:
     static const mp_size_t num_limbs = n;
     static const constexpr bigint<n>& mod = modulus;
 #ifdef PROFILE_OP_COUNTS
-    static long long add_cnt;
-    static long long sub_cnt;
-    static long long mul_cnt;
-    static long long sqr_cnt;
-    static long long inv_cnt;
+    static op_counter add_cnt;
+    static op_counter sub_cnt;
+    static op_counter mul_cnt;
+    static op_counter sqr_cnt;
+    static op_counter inv_cnt;
+    /* label the counters as e.g. "bls12_381_Fq::mul"; called by the curve initialization */
+    static void name_op_counters(const std::string &field_name);
 #endif
     static size_t num_bits;
     static bigint<n> euler; // (modulus-1)/2
@@ -132,19 +135,19 @@ public:
 
 #ifdef PROFILE_OP_COUNTS
 template<mp_size_t n, const bigint<n>& modulus>
-long long Fp_model<n, modulus>::add_cnt = 0;
+op_counter Fp_model<n, modulus>::add_cnt("Fp_model<" + std::to_string(n) + ">::add");
 
 template<mp_size_t n, const bigint<n>& modulus>
-long long Fp_model<n, modulus>::sub_cnt = 0;
+op_counter Fp_model<n, modulus>::sub_cnt("Fp_model<" + std::to_string(n) + ">::sub");
 
 template<mp_size_t n, const bigint<n>& modulus>
-long long Fp_model<n, modulus>::mul_cnt = 0;
+op_counter Fp_model<n, modulus>::mul_cnt("Fp_model<" + std::to_string(n) + ">::mul");
 
 template<mp_size_t n, const bigint<n>& modulus>
-long long Fp_model<n, modulus>::sqr_cnt = 0;
+op_counter Fp_model<n, modulus>::sqr_cnt("Fp_model<" + std::to_string(n) + ">::sqr");
 
 template<mp_size_t n, const bigint<n>& modulus>
-long long Fp_model<n, modulus>::inv_cnt = 0;
+op_counter Fp_model<n, modulus>::inv_cnt("Fp_model<" + std::to_string(n) + ">::inv");
 #endif
 
 template<mp_size_t n, const bigint<n>& modulus>
@@ -691,6 +691,18 @@ Fp_model<n,modulus> Fp_model<n,modulus>::inverse() const
     return (r.invert());
 }
 
+#ifdef PROFILE_OP_COUNTS
+template<mp_size_t n, const bigint<n>& modulus>
+void Fp_model<n,modulus>::name_op_counters(const std::string &field_name)
+{
+    add_cnt.add_name(field_name + "::add");
+    sub_cnt.add_name(field_name + "::sub");
+    mul_cnt.add_name(field_name + "::mul");
+    sqr_cnt.add_name(field_name + "::sqr");
+    inv_cnt.add_name(field_name + "::inv");
+}
+#endif
+
 template<mp_size_t n, const bigint<n>& modulus>
 Fp_model<n, modulus> Fp_model<n,modulus>::random_element() /// returns random element of Fp_model
 {
@@ -276,6 +276,82 @@ Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::mul_by_045(
     return Fp12_2over3over2_model<n,modulus>(my_Fp6(t0,t1,t2),my_Fp6(t3,t4,t5));
 }
 
+template<mp_size_t n, const bigint<n>& modulus>
+Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::mul_045_by_045(const Fp2_model<n, modulus> &ell_0_a,
+                                                                                    const Fp2_model<n, modulus> &ell_VW_a,
+                                                                                    const Fp2_model<n, modulus> &ell_VV_a,
+                                                                                    const Fp2_model<n, modulus> &ell_0_b,
+                                                                                    const Fp2_model<n, modulus> &ell_VW_b,
+                                                                                    const Fp2_model<n, modulus> &ell_VV_b)
+{
+    /* a = a0 + a4 * W^3 + a5 * W^5, where W^6 = non_residue; as in mul_by_045 */
+    const my_Fp2 &a0 = ell_VW_a, &a4 = ell_0_a, &a5 = ell_VV_a;
+    const my_Fp2 &b0 = ell_VW_b, &b4 = ell_0_b, &b5 = ell_VV_b;
+
+    const my_Fp2 A0 = a0 * b0;
+    const my_Fp2 A4 = a4 * b4;
+    const my_Fp2 A5 = a5 * b5;
+    const my_Fp2 A04 = (a0 + a4) * (b0 + b4) - A0 - A4;
+    const my_Fp2 A05 = (a0 + a5) * (b0 + b5) - A0 - A5;
+    const my_Fp2 A45 = (a4 + a5) * (b4 + b5) - A4 - A5;
+
+    return Fp12_2over3over2_model<n,modulus>(my_Fp6(A0 + my_Fp6::non_residue * A4,
+                                                    my_Fp6::non_residue * A45,
+                                                    my_Fp6::non_residue * A5),
+                                             my_Fp6(my_Fp2::zero(), A04, A05));
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::mul_024_by_024(const Fp2_model<n, modulus> &ell_0_a,
+                                                                                    const Fp2_model<n, modulus> &ell_VW_a,
+                                                                                    const Fp2_model<n, modulus> &ell_VV_a,
+                                                                                    const Fp2_model<n, modulus> &ell_0_b,
+                                                                                    const Fp2_model<n, modulus> &ell_VW_b,
+                                                                                    const Fp2_model<n, modulus> &ell_VV_b)
+{
+    /* a = a0 + a2 * W^4 + a4 * W^3, where W^6 = non_residue; as in mul_by_024 */
+    const my_Fp2 &a0 = ell_0_a, &a2 = ell_VV_a, &a4 = ell_VW_a;
+    const my_Fp2 &b0 = ell_0_b, &b2 = ell_VV_b, &b4 = ell_VW_b;
+
+    const my_Fp2 A0 = a0 * b0;
+    const my_Fp2 A2 = a2 * b2;
+    const my_Fp2 A4 = a4 * b4;
+    const my_Fp2 A02 = (a0 + a2) * (b0 + b2) - A0 - A2;
+    const my_Fp2 A04 = (a0 + a4) * (b0 + b4) - A0 - A4;
+    const my_Fp2 A24 = (a2 + a4) * (b2 + b4) - A2 - A4;
+
+    return Fp12_2over3over2_model<n,modulus>(my_Fp6(A0 + my_Fp6::non_residue * A4,
+                                                    my_Fp6::non_residue * A2,
+                                                    A02),
+                                             my_Fp6(my_Fp6::non_residue * A24, A04, my_Fp2::zero()));
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::mul_by_01234(const Fp12_2over3over2_model<n,modulus> &other) const
+{
+    /* Karatsuba as in operator*, with B = other.c1 = B0 + B1 * V */
+    const my_Fp6 &A = other.c0, &B = other.c1,
+        &a = this->c0, &b = this->c1;
+    const my_Fp6 aA = a * A;
+    const my_Fp6 bB = b.mul_by_01(B.c0, B.c1);
+
+    return Fp12_2over3over2_model<n,modulus>(aA + Fp12_2over3over2_model<n, modulus>::mul_by_non_residue(bB),
+                                             (a + b)*(A+B) - aA - bB);
+}
+
+template<mp_size_t n, const bigint<n>& modulus>
+Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::mul_by_01245(const Fp12_2over3over2_model<n,modulus> &other) const
+{
+    /* Karatsuba as in operator*, with B = other.c1 = (B1 + B2 * V) * V */
+    const my_Fp6 &A = other.c0, &B = other.c1,
+        &a = this->c0, &b = this->c1;
+    const my_Fp6 aA = a * A;
+    const my_Fp6 bB = Fp12_2over3over2_model<n, modulus>::mul_by_non_residue(b.mul_by_01(B.c1, B.c2));
+
+    return Fp12_2over3over2_model<n,modulus>(aA + Fp12_2over3over2_model<n, modulus>::mul_by_non_residue(bB),
+                                             (a + b)*(A+B) - aA - bB);
+}
+
 template<mp_size_t n, const bigint<n>& modulus>
 Fp12_2over3over2_model<n,modulus> Fp12_2over3over2_model<n,modulus>::mul_by_024(const Fp2_model<n, modulus> &ell_0,
                                                                                 const Fp2_model<n, modulus> &ell_VW,
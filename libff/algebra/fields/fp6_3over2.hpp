@@ -61,6 +61,8 @@ public:
     Fp6_3over2_model operator+(const Fp6_3over2_model &other) const;
     Fp6_3over2_model operator-(const Fp6_3over2_model &other) const;
     Fp6_3over2_model operator*(const Fp6_3over2_model &other) const;
+    /* product with b0 + b1 * V, in 5 Fp2 multiplications */
+    Fp6_3over2_model mul_by_01(const my_Fp2 &b0, const my_Fp2 &b1) const;
     Fp6_3over2_model operator-() const;
     Fp6_3over2_model squared() const;
     Fp6_3over2_model inverse() const;
@@ -102,6 +102,20 @@ Fp6_3over2_model<n,modulus> Fp6_3over2_model<n,modulus>::operator*(const Fp6_3ov
                                        (a+c)*(A+C)-aA+bB-cC);
 }
 
+template<mp_size_t n, const bigint<n>& modulus>
+Fp6_3over2_model<n,modulus> Fp6_3over2_model<n,modulus>::mul_by_01(const Fp2_model<n, modulus> &b0,
+                                                                   const Fp2_model<n, modulus> &b1) const
+{
+    /* Karatsuba as in operator* with a zero third coefficient */
+    const my_Fp2 &a = this->c0, &b = this->c1, &c = this->c2;
+    const my_Fp2 ab0 = a*b0;
+    const my_Fp2 bb1 = b*b1;
+
+    return Fp6_3over2_model<n,modulus>(ab0 + Fp6_3over2_model<n,modulus>::mul_by_non_residue(c*b1),
+                                       (a+b)*(b0+b1)-ab0-bb1,
+                                       c*b0+bb1);
+}
+
 template<mp_size_t n, const bigint<n>& modulus>
 Fp6_3over2_model<n,modulus> Fp6_3over2_model<n,modulus>::operator-() const
 {
@@ -23,6 +23,7 @@
 #include <libff/algebra/curves/toy_curve/toy_curve_pp.hpp>
 #include <libff/algebra/fields/fp12_2over3over2.hpp>
 #include <libff/algebra/fields/fp6_3over2.hpp>
+#include <libff/algebra/fields/torus.hpp>
 
 using namespace libff;
 
@@ -209,6 +210,64 @@ void test_all_fields()
     test_unitary_inverse<Fqk<ppT> >();
 }
 
+template<typename Fp12T>
+void test_line_products()
+{
+    typedef typename Fp12T::my_Fp2 Fp2T;
+    const Fp12T f = Fp12T::random_element();
+    Fp2T a[3], b[3];
+    for (size_t i = 0; i < 3; ++i)
+    {
+        a[i] = Fp2T::random_element();
+        b[i] = Fp2T::random_element();
+    }
+
+    assert(f * Fp12T::mul_024_by_024(a[0], a[1], a[2], b[0], b[1], b[2]) ==
+           f.mul_by_024(a[0], a[1], a[2]).mul_by_024(b[0], b[1], b[2]));
+    assert(f * Fp12T::mul_045_by_045(a[0], a[1], a[2], b[0], b[1], b[2]) ==
+           f.mul_by_045(a[0], a[1], a[2]).mul_by_045(b[0], b[1], b[2]));
+
+    const Fp12T g_01234 = Fp12T::mul_024_by_024(a[0], a[1], a[2], b[0], b[1], b[2]);
+    const Fp12T g_01245 = Fp12T::mul_045_by_045(a[0], a[1], a[2], b[0], b[1], b[2]);
+    assert(f.mul_by_01234(g_01234) == f * g_01234);
+    assert(f.mul_by_01245(g_01245) == f * g_01245);
+}
+
+template<typename ppT>
+void test_torus_compression()
+{
+    typedef GT<ppT> GT_t;
+    typedef compressed_GT<ppT> compressed;
+
+    const GT_t a = GT_t::random_element();
+    /* an element of norm 1 */
+    const GT_t g = a.Frobenius_map(GT_t::extension_degree()/2) * a.inverse();
+    const GT_t h = g.squared() * g;
+
+    const compressed cg = compressed::compress(g);
+    const compressed ch = compressed::compress(h);
+    assert(cg.decompress() == g);
+    assert(compressed::compress(GT_t::one()).decompress() == GT_t::one());
+    assert(compressed::compress(-GT_t::one()).decompress() == -GT_t::one());
+
+    assert((cg * ch).decompress() == g * h);
+    assert(cg.squared().decompress() == g.squared());
+    assert((cg * cg.unitary_inverse()) == compressed::one());
+
+    const bigint<Fr<ppT>::num_limbs> e = Fr<ppT>::random_element().as_bigint();
+    assert((cg ^ e).decompress() == (g ^ e));
+    assert((cg ^ Fr<ppT>::field_char()).decompress() == (g ^ Fr<ppT>::field_char()));
+    assert((compressed::one() ^ e) == compressed::one());
+
+    const std::vector<GT_t> elts = { g, GT_t::one(), h, -GT_t::one() };
+    const std::vector<compressed> celts = compressed::batch_compress(elts);
+    assert(celts[0] == cg && celts[1] == compressed::one() && celts[2] == ch);
+    assert(compressed::batch_decompress(celts) == elts);
+
+    assert(reserialize<compressed>(cg) == cg);
+    assert(reserialize<compressed>(compressed::one()) == compressed::one());
+}
+
 template<typename Fp4T>
 void test_Fp4_tom_cook()
 {
@@ -280,6 +339,8 @@ int main(void)
     test_field<bls12_381_Fq6>();
     test_Frobenius<bls12_381_Fq6>();
     test_all_fields<bls12_381_pp>();
+    test_line_products<bls12_381_Fq12>();
+    test_torus_compression<bls12_381_pp>();
 
     printf("edwards:\n");
     edwards_pp::init_public_params();
@@ -291,18 +352,22 @@ int main(void)
     test_field<alt_bn128_Fq6>();
     test_Frobenius<alt_bn128_Fq6>();
     test_all_fields<alt_bn128_pp>();
+    test_line_products<alt_bn128_Fq12>();
+    test_torus_compression<alt_bn128_pp>();
 
     printf("bw12_446:\n");
     bw12_446_pp::init_public_params();
     test_field<bw12_446_Fq6>();
     test_Frobenius<bw12_446_Fq6>();
     test_all_fields<bw12_446_pp>();
+    test_line_products<bw12_446_Fq12>();
 
     printf("bls12_377:\n");
     bls12_377_pp::init_public_params();
     test_field<bls12_377_Fq6>();
     test_Frobenius<bls12_377_Fq6>();
     test_all_fields<bls12_377_pp>();
+    test_line_products<bls12_377_Fq12>();
 
     printf("sw6:\n");
     sw6_pp::init_public_params();
@@ -313,6 +378,7 @@ int main(void)
     bw6_761_pp::init_public_params();
     test_all_fields<bw6_761_pp>();
     test_cyclotomic_squaring<Fqk<bw6_761_pp> >();
+    test_torus_compression<bw6_761_pp>();
 
     printf("mnt4:\n");
     mnt4_pp::init_public_params();
@@ -320,11 +386,13 @@ int main(void)
     test_Fp4_tom_cook<mnt4_Fq4>();
     test_two_squarings<Fqe<mnt4_pp> >();
     test_cyclotomic_squaring<Fqk<mnt4_pp> >();
+    test_torus_compression<mnt4_pp>();
 
     printf("mnt6:\n");
     mnt6_pp::init_public_params();
     test_all_fields<mnt6_pp>();
     test_cyclotomic_squaring<Fqk<mnt6_pp> >();
+    test_torus_compression<mnt6_pp>();
 
     printf("pendulum:\n");
     pendulum_pp::init_public_params();
@@ -341,6 +409,7 @@ int main(void)
     printf("mnt6753:\n");
     mnt6753_pp::init_public_params();
     test_all_fields<mnt6753_pp>();
+    test_torus_compression<mnt6753_pp>();
 
     printf("toy_curve:\n");
     toy_curve_pp::init_public_params();
@@ -0,0 +1,104 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of interfaces for the compression of elements of the cyclotomic
+ subgroup of a quadratic extension field, such as the target group GT of a
+ pairing, to half their size (the algebraic torus T2).
+
+ Let F = E[W]/(W^2-non_residue) be the quadratic extension of E (e.g.
+ Fp12 = Fp6[W], Fp6 = Fp3[Y], Fp4 = Fp2[V]). An element g = a + b*W of norm 1,
+ i.e. a^2 - non_residue*b^2 = 1, which includes every element of GT, is
+ determined by the single element t = (1+a)/b of E:
+
+   g = (t + W) / (t - W).
+
+ The element g = 1 has no such t and is represented by a flag instead;
+ g = -1 is represented by t = 0.
+
+ Exponentiation and multiplication work on t directly:
+
+   t1 * t2 = (t1*t2 + non_residue) / (t1 + t2),   t^2 = (t^2 + non_residue) / (2t).
+
+ Exponentiation keeps t as a fraction X/Z during the square-and-multiply
+ and inverts once at the end.
+
+ Compressing or decompressing an element costs one inversion in E; the
+ batch versions share a single inversion between all elements.
+
+ Only elements of norm 1 can be compressed; the result of compressing any
+ other element is meaningless (and is caught by an assertion in DEBUG
+ builds).
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef TORUS_HPP_
+#define TORUS_HPP_
+
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+#include <libff/algebra/curves/public_params.hpp>
+#include <libff/algebra/fields/bigint.hpp>
+
+namespace libff {
+
+template<typename FieldT>
+class torus_compressed;
+
+template<typename FieldT>
+std::ostream& operator<<(std::ostream &out, const torus_compressed<FieldT> &el);
+
+template<typename FieldT>
+std::istream& operator>>(std::istream &in, torus_compressed<FieldT> &el);
+
+template<typename FieldT>
+class torus_compressed {
+public:
+    /* the subfield E of which FieldT is the quadratic extension */
+    typedef typename std::decay<decltype(FieldT::c0)>::type my_Fpe;
+
+    my_Fpe t;
+    bool is_one;
+
+    torus_compressed() : t(my_Fpe::zero()), is_one(true) {}
+
+    static torus_compressed<FieldT> one() { return torus_compressed<FieldT>(); }
+
+    static torus_compressed<FieldT> compress(const FieldT &el);
+    static std::vector<torus_compressed<FieldT> > batch_compress(const std::vector<FieldT> &elts);
+
+    FieldT decompress() const;
+    static std::vector<FieldT> batch_decompress(const std::vector<torus_compressed<FieldT> > &elts);
+
+    bool operator==(const torus_compressed<FieldT> &other) const;
+    bool operator!=(const torus_compressed<FieldT> &other) const;
+
+    /* one inversion in E each */
+    torus_compressed<FieldT> operator*(const torus_compressed<FieldT> &other) const;
+    torus_compressed<FieldT> squared() const;
+    /* the inverse, i.e. the conjugate, of the compressed element */
+    torus_compressed<FieldT> unitary_inverse() const;
+
+    template<mp_size_t m>
+    torus_compressed<FieldT> operator^(const bigint<m> &exponent) const;
+
+    static size_t size_in_bits() { return 1 + (FieldT::extension_degree() / 2) * FieldT::my_Fp::size_in_bits(); }
+
+    friend std::ostream& operator<< <FieldT>(std::ostream &out, const torus_compressed<FieldT> &el);
+    friend std::istream& operator>> <FieldT>(std::istream &in, torus_compressed<FieldT> &el);
+};
+
+/* compressed elements of the target group of curve EC_ppT */
+template<typename EC_ppT>
+using compressed_GT = torus_compressed<GT<EC_ppT> >;
+
+} // libff
+
+#include <libff/algebra/fields/torus.tcc>
+
+#endif // TORUS_HPP_
@@ -0,0 +1,264 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of interfaces for the compression of elements of the
+ cyclotomic subgroup of a quadratic extension field.
+
+ See torus.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef TORUS_TCC_
+#define TORUS_TCC_
+
+#include <cassert>
+#include <stdexcept>
+
+#include <libff/algebra/fields/field_utils.hpp>
+#include <libff/common/serialization.hpp>
+
+namespace libff {
+
+template<typename FieldT>
+torus_compressed<FieldT> torus_compressed<FieldT>::compress(const FieldT &el)
+{
+#ifdef DEBUG
+    assert(el.c0.squared() - FieldT::mul_by_non_residue(el.c1.squared()) == my_Fpe::one());
+#endif
+    torus_compressed<FieldT> result;
+    if (el.c1.is_zero())
+    {
+        /* the only elements of norm 1 in E are 1 and -1 */
+        if (el.c0 == my_Fpe::one())
+        {
+            return result;
+        }
+        if (el.c0 != -my_Fpe::one())
+        {
+            throw std::invalid_argument("torus_compressed: element is not in the cyclotomic subgroup");
+        }
+    }
+    else
+    {
+        result.t = (my_Fpe::one() + el.c0) * el.c1.inverse();
+    }
+    result.is_one = false;
+    return result;
+}
+
+template<typename FieldT>
+std::vector<torus_compressed<FieldT> > torus_compressed<FieldT>::batch_compress(const std::vector<FieldT> &elts)
+{
+    std::vector<my_Fpe> c1_inv;
+    c1_inv.reserve(elts.size());
+    for (const FieldT &el : elts)
+    {
+        if (!el.c1.is_zero())
+        {
+            c1_inv.emplace_back(el.c1);
+        }
+    }
+    batch_invert(c1_inv);
+
+    std::vector<torus_compressed<FieldT> > result;
+    result.reserve(elts.size());
+    size_t j = 0;
+    for (const FieldT &el : elts)
+    {
+        if (el.c1.is_zero())
+        {
+            result.emplace_back(compress(el));
+        }
+        else
+        {
+#ifdef DEBUG
+            assert(el.c0.squared() - FieldT::mul_by_non_residue(el.c1.squared()) == my_Fpe::one());
+#endif
+            torus_compressed<FieldT> c;
+            c.t = (my_Fpe::one() + el.c0) * c1_inv[j++];
+            c.is_one = false;
+            result.emplace_back(c);
+        }
+    }
+    return result;
+}
+
+template<typename FieldT>
+FieldT torus_compressed<FieldT>::decompress() const
+{
+    if (is_one)
+    {
+        return FieldT::one();
+    }
+
+    /* (t + W)/(t - W) = (t^2 + non_residue + 2t*W) / (t^2 - non_residue) */
+    const my_Fpe t2 = t.squared();
+    const my_Fpe nr = FieldT::mul_by_non_residue(my_Fpe::one());
+    const my_Fpe denom_inv = (t2 - nr).inverse();
+    return FieldT((t2 + nr) * denom_inv, (t + t) * denom_inv);
+}
+
+template<typename FieldT>
+std::vector<FieldT> torus_compressed<FieldT>::batch_decompress(const std::vector<torus_compressed<FieldT> > &elts)
+{
+    const my_Fpe nr = FieldT::mul_by_non_residue(my_Fpe::one());
+
+    std::vector<my_Fpe> denom_inv;
+    denom_inv.reserve(elts.size());
+    for (const torus_compressed<FieldT> &el : elts)
+    {
+        if (!el.is_one)
+        {
+            denom_inv.emplace_back(el.t.squared() - nr);
+        }
+    }
+    batch_invert(denom_inv);
+
+    std::vector<FieldT> result;
+    result.reserve(elts.size());
+    size_t j = 0;
+    for (const torus_compressed<FieldT> &el : elts)
+    {
+        if (el.is_one)
+        {
+            result.emplace_back(FieldT::one());
+        }
+        else
+        {
+            const my_Fpe &inv = denom_inv[j++];
+            result.emplace_back((el.t.squared() + nr) * inv, (el.t + el.t) * inv);
+        }
+    }
+    return result;
+}
+
+template<typename FieldT>
+bool torus_compressed<FieldT>::operator==(const torus_compressed<FieldT> &other) const
+{
+    if (this->is_one || other.is_one)
+    {
+        return this->is_one == other.is_one;
+    }
+    return this->t == other.t;
+}
+
+template<typename FieldT>
+bool torus_compressed<FieldT>::operator!=(const torus_compressed<FieldT> &other) const
+{
+    return !(operator==(other));
+}
+
+template<typename FieldT>
+torus_compressed<FieldT> torus_compressed<FieldT>::operator*(const torus_compressed<FieldT> &other) const
+{
+    if (this->is_one)
+    {
+        return other;
+    }
+    if (other.is_one)
+    {
+        return *this;
+    }
+
+    const my_Fpe denom = this->t + other.t;
+    torus_compressed<FieldT> result;
+    if (!denom.is_zero())
+    {
+        result.t = (this->t * other.t + FieldT::mul_by_non_residue(my_Fpe::one())) * denom.inverse();
+        result.is_one = false;
+    }
+    /* t1 = -t2 means the elements are each other's inverse */
+    return result;
+}
+
+template<typename FieldT>
+torus_compressed<FieldT> torus_compressed<FieldT>::squared() const
+{
+    return (*this) * (*this);
+}
+
+template<typename FieldT>
+torus_compressed<FieldT> torus_compressed<FieldT>::unitary_inverse() const
+{
+    torus_compressed<FieldT> result(*this);
+    result.t = -result.t;
+    return result;
+}
+
+template<typename FieldT>
+template<mp_size_t m>
+torus_compressed<FieldT> torus_compressed<FieldT>::operator^(const bigint<m> &exponent) const
+{
+    if (is_one)
+    {
+        return *this;
+    }
+
+    /* the result is X/Z, where Z = 0 stands for 1 */
+    my_Fpe X = my_Fpe::one();
+    my_Fpe Z = my_Fpe::zero();
+
+    bool found_one = false;
+    for (long i = exponent.max_bits() - 1; i >= 0; --i)
+    {
+        if (found_one)
+        {
+            /* (X/Z)^2 = (X^2 + nr*Z^2) / (2*X*Z) */
+            const my_Fpe XZ = X * Z;
+            X = X.squared() + FieldT::mul_by_non_residue(Z.squared());
+            Z = XZ + XZ;
+        }
+
+        if (exponent.test_bit(i))
+        {
+            if (!found_one)
+            {
+                X = t;
+                Z = my_Fpe::one();
+                found_one = true;
+            }
+            else
+            {
+                /* (X/Z) * t = (X*t + nr*Z) / (X + Z*t) */
+                const my_Fpe newX = X * t + FieldT::mul_by_non_residue(Z);
+                Z = X + Z * t;
+                X = newX;
+            }
+        }
+    }
+
+    torus_compressed<FieldT> result;
+    if (!Z.is_zero())
+    {
+        result.t = X * Z.inverse();
+        result.is_one = false;
+    }
+    return result;
+}
+
+template<typename FieldT>
+std::ostream& operator<<(std::ostream &out, const torus_compressed<FieldT> &el)
+{
+    out << (el.is_one ? 1 : 0) << OUTPUT_SEPARATOR << el.t;
+    return out;
+}
+
+template<typename FieldT>
+std::istream& operator>>(std::istream &in, torus_compressed<FieldT> &el)
+{
+    char is_one;
+    in.read(&is_one, 1);
+    is_one -= '0';
+    consume_OUTPUT_SEPARATOR(in);
+    in >> el.t;
+    el.is_one = (is_one != 0);
+    return in;
+}
+
+} // libff
+
+#endif // TORUS_TCC_
@@ -13,8 +13,12 @@
 #define MULTIEXP_HPP_
 
 #include <cstddef>
+#include <functional>
 #include <vector>
 
+#include <libff/common/async.hpp>
+#include <libff/common/memory_accounting.hpp>
+
 namespace libff {
 
 enum multi_exp_method {
@@ -43,7 +47,18 @@ enum multi_exp_method {
   * Requires that T implements .dbl() (and, if USE_MIXED_ADDITION is defined,
   * .to_special(), .mixed_add(), and batch_to_special()).
   */
- multi_exp_method_BDLO12
+ multi_exp_method_BDLO12,
+ /**
+  * A variant of multi_exp_method_BDLO12 for sparse witnesses with many small
+  * scalars (booleans, bytes, range-checked words). Scalars are classified by
+  * bit-length: zeros are skipped, ones are added directly, and each remaining
+  * class is handled by its own bucket pass whose window and number of
+  * windows are sized for that class, so short scalars never pay for the
+  * full-width windows. The passes work through index lists into the input,
+  * without copying bases or scalars. Has the same requirements on T as
+  * multi_exp_method_BDLO12.
+  */
+ multi_exp_method_BDLO12_small_scalars
 };
 
 /**
@@ -52,6 +67,11 @@ enum multi_exp_method {
  * using the selected method.
  * Input is split into the given number of chunks, and, when compiled with
  * MULTICORE, the chunks are processed in parallel.
+ *
+ * FieldT may also be bigint<n>, in which case the scalars are assumed to be
+ * in canonical form already (see batch_as_bigint in field_utils.hpp) and are
+ * not converted again. The same holds for multi_exp_with_mixed_addition,
+ * windowed_exp and batch_exp.
  */
 template<typename T, typename FieldT, multi_exp_method Method>
 T multi_exp(typename std::vector<T>::const_iterator vec_start,
@@ -74,6 +94,92 @@ T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_star
                                 typename std::vector<FieldT>::const_iterator scalar_end,
                                 const size_t chunks);
 
+/**
+ * How multi_exp_numa places the input on the NUMA nodes.
+ */
+enum numa_placement {
+ /* leave the memory where it is (e.g. because the caller already placed it) */
+ numa_placement_none,
+ /**
+  * bind the slice of the bases and scalars processed by a node to that node
+  * (see numa_bind_memory), migrating the pages; a vector that is used
+  * repeatedly stays placed for later calls. This permanently changes the
+  * memory policy of the caller's vectors, so it is only done on request.
+  */
+ numa_placement_bind,
+ /**
+  * each worker copies its chunk into memory it allocates, and thus first
+  * touches, itself; costs a copy per call but needs no kernel support for
+  * migration
+  */
+ numa_placement_first_touch
+};
+
+/**
+ * A variant of multi_exp for machines with several NUMA nodes (see numa.hpp).
+ * The input is split into one contiguous slice per node, in proportion to
+ * the number of CPUs of the node, and each slice is processed by executor
+ * threads pinned to its node (see numa_run_on_nodes), so that every node
+ * only reads bases from its own memory; by default the threads copy their
+ * chunks, and the caller's memory is only migrated with numa_placement_bind.
+ * A slice is split into chunks_per_node chunks (0: one per CPU of the
+ * node), which the threads of the group take in turn; the partial
+ * results are summed per node and then across nodes. Runs multi_exp on the
+ * executor if there is only one node. Reports progress and is cancelled like
+ * multi_exp, but the progress callback is only invoked on completion.
+ */
+template<typename T, typename FieldT, multi_exp_method Method>
+T multi_exp_numa(typename std::vector<T>::const_iterator vec_start,
+                 typename std::vector<T>::const_iterator vec_end,
+                 typename std::vector<FieldT>::const_iterator scalar_start,
+                 typename std::vector<FieldT>::const_iterator scalar_end,
+                 const size_t chunks_per_node = 0,
+                 const numa_placement placement = numa_placement_first_touch);
+
+/**
+ * Computes several multi-exponentiations over the same bases at once, i.e.,
+ * for every scalar vector s in scalars, the sum
+ * \sum_i s[i] * vec_start[i].
+ * Every scalar vector must have exactly (vec_end - vec_start) entries.
+ * Uses the bucket method of multi_exp_method_BDLO12, but walks the bases once
+ * per window and updates one set of buckets per scalar vector, so each base
+ * is read from memory once per window instead of once per scalar vector.
+ * Chunking and parallelism are as in multi_exp.
+ */
+template<typename T, typename FieldT>
+std::vector<T> multi_exp_batch(typename std::vector<T>::const_iterator vec_start,
+                               typename std::vector<T>::const_iterator vec_end,
+                               const std::vector<std::vector<FieldT> > &scalars,
+                               const size_t chunks);
+
+/**
+ * Supplies the input of multi_exp_stream block by block. A call must replace
+ * the contents of bases and scalars with (at most max_count) consecutive
+ * entries starting at position offset of the input, and return how many
+ * entries it provided; returning 0 signals the end of the input.
+ * Calls are never concurrent, but may come from a helper thread.
+ */
+template<typename T, typename FieldT>
+using multi_exp_stream_reader = std::function<size_t(const size_t offset,
+                                                     const size_t max_count,
+                                                     std::vector<T> &bases,
+                                                     std::vector<FieldT> &scalars)>;
+
+/**
+ * Computes the same sum as multi_exp, for inputs too large to be held in
+ * memory. The bases and scalars are pulled from the reader in blocks of
+ * block_size entries and the next block is read by a task on the executor
+ * while the current one is added into the buckets. Only the buckets of all
+ * windows (as in multi_exp_method_BDLO12) and two blocks are resident at any
+ * time. expected_length is only used to choose the window size, which is
+ * reduced until the buckets fit in the memory budget. When compiled with
+ * MULTICORE, the windows of a block are processed in parallel.
+ */
+template<typename T, typename FieldT>
+T multi_exp_stream(const multi_exp_stream_reader<T, FieldT> &reader,
+                   const size_t expected_length,
+                   const size_t block_size);
+
 /**
  * A convenience function for calculating a pure inner product, where the
  * more complicated methods are not required.
@@ -92,12 +198,21 @@ using window_table = std::vector<std::vector<T> >;
 
 /**
  * Compute window size for the given number of scalars.
+ * If a memory budget is set (see memory_accounting.hpp), the window is reduced
+ * until the window table fits in the remaining budget.
  */
 template<typename T>
 size_t get_exp_window_size(const size_t num_scalars);
 
+/**
+ * Memory taken by the window table of the given window size.
+ */
+template<typename T>
+size_t window_table_size_in_bytes(const size_t scalar_size, const size_t window);
+
 /**
  * Compute table of window sizes.
+ * The table is accounted under mem_tag_window_table while it is built.
  */
 template<typename T>
 window_table<T> get_window_table(const size_t scalar_size,
@@ -110,6 +225,12 @@ T windowed_exp(const size_t scalar_size,
                const window_table<T> &powers_of_g,
                const FieldT &pow);
 
+/**
+ * batch_exp, batch_exp_with_coeff, batch_exp_affine and chunked multi_exp report
+ * progress to, and can be cancelled through, the callback and token registered
+ * by the calling thread (see progress.hpp). A cancelled operation throws
+ * operation_cancelled.
+ */
 template<typename T, typename FieldT>
 std::vector<T> batch_exp(const size_t scalar_size,
                          const size_t window,
@@ -123,9 +244,42 @@ std::vector<T> batch_exp_with_coeff(const size_t scalar_size,
                                     const FieldT &coeff,
                                     const std::vector<FieldT> &v);
 
+/**
+ * A variant of batch_exp that returns its results in special form.
+ * The outputs are produced in fixed-size blocks and each block is normalized
+ * (sharing a single inversion) as soon as it has been computed, so there is no
+ * separate batch_to_special pass over the whole result vector.
+ */
+template<typename T, typename FieldT>
+std::vector<T> batch_exp_affine(const size_t scalar_size,
+                                const size_t window,
+                                const window_table<T> &table,
+                                const std::vector<FieldT> &v);
+
 template<typename T>
 void batch_to_special(std::vector<T> &vec);
 
+/**
+ * Asynchronous variants of multi_exp and batch_exp (see async.hpp): the
+ * computation is submitted to the executor and starts once deps have
+ * completed. The vectors (and window table) passed in must stay alive, and
+ * unchanged, until the result is ready.
+ */
+template<typename T, typename FieldT, multi_exp_method Method>
+async_value<T> multi_exp_async(typename std::vector<T>::const_iterator vec_start,
+                               typename std::vector<T>::const_iterator vec_end,
+                               typename std::vector<FieldT>::const_iterator scalar_start,
+                               typename std::vector<FieldT>::const_iterator scalar_end,
+                               const size_t chunks,
+                               const std::vector<async_handle> &deps = std::vector<async_handle>());
+
+template<typename T, typename FieldT>
+async_value<std::vector<T> > batch_exp_async(const size_t scalar_size,
+                                             const size_t window,
+                                             const window_table<T> &table,
+                                             const std::vector<FieldT> &v,
+                                             const std::vector<async_handle> &deps = std::vector<async_handle>());
+
 } // libff
 
 #include <libff/algebra/scalar_multiplication/multiexp.tcc>
@@ -15,18 +15,79 @@
 #define MULTIEXP_TCC_
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <type_traits>
 
 #include <libff/algebra/fields/bigint.hpp>
 #include <libff/algebra/fields/fp_aux.tcc>
 #include <libff/algebra/scalar_multiplication/multiexp.hpp>
 #include <libff/algebra/scalar_multiplication/wnaf.hpp>
+#include <libff/common/execution.hpp>
+#include <libff/common/memory_accounting.hpp>
+#include <libff/common/numa.hpp>
 #include <libff/common/profiling.hpp>
+#include <libff/common/progress.hpp>
+#include <libff/common/tracing.hpp>
 #include <libff/common/utils.hpp>
 
 namespace libff {
 
+/**
+ * multi_exp_scalar<FieldT> lets the routines below accept scalars either as
+ * field elements or as bigints that are already in canonical (i.e., not
+ * Montgomery) form. In the latter case no per-call conversion is performed.
+ */
+template<typename FieldT>
+struct multi_exp_scalar {
+    static const mp_size_t num_limbs = FieldT::num_limbs;
+    typedef bigint<num_limbs> bigint_type;
+
+    static size_t num_bits() { return FieldT::size_in_bits(); }
+    static bigint_type as_bigint(const FieldT &s) { return s.as_bigint(); }
+    static FieldT zero() { return FieldT::zero(); }
+    static FieldT one() { return FieldT::one(); }
+
+    static typename std::vector<bigint_type>::const_iterator as_bigints(
+        typename std::vector<FieldT>::const_iterator scalar_start,
+        typename std::vector<FieldT>::const_iterator scalar_end,
+        std::vector<bigint_type> &storage)
+    {
+        storage.clear();
+        storage.reserve(scalar_end - scalar_start);
+        for (auto it = scalar_start; it != scalar_end; ++it)
+        {
+            storage.emplace_back(it->as_bigint());
+        }
+        return storage.cbegin();
+    }
+};
+
+template<mp_size_t n>
+struct multi_exp_scalar<bigint<n> > {
+    static const mp_size_t num_limbs = n;
+    typedef bigint<n> bigint_type;
+
+    static size_t num_bits() { return n * GMP_NUMB_BITS; }
+    static const bigint_type& as_bigint(const bigint<n> &s) { return s; }
+    static bigint<n> zero() { return bigint<n>(0ul); }
+    static bigint<n> one() { return bigint<n>(1ul); }
+
+    static typename std::vector<bigint_type>::const_iterator as_bigints(
+        typename std::vector<bigint<n> >::const_iterator scalar_start,
+        typename std::vector<bigint<n> >::const_iterator scalar_end,
+        std::vector<bigint_type> &storage)
+    {
+        UNUSED(scalar_end, storage);
+        return scalar_start;
+    }
+};
+
 template<mp_size_t n>
 class ordered_exponent {
 // to use std::push_heap and friends later
@@ -42,7 +103,7 @@ public:
         if (n == 3)
         {
             long res;
-            __asm__
+            __asm__ volatile
                 ("// check for overflow           \n\t"
                  "mov $0, %[res]                  \n\t"
                  ADD_CMP(16)
@@ -54,13 +115,13 @@ public:
                  "done%=:                         \n\t"
                  : [res] "=&r" (res)
                  : [A] "r" (other.r.data), [mod] "r" (this->r.data)
-                 : "cc", "%rax");
+                 : "cc", "memory", "%rax");
             return res;
         }
         else if (n == 4)
         {
             long res;
-            __asm__
+            __asm__ volatile
                 ("// check for overflow           \n\t"
                  "mov $0, %[res]                  \n\t"
                  ADD_CMP(24)
@@ -73,13 +134,13 @@ public:
                  "done%=:                         \n\t"
                  : [res] "=&r" (res)
                  : [A] "r" (other.r.data), [mod] "r" (this->r.data)
-                 : "cc", "%rax");
+                 : "cc", "memory", "%rax");
             return res;
         }
         else if (n == 5)
         {
             long res;
-            __asm__
+            __asm__ volatile
                 ("// check for overflow           \n\t"
                  "mov $0, %[res]                  \n\t"
                  ADD_CMP(32)
@@ -93,7 +154,7 @@ public:
                  "done%=:                         \n\t"
                  : [res] "=&r" (res)
                  : [A] "r" (other.r.data), [mod] "r" (this->r.data)
-                 : "cc", "%rax");
+                 : "cc", "memory", "%rax");
             return res;
         }
         else
@@ -125,6 +186,7 @@ T multi_exp_inner(
     typename std::vector<FieldT>::const_iterator scalar_start,
     typename std::vector<FieldT>::const_iterator scalar_end)
 {
+    LIBFF_TRACE_SCOPE("multi_exp_inner (naive)");
     T result(T::zero());
 
     typename std::vector<T>::const_iterator vec_it;
@@ -132,7 +194,8 @@ T multi_exp_inner(
 
     for (vec_it = vec_start, scalar_it = scalar_start; vec_it != vec_end; ++vec_it, ++scalar_it)
     {
-        bigint<FieldT::num_limbs> scalar_bigint = scalar_it->as_bigint();
+        const bigint<multi_exp_scalar<FieldT>::num_limbs> scalar_bigint =
+            multi_exp_scalar<FieldT>::as_bigint(*scalar_it);
         result = result + opt_window_wnaf_exp(*vec_it, scalar_bigint, scalar_bigint.num_bits());
     }
     assert(scalar_it == scalar_end);
@@ -148,6 +211,7 @@ T multi_exp_inner(
     typename std::vector<FieldT>::const_iterator scalar_start,
     typename std::vector<FieldT>::const_iterator scalar_end)
 {
+    LIBFF_TRACE_SCOPE("multi_exp_inner (naive_plain)");
     T result(T::zero());
 
     typename std::vector<T>::const_iterator vec_it;
@@ -162,6 +226,20 @@ T multi_exp_inner(
     return result;
 }
 
+/**
+ * Largest window c' <= c for which `copies` arrays of 2^c' buckets fit in the
+ * memory budget (see memory_accounting.hpp).
+ */
+template<typename T>
+size_t bucket_window_within_budget(size_t c, const size_t copies = 1)
+{
+    while (c > 1 && !mem_budget_allows(copies * (sizeof(T) << c)))
+    {
+        --c;
+    }
+    return c;
+}
+
 template<typename T, typename FieldT, multi_exp_method Method,
     typename std::enable_if<(Method == multi_exp_method_BDLO12), int>::type = 0>
 T multi_exp_inner(
@@ -170,21 +248,21 @@ T multi_exp_inner(
     typename std::vector<FieldT>::const_iterator exponents,
     typename std::vector<FieldT>::const_iterator exponents_end)
 {
-    UNUSED(exponents_end);
+    LIBFF_TRACE_SCOPE("multi_exp_inner (BDLO12)");
     size_t length = bases_end - bases;
 
     // empirically, this seems to be a decent estimate of the optimal value of c
     size_t log2_length = log2(length);
-    size_t c = log2_length - (log2_length / 3 - 2);
+    size_t c = bucket_window_within_budget<T>(log2_length - (log2_length / 3 - 2));
 
-    const mp_size_t exp_num_limbs =
-        std::remove_reference<decltype(*exponents)>::type::num_limbs;
-    std::vector<bigint<exp_num_limbs> > bn_exponents(length);
+    // canonical scalars are used in place, field elements are converted once
+    std::vector<typename multi_exp_scalar<FieldT>::bigint_type> bn_storage;
+    const auto bn_exponents =
+        multi_exp_scalar<FieldT>::as_bigints(exponents, exponents_end, bn_storage);
     size_t num_bits = 0;
 
     for (size_t i = 0; i < length; i++)
     {
-        bn_exponents[i] = exponents[i].as_bigint();
         num_bits = std::max(num_bits, bn_exponents[i].num_bits());
     }
 
@@ -205,6 +283,7 @@ T multi_exp_inner(
 
         std::vector<T> buckets(1 << c);
         std::vector<bool> bucket_nonzero(1 << c);
+        mem_scope buckets_mem(mem_tag_multiexp_buckets, buckets.capacity() * sizeof(T));
 
         for (size_t i = 0; i < length; i++)
         {
@@ -281,6 +360,178 @@ T multi_exp_inner(
     return result;
 }
 
+/**
+ * Bucket pass of multi_exp_method_BDLO12 restricted to the bases and scalars
+ * at the given indices, for scalars known to fit in num_bits bits.
+ */
+template<typename T, mp_size_t n>
+T multi_exp_bucket_pass(typename std::vector<T>::const_iterator bases,
+                        typename std::vector<bigint<n> >::const_iterator exponents,
+                        const std::vector<size_t> &indices,
+                        const size_t num_bits)
+{
+    LIBFF_TRACE_SCOPE("multi_exp_bucket_pass");
+    if (indices.empty())
+    {
+        return T::zero();
+    }
+
+    // same estimate as multi_exp_method_BDLO12, but never wider than the scalars
+    size_t log2_length = log2(indices.size());
+    size_t c = bucket_window_within_budget<T>(std::min(log2_length - (log2_length / 3 - 2), num_bits));
+
+    size_t num_groups = (num_bits + c - 1) / c;
+
+    T result = T::zero();
+    bool result_nonzero = false;
+
+    std::vector<T> buckets(1 << c);
+    std::vector<bool> bucket_nonzero(1 << c);
+    mem_scope buckets_mem(mem_tag_multiexp_buckets, buckets.capacity() * sizeof(T));
+
+    for (size_t k = num_groups - 1; k <= num_groups; k--)
+    {
+        if (result_nonzero)
+        {
+            for (size_t i = 0; i < c; i++)
+            {
+                result = result.dbl();
+            }
+        }
+
+        std::fill(bucket_nonzero.begin(), bucket_nonzero.end(), false);
+
+        for (const size_t i : indices)
+        {
+            size_t id = 0;
+            for (size_t j = 0; j < c; j++)
+            {
+                if (exponents[i].test_bit(k*c + j))
+                {
+                    id |= 1 << j;
+                }
+            }
+
+            if (id == 0)
+            {
+                continue;
+            }
+
+            if (bucket_nonzero[id])
+            {
+#ifdef USE_MIXED_ADDITION
+                buckets[id] = buckets[id].mixed_add(bases[i]);
+#else
+                buckets[id] = buckets[id] + bases[i];
+#endif
+            }
+            else
+            {
+                buckets[id] = bases[i];
+                bucket_nonzero[id] = true;
+            }
+        }
+
+        T running_sum = T::zero();
+        bool running_sum_nonzero = false;
+
+        for (size_t i = (1u << c) - 1; i > 0; i--)
+        {
+            if (bucket_nonzero[i])
+            {
+                if (running_sum_nonzero)
+                {
+                    running_sum = running_sum + buckets[i];
+                }
+                else
+                {
+                    running_sum = buckets[i];
+                    running_sum_nonzero = true;
+                }
+            }
+
+            if (running_sum_nonzero)
+            {
+                if (result_nonzero)
+                {
+                    result = result + running_sum;
+                }
+                else
+                {
+                    result = running_sum;
+                    result_nonzero = true;
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+template<typename T, typename FieldT, multi_exp_method Method,
+    typename std::enable_if<(Method == multi_exp_method_BDLO12_small_scalars), int>::type = 0>
+T multi_exp_inner(
+    typename std::vector<T>::const_iterator bases,
+    typename std::vector<T>::const_iterator bases_end,
+    typename std::vector<FieldT>::const_iterator exponents,
+    typename std::vector<FieldT>::const_iterator exponents_end)
+{
+    LIBFF_TRACE_SCOPE("multi_exp_inner (BDLO12_small_scalars)");
+    const size_t length = bases_end - bases;
+
+    std::vector<typename multi_exp_scalar<FieldT>::bigint_type> bn_storage;
+    const auto bn_exponents =
+        multi_exp_scalar<FieldT>::as_bigints(exponents, exponents_end, bn_storage);
+
+    /* bit-length classes; scalars wider than the last one form the full-width class */
+    const size_t class_bits[] = { 8, 32, 64 };
+    const size_t num_classes = ARRAY_SIZE(class_bits) + 1;
+    std::vector<std::vector<size_t> > class_indices(num_classes);
+    size_t full_num_bits = 0;
+
+    T acc = T::zero();
+
+    for (size_t i = 0; i < length; ++i)
+    {
+        const size_t bits = bn_exponents[i].num_bits();
+        if (bits == 0)
+        {
+            continue;
+        }
+
+        if (bits == 1)
+        {
+#ifdef USE_MIXED_ADDITION
+            acc = acc.mixed_add(bases[i]);
+#else
+            acc = acc + bases[i];
+#endif
+            continue;
+        }
+
+        size_t cls = 0;
+        while (cls < num_classes - 1 && bits > class_bits[cls])
+        {
+            ++cls;
+        }
+        class_indices[cls].emplace_back(i);
+
+        if (cls == num_classes - 1)
+        {
+            full_num_bits = std::max(full_num_bits, bits);
+        }
+    }
+
+    for (size_t cls = 0; cls < num_classes; ++cls)
+    {
+        const size_t num_bits = (cls == num_classes - 1 ? full_num_bits : class_bits[cls]);
+        acc = acc + multi_exp_bucket_pass<T, multi_exp_scalar<FieldT>::num_limbs>(
+            bases, bn_exponents, class_indices[cls], num_bits);
+    }
+
+    return acc;
+}
+
 template<typename T, typename FieldT, multi_exp_method Method,
     typename std::enable_if<(Method == multi_exp_method_bos_coster), int>::type = 0>
 T multi_exp_inner(
@@ -289,7 +540,8 @@ T multi_exp_inner(
     typename std::vector<FieldT>::const_iterator scalar_start,
     typename std::vector<FieldT>::const_iterator scalar_end)
 {
-    const mp_size_t n = std::remove_reference<decltype(*scalar_start)>::type::num_limbs;
+    LIBFF_TRACE_SCOPE("multi_exp_inner (bos_coster)");
+    const mp_size_t n = multi_exp_scalar<FieldT>::num_limbs;
 
     if (vec_start == vec_end)
     {
@@ -298,7 +550,7 @@ T multi_exp_inner(
 
     if (vec_start + 1 == vec_end)
     {
-        return (*scalar_start)*(*vec_start);
+        return multi_exp_scalar<FieldT>::as_bigint(*scalar_start) * (*vec_start);
     }
 
     std::vector<ordered_exponent<n> > opt_q;
@@ -307,6 +559,8 @@ T multi_exp_inner(
     opt_q.reserve(odd_vec_len);
     std::vector<T> g;
     g.reserve(odd_vec_len);
+    mem_scope copies_mem(mem_tag_multiexp_copies,
+                         odd_vec_len * (sizeof(T) + sizeof(ordered_exponent<n>)));
 
     typename std::vector<T>::const_iterator vec_it;
     typename std::vector<FieldT>::const_iterator scalar_it;
@@ -315,7 +569,7 @@ T multi_exp_inner(
     {
         g.emplace_back(*vec_it);
 
-        opt_q.emplace_back(ordered_exponent<n>(i, scalar_it->as_bigint()));
+        opt_q.emplace_back(ordered_exponent<n>(i, multi_exp_scalar<FieldT>::as_bigint(*scalar_it)));
     }
     std::make_heap(opt_q.begin(),opt_q.end());
     assert(scalar_it == scalar_end);
@@ -406,6 +660,7 @@ T multi_exp(typename std::vector<T>::const_iterator vec_start,
             typename std::vector<FieldT>::const_iterator scalar_end,
             const size_t chunks)
 {
+    LIBFF_TRACE_SCOPE("multi_exp");
     const size_t total = vec_end - vec_start;
     if ((total < chunks) || (chunks == 1))
     {
@@ -417,18 +672,22 @@ T multi_exp(typename std::vector<T>::const_iterator vec_start,
     const size_t one = total/chunks;
 
     std::vector<T> partial(chunks, T::zero());
+    progress_reporter progress("multi_exp", chunks);
 
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-    for (size_t i = 0; i < chunks; ++i)
-    {
+    parallel_for(0, chunks, [&](const size_t i) {
+        if (progress.cancelled())
+        {
+            return;
+        }
         partial[i] = multi_exp_inner<T, FieldT, Method>(
              vec_start + i*one,
              (i == chunks-1 ? vec_end : vec_start + (i+1)*one),
              scalar_start + i*one,
              (i == chunks-1 ? scalar_end : scalar_start + (i+1)*one));
-    }
+        progress.advance();
+    });
+
+    progress.finish();
 
     T final = T::zero();
 
@@ -447,13 +706,14 @@ T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_star
                                 typename std::vector<FieldT>::const_iterator scalar_end,
                                 const size_t chunks)
 {
+    LIBFF_TRACE_SCOPE("multi_exp_with_mixed_addition");
     assert(std::distance(vec_start, vec_end) == std::distance(scalar_start, scalar_end));
     enter_block("Process scalar vector");
     auto value_it = vec_start;
     auto scalar_it = scalar_start;
 
-    const FieldT zero = FieldT::zero();
-    const FieldT one = FieldT::one();
+    const FieldT zero = multi_exp_scalar<FieldT>::zero();
+    const FieldT one = multi_exp_scalar<FieldT>::one();
     std::vector<FieldT> p;
     std::vector<T> g;
 
@@ -486,15 +746,459 @@ T multi_exp_with_mixed_addition(typename std::vector<T>::const_iterator vec_star
             ++num_other;
         }
     }
-    print_indent(); printf("* Elements of w skipped: %zu (%0.2f%%)\n", num_skip, 100.*num_skip/(num_skip+num_add+num_other));
-    print_indent(); printf("* Elements of w processed with special addition: %zu (%0.2f%%)\n", num_add, 100.*num_add/(num_skip+num_add+num_other));
-    print_indent(); printf("* Elements of w remaining: %zu (%0.2f%%)\n", num_other, 100.*num_other/(num_skip+num_add+num_other));
+    if (!inhibit_profiling_info)
+    {
+        print_indent(); printf("* Elements of w skipped: %zu (%0.2f%%)\n", num_skip, 100.*num_skip/(num_skip+num_add+num_other));
+        print_indent(); printf("* Elements of w processed with special addition: %zu (%0.2f%%)\n", num_add, 100.*num_add/(num_skip+num_add+num_other));
+        print_indent(); printf("* Elements of w remaining: %zu (%0.2f%%)\n", num_other, 100.*num_other/(num_skip+num_add+num_other));
+    }
 
     leave_block("Process scalar vector");
 
+    mem_scope copies_mem(mem_tag_multiexp_copies, g.capacity() * sizeof(T) + p.capacity() * sizeof(FieldT));
+
     return acc + multi_exp<T, FieldT, Method>(g.begin(), g.end(), p.begin(), p.end(), chunks);
 }
 
+template<typename T, typename FieldT, multi_exp_method Method>
+T multi_exp_numa(typename std::vector<T>::const_iterator vec_start,
+                 typename std::vector<T>::const_iterator vec_end,
+                 typename std::vector<FieldT>::const_iterator scalar_start,
+                 typename std::vector<FieldT>::const_iterator scalar_end,
+                 const size_t chunks_per_node,
+                 const numa_placement placement)
+{
+    LIBFF_TRACE_SCOPE("multi_exp_numa");
+    const std::vector<numa_node> nodes = get_numa_nodes();
+    const size_t total = vec_end - vec_start;
+    if (nodes.size() <= 1)
+    {
+        const size_t chunks = (chunks_per_node == 0 ? get_executor()->concurrency() : chunks_per_node);
+        return multi_exp<T, FieldT, Method>(vec_start, vec_end, scalar_start, scalar_end, std::max<size_t>(1, chunks));
+    }
+
+    const std::vector<size_t> bounds = numa_partition(total, nodes);
+    if (placement == numa_placement_bind)
+    {
+        for (size_t k = 0; k < nodes.size(); ++k)
+        {
+            const size_t n = bounds[k+1] - bounds[k];
+            if (n > 0)
+            {
+                numa_bind_memory(&*(vec_start + bounds[k]), n * sizeof(T), nodes[k]);
+                numa_bind_memory(&*(scalar_start + bounds[k]), n * sizeof(FieldT), nodes[k]);
+            }
+        }
+    }
+
+    std::vector<size_t> num_chunks(nodes.size());
+    std::vector<std::vector<T> > partial(nodes.size());
+    std::unique_ptr<std::atomic<size_t>[]> next_chunk(new std::atomic<size_t>[nodes.size()]);
+    size_t all_chunks = 0;
+    for (size_t k = 0; k < nodes.size(); ++k)
+    {
+        num_chunks[k] = (chunks_per_node == 0 ? std::max<size_t>(1, nodes[k].cpus.size()) : chunks_per_node);
+        partial[k].resize(num_chunks[k], T::zero());
+        next_chunk[k].store(0);
+        all_chunks += num_chunks[k];
+    }
+
+    progress_reporter progress("multi_exp", all_chunks);
+
+    numa_run_on_nodes(nodes, [&](const size_t k, const size_t, const size_t) {
+        const size_t n = bounds[k+1] - bounds[k];
+        while (true)
+        {
+            const size_t i = next_chunk[k].fetch_add(1);
+            if (i >= num_chunks[k] || progress.cancelled())
+            {
+                return;
+            }
+
+            const size_t from = bounds[k] + n * i / num_chunks[k];
+            const size_t to = bounds[k] + n * (i+1) / num_chunks[k];
+            if (from < to && placement == numa_placement_first_touch)
+            {
+                mem_scope copies_scope(mem_tag_multiexp_copies, (to - from) * (sizeof(T) + sizeof(FieldT)));
+                const std::vector<T> local_bases(vec_start + from, vec_start + to);
+                const std::vector<FieldT> local_scalars(scalar_start + from, scalar_start + to);
+                partial[k][i] = multi_exp_inner<T, FieldT, Method>(
+                    local_bases.cbegin(), local_bases.cend(), local_scalars.cbegin(), local_scalars.cend());
+            }
+            else if (from < to)
+            {
+                partial[k][i] = multi_exp_inner<T, FieldT, Method>(
+                    vec_start + from, vec_start + to, scalar_start + from, scalar_start + to);
+            }
+            progress.advance();
+        }
+    });
+
+    progress.finish();
+
+    /* sum per node, then across nodes */
+    T final = T::zero();
+    for (size_t k = 0; k < nodes.size(); ++k)
+    {
+        T node_sum = T::zero();
+        for (size_t i = 0; i < num_chunks[k]; ++i)
+        {
+            node_sum = node_sum + partial[k][i];
+        }
+        final = final + node_sum;
+    }
+
+    return final;
+}
+
+template<typename T, typename FieldT>
+std::vector<T> multi_exp_batch_inner(typename std::vector<T>::const_iterator bases,
+                                     typename std::vector<T>::const_iterator bases_end,
+                                     const std::vector<std::vector<FieldT> > &scalars,
+                                     const size_t offset)
+{
+    LIBFF_TRACE_SCOPE("multi_exp_batch_inner");
+    typedef typename multi_exp_scalar<FieldT>::bigint_type bigint_type;
+
+    const size_t length = bases_end - bases;
+    const size_t batch_size = scalars.size();
+
+    // empirically, this seems to be a decent estimate of the optimal value of c
+    size_t log2_length = log2(length);
+    size_t c = bucket_window_within_budget<T>(log2_length - (log2_length / 3 - 2), batch_size);
+
+    std::vector<std::vector<bigint_type> > bn_storage(batch_size);
+    std::vector<typename std::vector<bigint_type>::const_iterator> bn_exponents;
+    bn_exponents.reserve(batch_size);
+    size_t num_bits = 0;
+
+    for (size_t s = 0; s < batch_size; ++s)
+    {
+        assert(scalars[s].size() >= offset + length);
+        bn_exponents.emplace_back(multi_exp_scalar<FieldT>::as_bigints(
+            scalars[s].cbegin() + offset, scalars[s].cbegin() + offset + length, bn_storage[s]));
+        for (size_t i = 0; i < length; i++)
+        {
+            num_bits = std::max(num_bits, bn_exponents[s][i].num_bits());
+        }
+    }
+
+    const size_t num_groups = (num_bits + c - 1) / c;
+
+    std::vector<T> result(batch_size, T::zero());
+    std::vector<std::vector<T> > buckets(batch_size, std::vector<T>(1 << c));
+    std::vector<std::vector<bool> > bucket_nonzero(batch_size, std::vector<bool>(1 << c));
+    mem_scope buckets_mem(mem_tag_multiexp_buckets, batch_size * (sizeof(T) << c));
+
+    for (size_t k = num_groups - 1; k <= num_groups; k--)
+    {
+        for (size_t s = 0; s < batch_size; ++s)
+        {
+            for (size_t i = 0; i < c; i++)
+            {
+                result[s] = result[s].dbl();
+            }
+            std::fill(bucket_nonzero[s].begin(), bucket_nonzero[s].end(), false);
+        }
+
+        for (size_t i = 0; i < length; i++)
+        {
+            const T &base = bases[i];
+
+            for (size_t s = 0; s < batch_size; ++s)
+            {
+                size_t id = 0;
+                for (size_t j = 0; j < c; j++)
+                {
+                    if (bn_exponents[s][i].test_bit(k*c + j))
+                    {
+                        id |= 1 << j;
+                    }
+                }
+
+                if (id == 0)
+                {
+                    continue;
+                }
+
+                if (bucket_nonzero[s][id])
+                {
+#ifdef USE_MIXED_ADDITION
+                    buckets[s][id] = buckets[s][id].mixed_add(base);
+#else
+                    buckets[s][id] = buckets[s][id] + base;
+#endif
+                }
+                else
+                {
+                    buckets[s][id] = base;
+                    bucket_nonzero[s][id] = true;
+                }
+            }
+        }
+
+        for (size_t s = 0; s < batch_size; ++s)
+        {
+            T running_sum = T::zero();
+
+            for (size_t i = (1u << c) - 1; i > 0; i--)
+            {
+                if (bucket_nonzero[s][i])
+                {
+                    running_sum = running_sum + buckets[s][i];
+                }
+                result[s] = result[s] + running_sum;
+            }
+        }
+    }
+
+    return result;
+}
+
+template<typename T, typename FieldT>
+std::vector<T> multi_exp_batch(typename std::vector<T>::const_iterator vec_start,
+                               typename std::vector<T>::const_iterator vec_end,
+                               const std::vector<std::vector<FieldT> > &scalars,
+                               const size_t chunks)
+{
+    LIBFF_TRACE_SCOPE("multi_exp_batch");
+    const size_t total = vec_end - vec_start;
+    for (const std::vector<FieldT> &v : scalars)
+    {
+        assert(v.size() == total);
+        UNUSED(v);
+    }
+
+    if ((total < chunks) || (chunks == 1))
+    {
+        return multi_exp_batch_inner<T, FieldT>(vec_start, vec_end, scalars, 0);
+    }
+
+    const size_t one = total/chunks;
+
+    std::vector<std::vector<T> > partial(chunks);
+
+    parallel_for(0, chunks, [&](const size_t i) {
+        partial[i] = multi_exp_batch_inner<T, FieldT>(
+             vec_start + i*one,
+             (i == chunks-1 ? vec_end : vec_start + (i+1)*one),
+             scalars,
+             i*one);
+    });
+
+    std::vector<T> final(scalars.size(), T::zero());
+
+    for (size_t i = 0; i < chunks; ++i)
+    {
+        for (size_t s = 0; s < scalars.size(); ++s)
+        {
+            final[s] = final[s] + partial[i][s];
+        }
+    }
+
+    return final;
+}
+
+/**
+ * The read of the next block of multi_exp_stream, submitted to the executor.
+ * Whichever of the task and get() comes first runs the read, so waiting for
+ * it never blocks on a task that has not started (the executor may be busy,
+ * or be the pool the caller runs on).
+ */
+class multi_exp_stream_prefetch {
+private:
+    std::function<size_t()> read;
+    std::atomic<bool> claimed;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done;
+    size_t count;
+    std::exception_ptr error;
+
+    void run()
+    {
+        try
+        {
+            count = read();
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        cv.notify_all();
+    }
+public:
+    multi_exp_stream_prefetch(const std::function<size_t()> &read) :
+        read(read), claimed(false), done(false), count(0) {}
+
+    static std::shared_ptr<multi_exp_stream_prefetch> start(const std::function<size_t()> &read)
+    {
+        const std::shared_ptr<multi_exp_stream_prefetch> p = std::make_shared<multi_exp_stream_prefetch>(read);
+        /* the task keeps the state alive, but no longer touches read once get() has claimed it */
+        get_executor()->submit([p]() {
+            if (!p->claimed.exchange(true))
+            {
+                p->run();
+            }
+        });
+        return p;
+    }
+
+    size_t get()
+    {
+        if (!claimed.exchange(true))
+        {
+            run();
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this]() { return done; });
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+        return count;
+    }
+
+    /* make sure the read is not running, without running it; the result is discarded */
+    void cancel()
+    {
+        if (claimed.exchange(true))
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [this]() { return done; });
+        }
+    }
+};
+
+/* Cancels the prefetch when the current block fails, as the read writes into the caller's buffers. */
+class multi_exp_stream_prefetch_guard {
+private:
+    std::shared_ptr<multi_exp_stream_prefetch> prefetch;
+public:
+    explicit multi_exp_stream_prefetch_guard(const std::shared_ptr<multi_exp_stream_prefetch> &prefetch) :
+        prefetch(prefetch) {}
+    ~multi_exp_stream_prefetch_guard() { prefetch->cancel(); }
+    multi_exp_stream_prefetch_guard(const multi_exp_stream_prefetch_guard&) = delete;
+    multi_exp_stream_prefetch_guard& operator=(const multi_exp_stream_prefetch_guard&) = delete;
+};
+
+template<typename T, typename FieldT>
+T multi_exp_stream(const multi_exp_stream_reader<T, FieldT> &reader,
+                   const size_t expected_length,
+                   const size_t block_size)
+{
+    LIBFF_TRACE_SCOPE("multi_exp_stream");
+    typedef typename multi_exp_scalar<FieldT>::bigint_type bigint_type;
+
+    const size_t num_bits = multi_exp_scalar<FieldT>::num_bits();
+
+    // empirically, this seems to be a decent estimate of the optimal value of c
+    size_t log2_length = log2(expected_length);
+    size_t c = log2_length - (log2_length / 3 - 2);
+    /* the buckets of all windows are live at once, and narrower windows mean more of them */
+    while (c > 1 && !mem_budget_allows(((num_bits + c - 1) / c) * (sizeof(T) << c)))
+    {
+        --c;
+    }
+
+    const size_t num_groups = (num_bits + c - 1) / c;
+
+    /* one bucket set per window, so that every block is consumed only once */
+    std::vector<std::vector<T> > buckets(num_groups, std::vector<T>(1 << c));
+    std::vector<std::vector<bool> > bucket_nonzero(num_groups, std::vector<bool>(1 << c));
+    mem_scope buckets_mem(mem_tag_multiexp_buckets, num_groups * (sizeof(T) << c));
+
+    std::vector<T> bases, next_bases;
+    std::vector<FieldT> scalars, next_scalars;
+    std::vector<bigint_type> bn_storage;
+
+    size_t offset = 0;
+    size_t count = reader(offset, block_size, bases, scalars);
+
+    while (count != 0)
+    {
+        if (bases.size() < count || scalars.size() < count)
+        {
+            throw std::runtime_error("multi_exp_stream: the reader returned more entries than it provided");
+        }
+        offset += count;
+
+        const std::shared_ptr<multi_exp_stream_prefetch> next_count =
+            multi_exp_stream_prefetch::start([&reader, &next_bases, &next_scalars, offset, block_size]() {
+                return reader(offset, block_size, next_bases, next_scalars);
+            });
+        const multi_exp_stream_prefetch_guard wait_for_next(next_count);
+
+        const auto bn_exponents =
+            multi_exp_scalar<FieldT>::as_bigints(scalars.cbegin(), scalars.cbegin() + count, bn_storage);
+
+        parallel_for(0, num_groups, [&](const size_t k) {
+            for (size_t i = 0; i < count; ++i)
+            {
+                size_t id = 0;
+                for (size_t j = 0; j < c; j++)
+                {
+                    if (bn_exponents[i].test_bit(k*c + j))
+                    {
+                        id |= 1 << j;
+                    }
+                }
+
+                if (id == 0)
+                {
+                    continue;
+                }
+
+                if (bucket_nonzero[k][id])
+                {
+#ifdef USE_MIXED_ADDITION
+                    buckets[k][id] = buckets[k][id].mixed_add(bases[i]);
+#else
+                    buckets[k][id] = buckets[k][id] + bases[i];
+#endif
+                }
+                else
+                {
+                    buckets[k][id] = bases[i];
+                    bucket_nonzero[k][id] = true;
+                }
+            }
+        });
+
+        count = next_count->get();
+        bases.swap(next_bases);
+        scalars.swap(next_scalars);
+    }
+
+    T result = T::zero();
+
+    for (size_t k = num_groups - 1; k <= num_groups; k--)
+    {
+        for (size_t i = 0; i < c; i++)
+        {
+            result = result.dbl();
+        }
+
+        T running_sum = T::zero();
+
+        for (size_t i = (1u << c) - 1; i > 0; i--)
+        {
+            if (bucket_nonzero[k][i])
+            {
+                running_sum = running_sum + buckets[k][i];
+            }
+            result = result + running_sum;
+        }
+    }
+
+    return result;
+}
+
 template <typename T>
 T inner_product(typename std::vector<T>::const_iterator a_start,
                 typename std::vector<T>::const_iterator a_end,
@@ -509,15 +1213,11 @@ T inner_product(typename std::vector<T>::const_iterator a_start,
 template<typename T>
 size_t get_exp_window_size(const size_t num_scalars)
 {
+    size_t window = 1;
     if (T::fixed_base_exp_window_table.empty())
     {
-#ifdef LOWMEM
-        return 14;
-#else
-        return 17;
-#endif
+        window = 17;
     }
-    size_t window = 1;
     for (long i = T::fixed_base_exp_window_table.size()-1; i >= 0; --i)
     {
 #ifdef DEBUG
@@ -541,9 +1241,23 @@ size_t get_exp_window_size(const size_t num_scalars)
 #ifdef LOWMEM
     window = std::min((size_t)14, window);
 #endif
+
+    // use a smaller window if the table would not fit in the memory budget
+    const size_t scalar_size = T::order().num_bits();
+    while (window > 1 && !mem_budget_allows(window_table_size_in_bytes<T>(scalar_size, window)))
+    {
+        --window;
+    }
     return window;
 }
 
+template<typename T>
+size_t window_table_size_in_bytes(const size_t scalar_size, const size_t window)
+{
+    const size_t outerc = (scalar_size+window-1)/window;
+    return outerc * (sizeof(T) << window);
+}
+
 template<typename T>
 window_table<T> get_window_table(const size_t scalar_size,
                                  const size_t window,
@@ -560,6 +1274,7 @@ window_table<T> get_window_table(const size_t scalar_size,
 #endif
 
     window_table<T> powers_of_g(outerc, std::vector<T>(in_window, T::zero()));
+    mem_scope table_mem(mem_tag_window_table, window_table_size_in_bytes<T>(scalar_size, window));
 
     T gouter = g;
 
@@ -589,7 +1304,8 @@ T windowed_exp(const size_t scalar_size,
                const FieldT &pow)
 {
     const size_t outerc = (scalar_size+window-1)/window;
-    const bigint<FieldT::num_limbs> pow_val = pow.as_bigint();
+    const bigint<multi_exp_scalar<FieldT>::num_limbs> pow_val =
+        multi_exp_scalar<FieldT>::as_bigint(pow);
 
     /* exp */
     T res = powers_of_g[0][0];
@@ -617,31 +1333,20 @@ std::vector<T> batch_exp(const size_t scalar_size,
                          const window_table<T> &table,
                          const std::vector<FieldT> &v)
 {
-    if (!inhibit_profiling_info)
-    {
-        print_indent();
-    }
+    LIBFF_TRACE_SCOPE("batch_exp");
     std::vector<T> res(v.size(), table[0][0]);
+    progress_reporter progress("batch_exp", v.size());
 
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-    for (size_t i = 0; i < v.size(); ++i)
-    {
-        res[i] = windowed_exp(scalar_size, window, table, v[i]);
-
-        if (!inhibit_profiling_info && (i % 10000 == 0))
+    parallel_for(0, v.size(), [&](const size_t i) {
+        if (progress.cancelled())
         {
-            printf(".");
-            fflush(stdout);
+            return;
         }
-    }
-
-    if (!inhibit_profiling_info)
-    {
-        printf(" DONE!\n");
-    }
+        res[i] = windowed_exp(scalar_size, window, table, v[i]);
+        progress.advance();
+    });
 
+    progress.finish();
     return res;
 }
 
@@ -652,31 +1357,75 @@ std::vector<T> batch_exp_with_coeff(const size_t scalar_size,
                                     const FieldT &coeff,
                                     const std::vector<FieldT> &v)
 {
-    if (!inhibit_profiling_info)
-    {
-        print_indent();
-    }
+    LIBFF_TRACE_SCOPE("batch_exp_with_coeff");
     std::vector<T> res(v.size(), table[0][0]);
+    progress_reporter progress("batch_exp_with_coeff", v.size());
 
-#ifdef MULTICORE
-#pragma omp parallel for
-#endif
-    for (size_t i = 0; i < v.size(); ++i)
-    {
+    parallel_for(0, v.size(), [&](const size_t i) {
+        if (progress.cancelled())
+        {
+            return;
+        }
         res[i] = windowed_exp(scalar_size, window, table, coeff * v[i]);
+        progress.advance();
+    });
+
+    progress.finish();
+    return res;
+}
+
+template<typename T, typename FieldT>
+std::vector<T> batch_exp_affine(const size_t scalar_size,
+                                const size_t window,
+                                const window_table<T> &table,
+                                const std::vector<FieldT> &v)
+{
+    LIBFF_TRACE_SCOPE("batch_exp_affine");
+
+    /* large enough to amortize the inversion, small enough to stay in cache */
+    const size_t block_size = 1024;
+    const size_t num_blocks = (v.size() + block_size - 1) / block_size;
 
-        if (!inhibit_profiling_info && (i % 10000 == 0))
+    T zero_special = T::zero();
+    zero_special.to_special();
+    std::vector<T> res(v.size(), zero_special);
+    progress_reporter progress("batch_exp_affine", v.size());
+
+    parallel_for(0, num_blocks, [&](const size_t b) {
+        if (progress.cancelled())
         {
-            printf(".");
-            fflush(stdout);
+            return;
         }
-    }
 
-    if (!inhibit_profiling_info)
-    {
-        printf(" DONE!\n");
-    }
+        const size_t block_start = b * block_size;
+        const size_t block_end = std::min(block_start + block_size, v.size());
+
+        std::vector<T> non_zero_block;
+        std::vector<size_t> non_zero_idx;
+        non_zero_block.reserve(block_end - block_start);
+        non_zero_idx.reserve(block_end - block_start);
+
+        for (size_t i = block_start; i < block_end; ++i)
+        {
+            const T r = windowed_exp(scalar_size, window, table, v[i]);
+            if (!r.is_zero())
+            {
+                non_zero_block.emplace_back(r);
+                non_zero_idx.emplace_back(i);
+            }
+        }
 
+        T::batch_to_special_all_non_zeros(non_zero_block);
+
+        for (size_t j = 0; j < non_zero_block.size(); ++j)
+        {
+            res[non_zero_idx[j]] = non_zero_block[j];
+        }
+
+        progress.advance(block_end - block_start);
+    });
+
+    progress.finish();
     return res;
 }
 
@@ -714,6 +1463,33 @@ void batch_to_special(std::vector<T> &vec)
     leave_block("Batch-convert elements to special form");
 }
 
+template<typename T, typename FieldT, multi_exp_method Method>
+async_value<T> multi_exp_async(typename std::vector<T>::const_iterator vec_start,
+                               typename std::vector<T>::const_iterator vec_end,
+                               typename std::vector<FieldT>::const_iterator scalar_start,
+                               typename std::vector<FieldT>::const_iterator scalar_end,
+                               const size_t chunks,
+                               const std::vector<async_handle> &deps)
+{
+    return async_submit([=]() -> T {
+        return multi_exp<T, FieldT, Method>(vec_start, vec_end, scalar_start, scalar_end, chunks);
+    }, deps);
+}
+
+template<typename T, typename FieldT>
+async_value<std::vector<T> > batch_exp_async(const size_t scalar_size,
+                                             const size_t window,
+                                             const window_table<T> &table,
+                                             const std::vector<FieldT> &v,
+                                             const std::vector<async_handle> &deps)
+{
+    const window_table<T> *table_ptr = &table;
+    const std::vector<FieldT> *v_ptr = &v;
+    return async_submit([scalar_size, window, table_ptr, v_ptr]() -> std::vector<T> {
+        return batch_exp(scalar_size, window, *table_ptr, *v_ptr);
+    }, deps);
+}
+
 } // libff
 
 #endif // MULTIEXP_TCC_
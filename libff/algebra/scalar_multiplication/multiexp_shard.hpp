@@ -0,0 +1,141 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of interfaces for multi-exponentiations split into shards that
+ are computed separately (e.g. by different processes or hosts) and merged
+ by a coordinator.
+
+ A shard is the index range [shard_begin, shard_end) of an input of
+ total_length bases and scalars. The worker for a shard only needs that
+ slice of the input; it returns a multi_exp_partial, which can be written
+ to a stream and read back with the usual operator<< and operator>>. A
+ partial result is either
+
+ - a finished group element (multi_exp_shard, with any multi_exp_method), or
+ - the sums of the buckets of every window of the bucket method
+   (multi_exp_shard_window_sums). Partials of this form computed with the
+   same window are merged window by window, so the doublings between the
+   windows are done once by the coordinator rather than once per shard.
+
+ Partials usually come from other machines, so operator>> checks the form,
+ the shard range and the number of values for the form and window, and sets
+ failbit on the stream instead of returning an inconsistent partial.
+
+ multi_exp_merge_partials combines partials of adjacent shards into the
+ partial of their union (so that merging can be done in a tree), and
+ multi_exp_merge returns the final result, checking that the shards cover
+ the whole input exactly once.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_SHARD_HPP_
+#define MULTIEXP_SHARD_HPP_
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+
+namespace libff {
+
+enum multi_exp_partial_form {
+    multi_exp_partial_element = 0,
+    multi_exp_partial_window_sums = 1
+};
+
+template<typename T>
+class multi_exp_partial;
+
+template<typename T>
+std::ostream& operator<<(std::ostream &out, const multi_exp_partial<T> &partial);
+
+template<typename T>
+std::istream& operator>>(std::istream &in, multi_exp_partial<T> &partial);
+
+template<typename T>
+class multi_exp_partial {
+public:
+    multi_exp_partial_form form;
+    size_t shard_begin;
+    size_t shard_end;
+    size_t total_length;
+    /* window of the bucket method, for multi_exp_partial_window_sums */
+    size_t window;
+    /* the element, or the sum of every window, lowest window first */
+    std::vector<T> values;
+
+    multi_exp_partial() : form(multi_exp_partial_element), shard_begin(0), shard_end(0), total_length(0), window(0) {}
+
+    /* the sum over the shard, as a group element */
+    T value() const;
+
+    bool operator==(const multi_exp_partial<T> &other) const;
+    friend std::ostream& operator<< <T>(std::ostream &out, const multi_exp_partial<T> &partial);
+    friend std::istream& operator>> <T>(std::istream &in, multi_exp_partial<T> &partial);
+};
+
+/**
+ * Window for multi_exp_shard_window_sums over an input of total_length
+ * entries: the window multi_exp_method_BDLO12 would use for the whole input,
+ * reduced to what the memory budget (see memory_accounting.hpp) allows for
+ * one set of buckets per thread. All shards of an input must use the same
+ * window.
+ */
+template<typename T>
+size_t multi_exp_shard_window(const size_t total_length);
+
+/**
+ * Computes the shard's part of the sum of multi_exp as a group element.
+ * The iterators cover only the shard, which starts at position shard_begin
+ * of the whole input.
+ */
+template<typename T, typename FieldT, multi_exp_method Method>
+multi_exp_partial<T> multi_exp_shard(typename std::vector<T>::const_iterator vec_start,
+                                     typename std::vector<T>::const_iterator vec_end,
+                                     typename std::vector<FieldT>::const_iterator scalar_start,
+                                     typename std::vector<FieldT>::const_iterator scalar_end,
+                                     const size_t shard_begin,
+                                     const size_t total_length,
+                                     const size_t chunks);
+
+/**
+ * Computes the shard's part as the bucket sums of every window of the given
+ * width (which must be the same for all shards, see multi_exp_shard_window).
+ * The windows are processed in parallel.
+ */
+template<typename T, typename FieldT>
+multi_exp_partial<T> multi_exp_shard_window_sums(typename std::vector<T>::const_iterator vec_start,
+                                                 typename std::vector<T>::const_iterator vec_end,
+                                                 typename std::vector<FieldT>::const_iterator scalar_start,
+                                                 typename std::vector<FieldT>::const_iterator scalar_end,
+                                                 const size_t shard_begin,
+                                                 const size_t total_length,
+                                                 const size_t window);
+
+/**
+ * Merges partials whose shards are adjacent (in any order) into the partial
+ * of their union. Window sums are merged as window sums if all partials have
+ * the same window and number of windows; otherwise the result is an element.
+ * Throws std::invalid_argument if the partials are of different inputs, or
+ * their shards overlap or leave a gap.
+ */
+template<typename T>
+multi_exp_partial<T> multi_exp_merge_partials(const std::vector<multi_exp_partial<T> > &partials);
+
+/**
+ * The result of the whole multi-exponentiation. Throws std::invalid_argument
+ * unless the shards cover [0, total_length) exactly once.
+ */
+template<typename T>
+T multi_exp_merge(const std::vector<multi_exp_partial<T> > &partials);
+
+} // libff
+
+#include <libff/algebra/scalar_multiplication/multiexp_shard.tcc>
+
+#endif // MULTIEXP_SHARD_HPP_
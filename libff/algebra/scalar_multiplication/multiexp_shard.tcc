@@ -0,0 +1,327 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of interfaces for sharded multi-exponentiations.
+
+ See multiexp_shard.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MULTIEXP_SHARD_TCC_
+#define MULTIEXP_SHARD_TCC_
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+#include <libff/common/execution.hpp>
+#include <libff/common/memory_accounting.hpp>
+#include <libff/common/serialization.hpp>
+#include <libff/common/tracing.hpp>
+#include <libff/common/utils.hpp>
+
+namespace libff {
+
+template<typename T>
+T multi_exp_partial<T>::value() const
+{
+    if (form == multi_exp_partial_element)
+    {
+        return values.empty() ? T::zero() : values[0];
+    }
+
+    T result = T::zero();
+    for (size_t k = values.size(); k-- > 0; )
+    {
+        for (size_t i = 0; i < window; ++i)
+        {
+            result = result.dbl();
+        }
+        result = result + values[k];
+    }
+    return result;
+}
+
+template<typename T>
+bool multi_exp_partial<T>::operator==(const multi_exp_partial<T> &other) const
+{
+    return (this->form == other.form &&
+            this->shard_begin == other.shard_begin &&
+            this->shard_end == other.shard_end &&
+            this->total_length == other.total_length &&
+            this->window == other.window &&
+            this->values == other.values);
+}
+
+template<typename T>
+std::ostream& operator<<(std::ostream &out, const multi_exp_partial<T> &partial)
+{
+    out << (int) partial.form << "\n";
+    out << partial.shard_begin << "\n";
+    out << partial.shard_end << "\n";
+    out << partial.total_length << "\n";
+    out << partial.window << "\n";
+    out << partial.values;
+    return out;
+}
+
+/**
+ * Whether num_windows windows of the given width is what multi_exp_shard_window_sums
+ * computes for scalars of T: enough for field elements of the size of the
+ * group order, at most enough for bigints of its number of limbs.
+ */
+template<typename T>
+bool multi_exp_partial_num_windows_valid(const size_t num_windows, const size_t window)
+{
+    const auto order = T::order();
+    return (num_windows >= (order.num_bits() + window - 1) / window &&
+            num_windows <= (order.max_bits() + window - 1) / window);
+}
+
+template<typename T>
+std::istream& operator>>(std::istream &in, multi_exp_partial<T> &partial)
+{
+    /* partials come from other hosts: check the header before the values are read or merged */
+    int form;
+    in >> form;
+    consume_newline(in);
+    in >> partial.shard_begin;
+    consume_newline(in);
+    in >> partial.shard_end;
+    consume_newline(in);
+    in >> partial.total_length;
+    consume_newline(in);
+    in >> partial.window;
+    consume_newline(in);
+    size_t num_values;
+    in >> num_values;
+    consume_newline(in);
+    if (!in)
+    {
+        return in;
+    }
+
+    bool valid;
+    if (form == multi_exp_partial_element)
+    {
+        valid = (num_values == 1);
+    }
+    else if (form == multi_exp_partial_window_sums)
+    {
+        valid = (partial.window > 0 && partial.window < 8 * sizeof(size_t) &&
+                 multi_exp_partial_num_windows_valid<T>(num_values, partial.window));
+    }
+    else
+    {
+        valid = false;
+    }
+
+    if (!valid || partial.shard_begin > partial.shard_end || partial.shard_end > partial.total_length)
+    {
+        in.setstate(std::ios::failbit);
+        return in;
+    }
+
+    partial.form = (multi_exp_partial_form) form;
+    partial.values.resize(num_values);
+    for (size_t i = 0; i < num_values; ++i)
+    {
+        in >> partial.values[i];
+        consume_OUTPUT_NEWLINE(in);
+    }
+    return in;
+}
+
+template<typename T>
+size_t multi_exp_shard_window(const size_t total_length)
+{
+    // same estimate as multi_exp_method_BDLO12
+    const size_t log2_length = log2(total_length);
+    const size_t c = std::max<size_t>(1, log2_length - (log2_length / 3 - 2));
+    return bucket_window_within_budget<T>(c, get_executor()->concurrency());
+}
+
+template<typename T, typename FieldT, multi_exp_method Method>
+multi_exp_partial<T> multi_exp_shard(typename std::vector<T>::const_iterator vec_start,
+                                     typename std::vector<T>::const_iterator vec_end,
+                                     typename std::vector<FieldT>::const_iterator scalar_start,
+                                     typename std::vector<FieldT>::const_iterator scalar_end,
+                                     const size_t shard_begin,
+                                     const size_t total_length,
+                                     const size_t chunks)
+{
+    multi_exp_partial<T> partial;
+    partial.form = multi_exp_partial_element;
+    partial.shard_begin = shard_begin;
+    partial.shard_end = shard_begin + (vec_end - vec_start);
+    partial.total_length = total_length;
+    partial.values.emplace_back(vec_start == vec_end ? T::zero() :
+                                multi_exp<T, FieldT, Method>(vec_start, vec_end, scalar_start, scalar_end, chunks));
+    return partial;
+}
+
+template<typename T, typename FieldT>
+multi_exp_partial<T> multi_exp_shard_window_sums(typename std::vector<T>::const_iterator vec_start,
+                                                 typename std::vector<T>::const_iterator vec_end,
+                                                 typename std::vector<FieldT>::const_iterator scalar_start,
+                                                 typename std::vector<FieldT>::const_iterator scalar_end,
+                                                 const size_t shard_begin,
+                                                 const size_t total_length,
+                                                 const size_t window)
+{
+    LIBFF_TRACE_SCOPE("multi_exp_shard_window_sums");
+    assert(window > 0);
+    const size_t length = vec_end - vec_start;
+    const size_t c = window;
+
+    std::vector<typename multi_exp_scalar<FieldT>::bigint_type> bn_storage;
+    const auto bn_exponents =
+        multi_exp_scalar<FieldT>::as_bigints(scalar_start, scalar_end, bn_storage);
+
+    /* the same for every shard, whatever its scalars */
+    const size_t num_windows = (multi_exp_scalar<FieldT>::num_bits() + c - 1) / c;
+
+    multi_exp_partial<T> partial;
+    partial.form = multi_exp_partial_window_sums;
+    partial.shard_begin = shard_begin;
+    partial.shard_end = shard_begin + length;
+    partial.total_length = total_length;
+    partial.window = c;
+    partial.values.resize(num_windows, T::zero());
+
+    parallel_for(0, num_windows, [&](const size_t k) {
+        std::vector<T> buckets(1 << c);
+        std::vector<bool> bucket_nonzero(1 << c);
+        mem_scope buckets_mem(mem_tag_multiexp_buckets, buckets.capacity() * sizeof(T));
+
+        for (size_t i = 0; i < length; i++)
+        {
+            size_t id = 0;
+            for (size_t j = 0; j < c; j++)
+            {
+                if (bn_exponents[i].test_bit(k*c + j))
+                {
+                    id |= 1 << j;
+                }
+            }
+
+            if (id == 0)
+            {
+                continue;
+            }
+
+            if (bucket_nonzero[id])
+            {
+#ifdef USE_MIXED_ADDITION
+                buckets[id] = buckets[id].mixed_add(vec_start[i]);
+#else
+                buckets[id] = buckets[id] + vec_start[i];
+#endif
+            }
+            else
+            {
+                buckets[id] = vec_start[i];
+                bucket_nonzero[id] = true;
+            }
+        }
+
+        // sum of id * buckets[id], as the sum of the running sums from the top
+        T running_sum = T::zero();
+        T window_sum = T::zero();
+        for (size_t id = (1u << c) - 1; id > 0; id--)
+        {
+            if (bucket_nonzero[id])
+            {
+                running_sum = running_sum + buckets[id];
+            }
+            window_sum = window_sum + running_sum;
+        }
+        partial.values[k] = window_sum;
+    });
+
+    return partial;
+}
+
+template<typename T>
+multi_exp_partial<T> multi_exp_merge_partials(const std::vector<multi_exp_partial<T> > &partials)
+{
+    if (partials.empty())
+    {
+        throw std::invalid_argument("multi_exp_merge_partials: no partial results");
+    }
+
+    std::vector<const multi_exp_partial<T>*> sorted;
+    for (const multi_exp_partial<T> &p : partials)
+    {
+        sorted.emplace_back(&p);
+    }
+    std::sort(sorted.begin(), sorted.end(),
+              [](const multi_exp_partial<T> *a, const multi_exp_partial<T> *b) { return a->shard_begin < b->shard_begin; });
+
+    bool same_windows = true;
+    for (size_t i = 0; i < sorted.size(); ++i)
+    {
+        const multi_exp_partial<T> &p = *sorted[i];
+        if (p.total_length != sorted[0]->total_length || p.shard_end < p.shard_begin || p.shard_end > p.total_length)
+        {
+            throw std::invalid_argument("multi_exp_merge_partials: partial results of different inputs");
+        }
+        if (i > 0 && p.shard_begin != sorted[i-1]->shard_end)
+        {
+            throw std::invalid_argument("multi_exp_merge_partials: shards overlap or leave a gap");
+        }
+        same_windows = same_windows && (p.form == multi_exp_partial_window_sums &&
+                                        p.window == sorted[0]->window &&
+                                        p.values.size() == sorted[0]->values.size());
+    }
+
+    multi_exp_partial<T> merged;
+    merged.shard_begin = sorted.front()->shard_begin;
+    merged.shard_end = sorted.back()->shard_end;
+    merged.total_length = sorted[0]->total_length;
+
+    if (same_windows)
+    {
+        merged.form = multi_exp_partial_window_sums;
+        merged.window = sorted[0]->window;
+        merged.values = sorted[0]->values;
+        for (size_t i = 1; i < sorted.size(); ++i)
+        {
+            for (size_t k = 0; k < merged.values.size(); ++k)
+            {
+                merged.values[k] = merged.values[k] + sorted[i]->values[k];
+            }
+        }
+    }
+    else
+    {
+        T sum = T::zero();
+        for (const multi_exp_partial<T> *p : sorted)
+        {
+            sum = sum + p->value();
+        }
+        merged.form = multi_exp_partial_element;
+        merged.values.emplace_back(sum);
+    }
+
+    return merged;
+}
+
+template<typename T>
+T multi_exp_merge(const std::vector<multi_exp_partial<T> > &partials)
+{
+    const multi_exp_partial<T> merged = multi_exp_merge_partials(partials);
+    if (merged.shard_begin != 0 || merged.shard_end != merged.total_length)
+    {
+        throw std::invalid_argument("multi_exp_merge: shards do not cover the whole input");
+    }
+    return merged.value();
+}
+
+} // libff
+
+#endif // MULTIEXP_SHARD_TCC_
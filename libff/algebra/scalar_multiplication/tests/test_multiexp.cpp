@@ -0,0 +1,956 @@
+/**
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/algebra/curves/bls12_381/bls12_381_pp.hpp>
+#include <libff/algebra/curves/mnt/mnt4/mnt4_pp.hpp>
+#include <libff/algebra/fields/field_utils.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp.hpp>
+#include <libff/algebra/scalar_multiplication/multiexp_shard.hpp>
+#include <libff/common/execution.hpp>
+#include <libff/common/memory_accounting.hpp>
+#include <libff/common/numa.hpp>
+#include <libff/common/op_counts.hpp>
+#include <libff/common/profiling.hpp>
+#include <libff/common/progress.hpp>
+#include <libff/common/utils.hpp>
+
+using namespace libff;
+
+template<typename GroupT, typename FieldT>
+GroupT naive_multi_exp(const std::vector<GroupT> &bases, const std::vector<FieldT> &scalars)
+{
+    GroupT result = GroupT::zero();
+    for (size_t i = 0; i < bases.size(); ++i)
+    {
+        result = result + scalars[i] * bases[i];
+    }
+    return result;
+}
+
+template<typename GroupT, typename FieldT>
+void test_multi_exp_methods(const size_t num_elements)
+{
+    std::vector<GroupT> bases(num_elements);
+    std::vector<FieldT> scalars(num_elements);
+    for (size_t i = 0; i < num_elements; ++i)
+    {
+        bases[i] = GroupT::random_element();
+        bases[i].to_special();
+        scalars[i] = FieldT::random_element();
+    }
+    scalars[0] = FieldT::zero();
+    for (size_t i = 1; i < num_elements; ++i)
+    {
+        /* mix in the small scalars typical of R1CS witnesses */
+        switch (i % 5)
+        {
+        case 1: scalars[i] = FieldT::one(); break;
+        case 2: scalars[i] = FieldT(i % 256); break;
+        case 3: scalars[i] = FieldT((long)(i * 2654435761ul % (1ul << 32))); break;
+        default: break;
+        }
+    }
+
+    const GroupT expected = naive_multi_exp(bases, scalars);
+    const std::vector<bigint<FieldT::num_limbs> > canonical = batch_as_bigint(scalars);
+    typedef bigint<FieldT::num_limbs> BigIntT;
+
+    for (size_t chunks : { 1, 3 })
+    {
+        assert((multi_exp<GroupT, FieldT, multi_exp_method_naive>(
+                    bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), chunks)) == expected);
+        assert((multi_exp<GroupT, FieldT, multi_exp_method_bos_coster>(
+                    bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), chunks)) == expected);
+        assert((multi_exp<GroupT, FieldT, multi_exp_method_BDLO12>(
+                    bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), chunks)) == expected);
+        assert((multi_exp_with_mixed_addition<GroupT, FieldT, multi_exp_method_BDLO12>(
+                    bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), chunks)) == expected);
+        assert((multi_exp<GroupT, FieldT, multi_exp_method_BDLO12_small_scalars>(
+                    bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), chunks)) == expected);
+
+        assert((multi_exp<GroupT, BigIntT, multi_exp_method_naive>(
+                    bases.cbegin(), bases.cend(), canonical.cbegin(), canonical.cend(), chunks)) == expected);
+        assert((multi_exp<GroupT, BigIntT, multi_exp_method_bos_coster>(
+                    bases.cbegin(), bases.cend(), canonical.cbegin(), canonical.cend(), chunks)) == expected);
+        assert((multi_exp<GroupT, BigIntT, multi_exp_method_BDLO12>(
+                    bases.cbegin(), bases.cend(), canonical.cbegin(), canonical.cend(), chunks)) == expected);
+        assert((multi_exp_with_mixed_addition<GroupT, BigIntT, multi_exp_method_BDLO12>(
+                    bases.cbegin(), bases.cend(), canonical.cbegin(), canonical.cend(), chunks)) == expected);
+        assert((multi_exp<GroupT, BigIntT, multi_exp_method_BDLO12_small_scalars>(
+                    bases.cbegin(), bases.cend(), canonical.cbegin(), canonical.cend(), chunks)) == expected);
+    }
+}
+
+template<typename GroupT, typename FieldT>
+void test_multi_exp_batch(const size_t num_elements, const size_t batch_size)
+{
+    std::vector<GroupT> bases(num_elements);
+    for (size_t i = 0; i < num_elements; ++i)
+    {
+        bases[i] = GroupT::random_element();
+        bases[i].to_special();
+    }
+
+    std::vector<std::vector<FieldT> > scalars(batch_size, std::vector<FieldT>(num_elements));
+    for (size_t s = 0; s < batch_size; ++s)
+    {
+        for (size_t i = 0; i < num_elements; ++i)
+        {
+            scalars[s][i] = (i % (s + 2) == 0) ? FieldT::zero() : FieldT::random_element();
+        }
+    }
+
+    for (size_t chunks : { 1, 4 })
+    {
+        const std::vector<GroupT> results =
+            multi_exp_batch<GroupT, FieldT>(bases.cbegin(), bases.cend(), scalars, chunks);
+        assert(results.size() == batch_size);
+        for (size_t s = 0; s < batch_size; ++s)
+        {
+            assert(results[s] == naive_multi_exp(bases, scalars[s]));
+        }
+    }
+}
+
+template<typename GroupT, typename FieldT>
+void test_multi_exp_stream(const size_t num_elements, const size_t block_size)
+{
+    std::vector<GroupT> bases(num_elements);
+    std::vector<FieldT> scalars(num_elements);
+    for (size_t i = 0; i < num_elements; ++i)
+    {
+        bases[i] = GroupT::random_element();
+        bases[i].to_special();
+        scalars[i] = FieldT::random_element();
+    }
+
+    const multi_exp_stream_reader<GroupT, FieldT> reader =
+        [&bases, &scalars](const size_t offset, const size_t max_count,
+                           std::vector<GroupT> &block_bases, std::vector<FieldT> &block_scalars) {
+            const size_t count = std::min(max_count, bases.size() - offset);
+            block_bases.assign(bases.begin() + offset, bases.begin() + offset + count);
+            block_scalars.assign(scalars.begin() + offset, scalars.begin() + offset + count);
+            return count;
+        };
+
+    assert(multi_exp_stream(reader, num_elements, block_size) == naive_multi_exp(bases, scalars));
+
+    /* a reader claiming more entries than it provided is an error, not an out-of-bounds read */
+    const multi_exp_stream_reader<GroupT, FieldT> short_reader =
+        [&reader](const size_t offset, const size_t max_count,
+                  std::vector<GroupT> &block_bases, std::vector<FieldT> &block_scalars) {
+            const size_t count = reader(offset, max_count, block_bases, block_scalars);
+            return count == 0 ? 0 : count + 1;
+        };
+    bool caught = false;
+    try
+    {
+        multi_exp_stream(short_reader, num_elements, block_size);
+    }
+    catch (const std::runtime_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+}
+
+/* Fails every parallel_for, with the submitted tasks on a pool. */
+class failing_loop_executor : public thread_pool_executor {
+public:
+    failing_loop_executor() : thread_pool_executor(1) {}
+    void parallel_for(const size_t, const size_t, const std::function<void(size_t)> &)
+    {
+        throw std::runtime_error("test");
+    }
+};
+
+/* A block that fails waits for the read of the next block, which writes into buffers of the failed call. */
+template<typename GroupT, typename FieldT>
+void test_multi_exp_stream_failure()
+{
+    set_executor(std::make_shared<failing_loop_executor>());
+
+    std::atomic<bool> reading(false);
+    std::atomic<size_t> reads(0);
+    const multi_exp_stream_reader<GroupT, FieldT> reader =
+        [&reading, &reads](const size_t offset, const size_t max_count,
+                           std::vector<GroupT> &block_bases, std::vector<FieldT> &block_scalars) -> size_t {
+            if (offset >= 4 * max_count)
+            {
+                return 0;
+            }
+            reads.fetch_add(1);
+            reading.store(true);
+            if (offset > 0)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            }
+            block_bases.assign(max_count, GroupT::one());
+            block_scalars.assign(max_count, FieldT::one());
+            reading.store(false);
+            return max_count;
+        };
+
+    bool caught = false;
+    try
+    {
+        multi_exp_stream(reader, 40, 10);
+    }
+    catch (const std::runtime_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+    /* the read of the next block has either finished or will never start */
+    const size_t reads_on_return = reads.load();
+    assert(!reading.load());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    assert(reads.load() == reads_on_return);
+
+    set_executor(nullptr);
+}
+
+template<typename GroupT, typename FieldT>
+void test_batch_exp_affine()
+{
+    const size_t scalar_size = FieldT::size_in_bits();
+    const size_t num_scalars = 2500;
+    const size_t window = get_exp_window_size<GroupT>(num_scalars);
+    const window_table<GroupT> table = get_window_table(scalar_size, window, GroupT::random_element());
+
+    std::vector<FieldT> v(num_scalars);
+    for (size_t i = 0; i < num_scalars; ++i)
+    {
+        v[i] = (i % 7 == 0) ? FieldT::zero() : FieldT::random_element();
+    }
+
+    const std::vector<GroupT> expected = batch_exp(scalar_size, window, table, v);
+    const std::vector<GroupT> affine = batch_exp_affine(scalar_size, window, table, v);
+
+    assert(affine.size() == expected.size());
+    for (size_t i = 0; i < num_scalars; ++i)
+    {
+        assert(affine[i].is_special());
+        assert(affine[i] == expected[i]);
+    }
+}
+
+void test_op_counter_threads()
+{
+    op_counter counter("test::op");
+    const op_count_snapshot before = op_count_snapshot::all_threads();
+
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&counter, t]() {
+            for (size_t i = 0; i <= t; ++i)
+            {
+                counter++;
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    ++counter;
+
+    /* the workers have exited, but their counts are retained */
+    assert(counter.value() == 1 + 2 + 3 + 4 + 1);
+    assert((op_count_snapshot::all_threads() - before)[counter] == 11);
+    assert(op_count_snapshot::this_thread()[counter] == 1);
+}
+
+/* a thread entering a block does not overwrite the start of another thread in the same block */
+void test_profiling_threads()
+{
+    const std::string block = "test_profiling_threads";
+    std::atomic<bool> entered(false);
+    std::thread other([&block, &entered]() {
+        enter_block(block);
+        entered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        leave_block(block);
+    });
+    while (!entered)
+    {
+        std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    enter_block(block);
+    leave_block(block);
+    other.join();
+
+    assert(invocation_counts.at(block) == 2);
+    assert(cumulative_times.at(block) >= 100 * 1000000ll);
+}
+
+template<typename GroupT, typename FieldT>
+void test_multi_exp_op_counts(const size_t num_elements)
+{
+#ifdef PROFILE_OP_COUNTS
+    std::vector<GroupT> bases(num_elements);
+    std::vector<FieldT> scalars(num_elements);
+    for (size_t i = 0; i < num_elements; ++i)
+    {
+        bases[i] = GroupT::random_element();
+        scalars[i] = FieldT::random_element();
+    }
+
+    op_count_scope scope;
+    multi_exp<GroupT, FieldT, multi_exp_method_BDLO12>(
+        bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), 4);
+    const op_count_snapshot ops = scope.elapsed();
+    assert(ops[GroupT::add_cnt] > 0);
+    assert(ops[GroupT::dbl_cnt] > 0);
+
+    /* additions done on another thread are attributed to the scope */
+    op_count_scope thread_scope;
+    std::thread([&bases]() {
+        GroupT sum = bases[0];
+        for (size_t i = 1; i <= 10; ++i)
+        {
+            sum = sum + bases[i];
+        }
+    }).join();
+    assert(thread_scope.elapsed()[GroupT::add_cnt] == 10);
+#else
+    UNUSED(num_elements);
+#endif
+}
+
+template<typename ppT>
+void test_memory_accounting()
+{
+    typedef G1<ppT> GroupT;
+    typedef Fr<ppT> FieldT;
+    const size_t scalar_size = FieldT::size_in_bits();
+
+    /* window tables are accounted while they are built */
+    const size_t window = 4;
+    const size_t before = get_mem_usage(mem_tag_window_table).current;
+    reset_mem_peaks();
+    const window_table<GroupT> table = get_window_table(scalar_size, window, GroupT::one());
+    assert(get_mem_usage(mem_tag_window_table).peak ==
+           before + window_table_size_in_bytes<GroupT>(scalar_size, window));
+    assert(get_mem_usage(mem_tag_window_table).current == before);
+
+    /* G2 precomputations, and each of their copies, are accounted for their lifetime; the hook sees every change */
+    long long precomp_bytes = 0;
+    set_mem_report_hook([&precomp_bytes](const mem_tag tag, const long long delta, const mem_usage &) {
+        if (tag == mem_tag_pairing_precomp)
+        {
+            precomp_bytes += delta;
+        }
+    });
+    const size_t precomp_before = get_mem_usage(mem_tag_pairing_precomp).current;
+    {
+        const G2_precomp<ppT> prec_Q = ppT::precompute_G2(G2<ppT>::one());
+        const long long one_precomp = precomp_bytes;
+        assert(one_precomp > 0);
+        assert(get_mem_usage(mem_tag_pairing_precomp).current == precomp_before + one_precomp);
+
+        const G2_precomp<ppT> copy = prec_Q;
+        assert(precomp_bytes == 2 * one_precomp);
+    }
+    set_mem_report_hook(mem_report_hook());
+    assert(precomp_bytes == 0);
+    assert(get_mem_usage(mem_tag_pairing_precomp).current == precomp_before);
+
+    /* a budget leads to smaller windows, without changing the results */
+    const size_t num_elements = 1 << 14;
+    const size_t unbounded_window = get_exp_window_size<GroupT>(num_elements);
+    set_mem_budget(get_total_mem_usage().current + window_table_size_in_bytes<GroupT>(scalar_size, 3));
+    const size_t bounded_window = get_exp_window_size<GroupT>(num_elements);
+    assert(bounded_window == 3 && bounded_window < unbounded_window);
+
+    std::vector<GroupT> bases(200);
+    std::vector<FieldT> scalars(200);
+    for (size_t i = 0; i < bases.size(); ++i)
+    {
+        bases[i] = GroupT::random_element();
+        scalars[i] = FieldT::random_element();
+    }
+    const GroupT expected = naive_multi_exp(bases, scalars);
+    reset_mem_peaks();
+    const GroupT result = multi_exp<GroupT, FieldT, multi_exp_method_BDLO12>(
+        bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), 1);
+    assert(result == expected);
+    assert(get_mem_usage(mem_tag_multiexp_buckets).peak > 0);
+    assert(get_total_mem_usage().peak <= get_mem_budget());
+
+    /* the streaming variant keeps the buckets of all windows, within the same budget */
+    const multi_exp_stream_reader<GroupT, FieldT> reader =
+        [&bases, &scalars](const size_t offset, const size_t max_count,
+                           std::vector<GroupT> &block_bases, std::vector<FieldT> &block_scalars) {
+            const size_t count = std::min(max_count, bases.size() - offset);
+            block_bases.assign(bases.begin() + offset, bases.begin() + offset + count);
+            block_scalars.assign(scalars.begin() + offset, scalars.begin() + offset + count);
+            return count;
+        };
+    reset_mem_peaks();
+    assert(multi_exp_stream(reader, num_elements, 64) == expected);
+    assert(get_mem_usage(mem_tag_multiexp_buckets).peak > 0);
+    assert(get_total_mem_usage().peak <= get_mem_budget());
+    set_mem_budget(0);
+}
+
+template<typename GroupT, typename FieldT>
+void test_progress_and_cancellation()
+{
+    const size_t scalar_size = FieldT::size_in_bits();
+    const size_t window = 4;
+    const window_table<GroupT> table = get_window_table(scalar_size, window, GroupT::random_element());
+    std::vector<FieldT> v(100);
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        v[i] = FieldT::random_element();
+    }
+
+    /* reported from this thread only, and the last report is completion */
+    const std::thread::id caller = std::this_thread::get_id();
+    size_t num_reports = 0;
+    size_t last_done = 0;
+    set_progress_callback([&](const std::string &operation, const size_t done, const size_t total) {
+        assert(std::this_thread::get_id() == caller);
+        assert(operation == "batch_exp" && total == v.size());
+        assert(done >= last_done);
+        last_done = done;
+        ++num_reports;
+    }, 0);
+    batch_exp(scalar_size, window, table, v);
+    assert(num_reports > 0 && last_done == v.size());
+    clear_progress_callback();
+
+    /* cancelling from the callback stops the operation */
+    cancellation_token token;
+    set_cancellation_token(token);
+    set_progress_callback([&token](const std::string &, const size_t done, const size_t) {
+        if (done >= 10)
+        {
+            token.cancel();
+        }
+    }, 0);
+    bool cancelled = false;
+    try
+    {
+        batch_exp_affine(scalar_size, window, table, std::vector<FieldT>(5000, FieldT::random_element()));
+        batch_exp(scalar_size, window, table, v);
+    }
+    catch (const operation_cancelled &)
+    {
+        cancelled = true;
+    }
+    assert(cancelled);
+    clear_progress_callback();
+    clear_cancellation_token();
+
+    /* without a registered token, nothing is cancelled */
+    batch_exp(scalar_size, window, table, v);
+}
+
+void test_parallel_for(const std::shared_ptr<executor> &exec)
+{
+    /* every iteration runs exactly once, also when nested */
+    const size_t n = 1000;
+    std::vector<std::atomic<size_t> > hits(n * 4);
+    exec->parallel_for(0, 4, [&](const size_t outer) {
+        assert(in_parallel_region());
+        exec->parallel_for(0, n, [&](const size_t inner) {
+            hits[outer * n + inner].fetch_add(1);
+        });
+    });
+    for (size_t i = 0; i < hits.size(); ++i)
+    {
+        assert(hits[i].load() == 1);
+    }
+    assert(!in_parallel_region());
+
+    /* exceptions reach the caller */
+    bool caught = false;
+    try
+    {
+        exec->parallel_for(0, n, [](const size_t i) {
+            if (i == 500)
+            {
+                throw std::runtime_error("test");
+            }
+        });
+    }
+    catch (const std::runtime_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+}
+
+template<typename GroupT, typename FieldT>
+void test_executors()
+{
+    std::shared_ptr<thread_pool_executor> pool = std::make_shared<thread_pool_executor>(3);
+    std::vector<std::shared_ptr<executor> > executors = {
+        std::make_shared<serial_executor>(),
+        pool,
+        /* an "external" pool: here the library's own, behind a plain function */
+        std::make_shared<function_executor>([pool](executor_task task) { pool->submit(std::move(task)); }, 3)
+    };
+#ifdef MULTICORE
+    executors.emplace_back(std::make_shared<openmp_executor>());
+#endif
+
+    for (const std::shared_ptr<executor> &exec : executors)
+    {
+        test_parallel_for(exec);
+
+        set_executor(exec);
+        assert(get_executor() == exec);
+        test_multi_exp_methods<GroupT, FieldT>(100);
+        test_multi_exp_batch<GroupT, FieldT>(50, 3);
+        test_batch_exp_affine<GroupT, FieldT>();
+    }
+    set_executor(nullptr);
+}
+
+template<typename GroupT, typename FieldT>
+void test_async_multi_exp(const std::shared_ptr<executor> &exec)
+{
+    set_executor(exec);
+
+    const size_t num_elements = 100;
+    std::vector<GroupT> bases(num_elements);
+    std::vector<FieldT> scalars(num_elements);
+    for (size_t i = 0; i < num_elements; ++i)
+    {
+        bases[i] = GroupT::random_element();
+        scalars[i] = FieldT::random_element();
+    }
+    const GroupT expected = naive_multi_exp(bases, scalars);
+
+    /* two halves in parallel, combined once both are done */
+    const size_t half = num_elements / 2;
+    const async_value<GroupT> low = multi_exp_async<GroupT, FieldT, multi_exp_method_BDLO12>(
+        bases.cbegin(), bases.cbegin() + half, scalars.cbegin(), scalars.cbegin() + half, 2);
+    const async_value<GroupT> high = multi_exp_async<GroupT, FieldT, multi_exp_method_bos_coster>(
+        bases.cbegin() + half, bases.cend(), scalars.cbegin() + half, scalars.cend(), 1);
+    const async_value<GroupT> sum = async_submit([low, high]() { return low.get() + high.get(); }, { low, high });
+    assert(sum.get() == expected);
+
+    /* batch_exp after a dependency; failures propagate to dependents */
+    const size_t scalar_size = FieldT::size_in_bits();
+    const window_table<GroupT> table = get_window_table(scalar_size, 4, GroupT::one());
+    const async_value<std::vector<GroupT> > powers = batch_exp_async(scalar_size, 4, table, scalars, { sum });
+    const std::vector<GroupT> &result = powers.get();
+    assert(result.size() == num_elements && result[7] == scalars[7] * GroupT::one());
+
+    const async_value<int> failed = async_submit([]() -> int { throw std::runtime_error("test"); });
+    const async_value<int> dependent = async_submit([failed]() { return failed.get() + 1; }, { failed });
+    bool caught = false;
+    try
+    {
+        dependent.get();
+    }
+    catch (const std::runtime_error &)
+    {
+        caught = true;
+    }
+    assert(caught);
+
+    set_executor(nullptr);
+}
+
+#ifdef MULTICORE
+/* number of threads of the process, or 0 where it cannot be read */
+size_t process_thread_count()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 8, "Threads:") == 0)
+        {
+            return std::stoul(line.substr(8));
+        }
+    }
+    return 0;
+}
+
+/* concurrent async multiexps on openmp_executor share its task pool instead of starting an OpenMP team each */
+template<typename GroupT, typename FieldT>
+void test_async_multi_exp_openmp()
+{
+    const int saved_threads = omp_get_max_threads();
+    omp_set_num_threads(4);
+    std::shared_ptr<openmp_executor> exec = std::make_shared<openmp_executor>();
+    set_executor(exec);
+    const size_t threads = exec->concurrency();
+    const size_t threads_before = process_thread_count();
+
+    /* loops inside submitted tasks run on the pool's workers */
+    std::mutex ids_mutex;
+    std::set<std::thread::id> ids;
+    std::vector<async_value<int> > loops;
+    for (size_t t = 0; t < 2 * threads; ++t)
+    {
+        loops.emplace_back(async_submit([&]() {
+            parallel_for(0, 1000, [&](const size_t) {
+                std::lock_guard<std::mutex> lock(ids_mutex);
+                ids.insert(std::this_thread::get_id());
+            });
+            return 0;
+        }));
+    }
+    for (const async_value<int> &l : loops)
+    {
+        l.get();
+    }
+    assert(ids.size() <= threads);
+
+    const size_t num_elements = 1000;
+    std::vector<GroupT> bases(num_elements);
+    std::vector<FieldT> scalars(num_elements);
+    for (size_t i = 0; i < num_elements; ++i)
+    {
+        bases[i] = GroupT::random_element();
+        scalars[i] = FieldT::random_element();
+    }
+    const GroupT expected = naive_multi_exp(bases, scalars);
+
+    std::atomic<bool> sampling(true);
+    std::atomic<size_t> max_threads(0);
+    std::thread sampler([&]() {
+        while (sampling.load())
+        {
+            const size_t n = process_thread_count();
+            if (n > max_threads.load())
+            {
+                max_threads.store(n);
+            }
+            std::this_thread::yield();
+        }
+    });
+
+    std::vector<async_value<GroupT> > results;
+    for (size_t t = 0; t < 2 * threads; ++t)
+    {
+        results.emplace_back(multi_exp_async<GroupT, FieldT, multi_exp_method_BDLO12>(
+            bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), threads));
+    }
+    for (const async_value<GroupT> &r : results)
+    {
+        assert(r.get() == expected);
+    }
+    sampling.store(false);
+    sampler.join();
+
+    /* the pool, the sampler and, at most, the calling thread's own OpenMP team */
+    if (threads_before > 0)
+    {
+        assert(max_threads.load() <= threads_before + threads + 1 + threads);
+    }
+
+    set_executor(nullptr);
+    omp_set_num_threads(saved_threads);
+}
+#endif
+
+template<typename GroupT, typename FieldT>
+void test_multi_exp_numa()
+{
+    const size_t num_elements = 150;
+    std::vector<GroupT> bases(num_elements);
+    std::vector<FieldT> scalars(num_elements);
+    for (size_t i = 0; i < num_elements; ++i)
+    {
+        bases[i] = GroupT::random_element();
+        scalars[i] = FieldT::random_element();
+    }
+    const GroupT expected = naive_multi_exp(bases, scalars);
+
+    /* whatever the machine has */
+    assert((multi_exp_numa<GroupT, FieldT, multi_exp_method_BDLO12>(
+        bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend())) == expected);
+
+    /* two nodes of unequal size, both backed by the memory and a CPU of node 0 */
+    numa_node small_node, large_node;
+    small_node.id = large_node.id = 0;
+    small_node.cpus = { 0 };
+    large_node.cpus = { 0, 0 };
+    set_numa_nodes({ small_node, large_node });
+
+    const std::vector<size_t> bounds = numa_partition(num_elements, get_numa_nodes());
+    assert(bounds.size() == 3 && bounds[0] == 0 && bounds[1] == 50 && bounds[2] == num_elements);
+
+    const numa_placement placements[] = { numa_placement_none, numa_placement_bind, numa_placement_first_touch };
+    for (const numa_placement placement : placements)
+    {
+        assert((multi_exp_numa<GroupT, FieldT, multi_exp_method_BDLO12>(
+            bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), 3, placement)) == expected);
+        assert((multi_exp_numa<GroupT, FieldT, multi_exp_method_bos_coster>(
+            bases.cbegin(), bases.cend(), scalars.cbegin(), scalars.cend(), 0, placement)) == expected);
+    }
+    /* more chunks than elements */
+    assert((multi_exp_numa<GroupT, FieldT, multi_exp_method_BDLO12>(
+        bases.cbegin(), bases.cbegin() + 4, scalars.cbegin(), scalars.cbegin() + 4, 5)) ==
+           naive_multi_exp(std::vector<GroupT>(bases.begin(), bases.begin() + 4),
+                           std::vector<FieldT>(scalars.begin(), scalars.begin() + 4)));
+
+    /* the workers run on the executor, so serial_executor keeps them on the calling thread */
+    set_executor(std::make_shared<serial_executor>());
+    size_t num_calls = 0;
+    const std::thread::id caller = std::this_thread::get_id();
+    numa_run_on_nodes(get_numa_nodes(), [&num_calls, caller](const size_t, const size_t, const size_t) {
+        assert(std::this_thread::get_id() == caller);
+        ++num_calls;
+    });
+    assert(num_calls == 3);
+    set_executor(nullptr);
+
+#ifdef __linux__
+    /* threads of the application that run slots are only pinned during the slot */
+    std::mutex threads_mutex;
+    std::vector<std::thread> app_threads;
+    std::vector<bool> affinity_kept;
+    set_executor(std::make_shared<function_executor>([&](executor_task task) {
+        std::lock_guard<std::mutex> lock(threads_mutex);
+        app_threads.emplace_back([&, task]() {
+            cpu_set_t before, after;
+            sched_getaffinity(0, sizeof(before), &before);
+            task();
+            sched_getaffinity(0, sizeof(after), &after);
+            std::lock_guard<std::mutex> lock(threads_mutex);
+            affinity_kept.emplace_back(CPU_EQUAL(&before, &after));
+        });
+    }, 3));
+    cpu_set_t caller_before, caller_after;
+    sched_getaffinity(0, sizeof(caller_before), &caller_before);
+    numa_run_on_nodes(get_numa_nodes(), [](const size_t, const size_t, const size_t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    });
+    sched_getaffinity(0, sizeof(caller_after), &caller_after);
+    assert(CPU_EQUAL(&caller_before, &caller_after));
+    set_executor(nullptr);
+    for (std::thread &t : app_threads)
+    {
+        t.join();
+    }
+    for (const bool kept : affinity_kept)
+    {
+        assert(kept);
+    }
+#endif
+
+    set_numa_nodes(std::vector<numa_node>());
+}
+
+template<typename GroupT, typename FieldT>
+multi_exp_partial<GroupT> compute_shard(const std::vector<GroupT> &bases,
+                                        const std::vector<FieldT> &scalars,
+                                        const size_t begin, const size_t end,
+                                        const size_t window)
+{
+    if (window == 0)
+    {
+        return multi_exp_shard<GroupT, FieldT, multi_exp_method_bos_coster>(
+            bases.cbegin() + begin, bases.cbegin() + end, scalars.cbegin() + begin, scalars.cbegin() + end,
+            begin, bases.size(), 2);
+    }
+    return multi_exp_shard_window_sums<GroupT, FieldT>(
+        bases.cbegin() + begin, bases.cbegin() + end, scalars.cbegin() + begin, scalars.cbegin() + end,
+        begin, bases.size(), window);
+}
+
+template<typename GroupT, typename FieldT>
+void test_multi_exp_shards()
+{
+    const size_t num_elements = 120;
+    std::vector<GroupT> bases(num_elements);
+    std::vector<FieldT> scalars(num_elements);
+    for (size_t i = 0; i < num_elements; ++i)
+    {
+        bases[i] = GroupT::random_element();
+        scalars[i] = FieldT::random_element();
+    }
+#ifdef USE_MIXED_ADDITION
+    batch_to_special(bases);
+#endif
+    const GroupT expected = naive_multi_exp(bases, scalars);
+    const size_t window = multi_exp_shard_window<GroupT>(num_elements);
+    const size_t bounds[] = { 0, 17, 80, num_elements };
+
+    /* window sums, an element and a mix of both, merged out of order and after a round trip through a stream */
+    const size_t windows[][3] = { { window, window, window }, { 0, 0, 0 }, { window, 0, 3 } };
+    for (const auto &w : windows)
+    {
+        std::vector<multi_exp_partial<GroupT> > partials;
+        for (size_t s = 3; s-- > 0; )
+        {
+            std::stringstream ss;
+            ss << compute_shard(bases, scalars, bounds[s], bounds[s+1], w[s]);
+            multi_exp_partial<GroupT> partial;
+            ss >> partial;
+            partials.emplace_back(partial);
+        }
+        assert(multi_exp_merge(partials) == expected);
+
+        /* as a tree */
+        const multi_exp_partial<GroupT> low = multi_exp_merge_partials(
+            std::vector<multi_exp_partial<GroupT> >(partials.begin() + 1, partials.end()));
+        assert(low.shard_begin == 0 && low.shard_end == bounds[2]);
+        assert(multi_exp_merge(std::vector<multi_exp_partial<GroupT> >({ partials[0], low })) == expected);
+
+        /* a missing shard */
+        bool caught = false;
+        try
+        {
+            multi_exp_merge(std::vector<multi_exp_partial<GroupT> >(partials.begin(), partials.begin() + 2));
+        }
+        catch (const std::invalid_argument &)
+        {
+            caught = true;
+        }
+        assert(caught);
+    }
+
+    /* malformed partials are rejected when read */
+    const multi_exp_partial<GroupT> good = compute_shard(bases, scalars, bounds[0], bounds[1], window);
+    std::vector<multi_exp_partial<GroupT> > bad(4, good);
+    bad[0].form = (multi_exp_partial_form) 7;
+    bad[1].values.pop_back();
+    bad[2].window = 0;
+    bad[3].shard_end = num_elements + 1;
+    for (const multi_exp_partial<GroupT> &b : bad)
+    {
+        std::stringstream ss;
+        ss << b;
+        multi_exp_partial<GroupT> partial;
+        ss >> partial;
+        assert(ss.fail());
+    }
+
+#ifdef __linux__
+    /* one process per shard, sending its partial result back through a pipe */
+    std::vector<multi_exp_partial<GroupT> > partials;
+    for (size_t s = 0; s < 3; ++s)
+    {
+        int fds[2];
+        assert(pipe(fds) == 0);
+        const pid_t pid = fork();
+        assert(pid >= 0);
+        if (pid == 0)
+        {
+            close(fds[0]);
+            set_executor(std::make_shared<serial_executor>());
+            std::stringstream ss;
+            ss << compute_shard(bases, scalars, bounds[s], bounds[s+1], window);
+            const std::string data = ss.str();
+            size_t written = 0;
+            while (written < data.size())
+            {
+                const ssize_t n = write(fds[1], data.data() + written, data.size() - written);
+                if (n <= 0)
+                {
+                    _exit(1);
+                }
+                written += n;
+            }
+            close(fds[1]);
+            _exit(0);
+        }
+
+        close(fds[1]);
+        std::string data;
+        char buffer[4096];
+        ssize_t n;
+        while ((n = read(fds[0], buffer, sizeof(buffer))) > 0)
+        {
+            data.append(buffer, n);
+        }
+        close(fds[0]);
+        int status;
+        assert(waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+        std::stringstream ss(data);
+        multi_exp_partial<GroupT> partial;
+        ss >> partial;
+        partials.emplace_back(partial);
+    }
+    assert(multi_exp_merge(partials) == expected);
+#endif
+}
+
+template<typename ppT>
+void test_multiexp_for_curve()
+{
+    test_multi_exp_methods<G1<ppT>, Fr<ppT> >(1);
+    test_multi_exp_methods<G1<ppT>, Fr<ppT> >(100);
+    test_multi_exp_methods<G2<ppT>, Fr<ppT> >(50);
+    test_multi_exp_batch<G1<ppT>, Fr<ppT> >(200, 5);
+    test_multi_exp_batch<G2<ppT>, Fr<ppT> >(20, 3);
+    test_multi_exp_stream<G1<ppT>, Fr<ppT> >(300, 64);
+    test_multi_exp_stream<G2<ppT>, Fr<ppT> >(30, 7);
+    test_multi_exp_stream_failure<G1<ppT>, Fr<ppT> >();
+    test_batch_exp_affine<G1<ppT>, Fr<ppT> >();
+    test_batch_exp_affine<G2<ppT>, Fr<ppT> >();
+    test_multi_exp_op_counts<G1<ppT>, Fr<ppT> >(100);
+    test_memory_accounting<ppT>();
+    test_progress_and_cancellation<G1<ppT>, Fr<ppT> >();
+    test_executors<G1<ppT>, Fr<ppT> >();
+    test_async_multi_exp<G1<ppT>, Fr<ppT> >(std::make_shared<thread_pool_executor>(2));
+#ifdef MULTICORE
+    test_async_multi_exp<G1<ppT>, Fr<ppT> >(std::make_shared<openmp_executor>());
+#endif
+#ifdef MULTICORE
+    test_async_multi_exp_openmp<G1<ppT>, Fr<ppT> >();
+#endif
+    test_multi_exp_numa<G1<ppT>, Fr<ppT> >();
+    test_multi_exp_shards<G1<ppT>, Fr<ppT> >();
+    test_multi_exp_shards<G2<ppT>, Fr<ppT> >();
+}
+
+int main(void)
+{
+    inhibit_profiling_info = true;
+
+    test_op_counter_threads();
+    test_profiling_threads();
+
+    printf("alt_bn128: \n");
+    alt_bn128_pp::init_public_params();
+    test_multiexp_for_curve<alt_bn128_pp>();
+
+    printf("bls12_381: \n");
+    bls12_381_pp::init_public_params();
+    test_multiexp_for_curve<bls12_381_pp>();
+
+    printf("mnt4: \n");
+    mnt4_pp::init_public_params();
+    test_multiexp_for_curve<mnt4_pp>();
+}
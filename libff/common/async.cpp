@@ -0,0 +1,76 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of asynchronous execution on the library's executor.
+
+ See async.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <libff/common/async.hpp>
+
+namespace libff {
+
+void async_state_base::finish()
+{
+    std::vector<std::function<void()> > to_run;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        to_run.swap(continuations);
+    }
+    cv.notify_all();
+
+    for (const std::function<void()> &f : to_run)
+    {
+        f();
+    }
+}
+
+void async_state_base::on_done(const std::function<void()> &f)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!done)
+        {
+            continuations.emplace_back(f);
+            return;
+        }
+    }
+    f();
+}
+
+void async_state_base::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    cv.wait(lock, [this]() { return done; });
+}
+
+bool async_handle::ready() const
+{
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->done;
+}
+
+void async_value<void>::get() const
+{
+    state->wait();
+    if (state->error)
+    {
+        std::rethrow_exception(state->error);
+    }
+}
+
+void async_wait_all(const std::vector<async_handle> &handles)
+{
+    for (const async_handle &h : handles)
+    {
+        h.wait();
+    }
+}
+
+} // libff
@@ -0,0 +1,117 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of asynchronous execution on the library's executor.
+
+ async_submit(f, deps) runs f on the executor (see execution.hpp) once all
+ handles in deps have completed, and returns an async_value for its result:
+
+     async_value<G1> A = multi_exp_async<G1, Fr, multi_exp_method_BDLO12>(...);
+     async_value<G2> B = multi_exp_async<G2, Fr, multi_exp_method_BDLO12>(...);
+     async_value<GT> e = async_submit([A, B]() { return pp::reduced_pairing(A.get(), B.get()); }, { A, B });
+
+ Tasks are started when their dependencies are done instead of blocking a
+ worker on get(), so chains of submissions never tie up threads. If a
+ dependency failed, get() on it rethrows its exception, which then becomes the
+ result of the dependent task. A task carries over the progress callback and
+ cancellation token of the thread that submitted it (see progress.hpp).
+
+ With serial_executor, tasks run on the submitting thread before async_submit
+ returns (or when their last dependency completes).
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef ASYNC_HPP_
+#define ASYNC_HPP_
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include <libff/common/execution.hpp>
+#include <libff/common/progress.hpp>
+
+namespace libff {
+
+struct async_state_base {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    std::exception_ptr error;
+    std::vector<std::function<void()> > continuations;
+
+    /* mark as done and run the continuations */
+    void finish();
+    /* run f once done (right away if already done) */
+    void on_done(const std::function<void()> &f);
+    void wait();
+};
+
+template<typename T>
+struct async_state : public async_state_base {
+    T value;
+};
+
+template<>
+struct async_state<void> : public async_state_base {
+};
+
+/* Type-erased handle, used to list dependencies. */
+class async_handle {
+protected:
+    std::shared_ptr<async_state_base> state;
+public:
+    async_handle() = default;
+    explicit async_handle(const std::shared_ptr<async_state_base> &state) : state(state) {}
+
+    bool valid() const { return (bool) state; }
+    bool ready() const;
+    void wait() const { state->wait(); }
+    void on_done(const std::function<void()> &f) const { state->on_done(f); }
+};
+
+template<typename T>
+class async_value : public async_handle {
+public:
+    async_value() = default;
+    explicit async_value(const std::shared_ptr<async_state<T> > &state) : async_handle(state) {}
+
+    /* wait for the result; rethrows the exception of a failed task */
+    const T& get() const;
+};
+
+template<>
+class async_value<void> : public async_handle {
+public:
+    async_value() = default;
+    explicit async_value(const std::shared_ptr<async_state<void> > &state) : async_handle(state) {}
+
+    void get() const;
+};
+
+/* An already completed value, e.g. to pass to a function that expects a handle. */
+template<typename T>
+async_value<T> async_ready(const T &value);
+
+template<typename F>
+async_value<typename std::result_of<F()>::type> async_submit(
+    const F &f,
+    const std::vector<async_handle> &deps = std::vector<async_handle>(),
+    const std::shared_ptr<executor> &exec = get_executor());
+
+/* Wait for all handles; does not rethrow. */
+void async_wait_all(const std::vector<async_handle> &handles);
+
+} // libff
+
+#include <libff/common/async.tcc>
+
+#endif // ASYNC_HPP_
@@ -0,0 +1,102 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of asynchronous execution on the library's executor.
+
+ See async.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef ASYNC_TCC_
+#define ASYNC_TCC_
+
+#include <atomic>
+
+namespace libff {
+
+template<typename T>
+const T& async_value<T>::get() const
+{
+    this->state->wait();
+    if (this->state->error)
+    {
+        std::rethrow_exception(this->state->error);
+    }
+    return static_cast<const async_state<T>&>(*this->state).value;
+}
+
+template<typename T>
+async_value<T> async_ready(const T &value)
+{
+    std::shared_ptr<async_state<T> > state = std::make_shared<async_state<T> >();
+    state->value = value;
+    state->finish();
+    return async_value<T>(state);
+}
+
+template<typename T, typename F>
+void async_store_result(async_state<T> &state, const F &f)
+{
+    state.value = f();
+}
+
+template<typename F>
+void async_store_result(async_state<void> &, const F &f)
+{
+    f();
+}
+
+template<typename F>
+async_value<typename std::result_of<F()>::type> async_submit(
+    const F &f,
+    const std::vector<async_handle> &deps,
+    const std::shared_ptr<executor> &exec)
+{
+    typedef typename std::result_of<F()>::type result_type;
+    std::shared_ptr<async_state<result_type> > state = std::make_shared<async_state<result_type> >();
+    const progress_context context = get_progress_context();
+
+    const std::function<void()> run = [state, f, context]() {
+        const progress_context saved = get_progress_context();
+        set_progress_context(context);
+        try
+        {
+            async_store_result(*state, f);
+        }
+        catch (...)
+        {
+            state->error = std::current_exception();
+        }
+        set_progress_context(saved);
+        state->finish();
+    };
+
+    if (deps.empty())
+    {
+        exec->submit(run);
+    }
+    else
+    {
+        /* the last dependency to complete submits the task */
+        std::shared_ptr<std::atomic<size_t> > pending = std::make_shared<std::atomic<size_t> >(deps.size());
+        for (const async_handle &dep : deps)
+        {
+            dep.on_done([pending, exec, run]() {
+                if (pending->fetch_sub(1) == 1)
+                {
+                    exec->submit(run);
+                }
+            });
+        }
+    }
+
+    return async_value<result_type>(state);
+}
+
+} // libff
+
+#endif // ASYNC_TCC_
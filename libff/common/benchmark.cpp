@@ -0,0 +1,539 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of a small benchmark harness with JSON output.
+
+ See benchmark.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include <libff/common/benchmark.hpp>
+#include <libff/common/execution.hpp>
+#include <libff/common/profiling.hpp>
+
+namespace libff {
+
+static void write_json_string(std::ostream &out, const std::string &s)
+{
+    out << '"';
+    for (const char ch : s)
+    {
+        if (ch == '"' || ch == '\\')
+        {
+            out << '\\' << ch;
+        }
+        else if (static_cast<unsigned char>(ch) < 0x20)
+        {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", ch);
+            out << buf;
+        }
+        else
+        {
+            out << ch;
+        }
+    }
+    out << '"';
+}
+
+static std::map<std::string, std::string> build_context()
+{
+    std::map<std::string, std::string> context;
+#ifdef __GNUC__
+    context["compiler"] = __VERSION__;
+#endif
+#ifdef MULTICORE
+    context["multicore"] = "yes";
+#else
+    context["multicore"] = "no";
+#endif
+    context["executor"] = get_executor()->name();
+    context["threads"] = std::to_string(get_executor()->concurrency());
+#ifdef USE_ASM
+    context["use_asm"] = "yes";
+#else
+    context["use_asm"] = "no";
+#endif
+#ifdef USE_MIXED_ADDITION
+    context["use_mixed_addition"] = "yes";
+#else
+    context["use_mixed_addition"] = "no";
+#endif
+#ifdef DEBUG
+    context["debug"] = "yes";
+#else
+    context["debug"] = "no";
+#endif
+#ifdef NDEBUG
+    context["ndebug"] = "yes";
+#else
+    context["ndebug"] = "no";
+#endif
+#ifdef PROFILE_OP_COUNTS
+    context["profile_op_counts"] = "yes";
+#else
+    context["profile_op_counts"] = "no";
+#endif
+    return context;
+}
+
+benchmark_suite::benchmark_suite(const std::string &suite_name) :
+    suite_name(suite_name),
+    output_path(suite_name + ".json"),
+    min_time_ns(500e6),
+    min_log_size(4),
+    max_log_size(16),
+    chunks(1)
+{
+}
+
+bool benchmark_suite::parse_args(const int argc, const char * const *argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (i + 1 == argc && arg != "--help")
+        {
+            fprintf(stderr, "Missing value for %s\n", arg.c_str());
+            return false;
+        }
+        const std::string value = (arg == "--help" ? "" : argv[++i]);
+
+        if (arg == "--output")
+        {
+            output_path = value;
+        }
+        else if (arg == "--filter")
+        {
+            filters.emplace_back(value);
+        }
+        else if (arg == "--min-time-ms")
+        {
+            min_time_ns = atof(value.c_str()) * 1e6;
+        }
+        else if (arg == "--min-log-size")
+        {
+            min_log_size = atol(value.c_str());
+        }
+        else if (arg == "--max-log-size")
+        {
+            max_log_size = atol(value.c_str());
+        }
+        else if (arg == "--chunks")
+        {
+            chunks = std::max(1l, atol(value.c_str()));
+        }
+        else
+        {
+            fprintf(stderr,
+                    "Usage: %s [--output FILE] [--filter SUBSTRING]... [--min-time-ms T]\n"
+                    "       [--min-log-size N] [--max-log-size N] [--chunks N]\n",
+                    argv[0]);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool benchmark_suite::enabled(const std::string &name) const
+{
+    if (filters.empty())
+    {
+        return true;
+    }
+    for (const std::string &f : filters)
+    {
+        if (name.find(f) != std::string::npos)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void benchmark_suite::run(const std::string &name, const size_t size, const std::function<void(size_t)> &body)
+{
+    if (!enabled(name))
+    {
+        return;
+    }
+
+    /* calibrate, so that a sample takes about a fifth of the minimum time */
+    const double target_ns = min_time_ns / 5;
+    size_t iterations = 1;
+    double elapsed;
+    while (true)
+    {
+        const long long start = get_nsec_time();
+        body(iterations);
+        elapsed = get_nsec_time() - start;
+        if (elapsed >= target_ns || iterations >= (1ul << 40))
+        {
+            break;
+        }
+        const double factor = (elapsed > 0 ? 1.2 * target_ns / elapsed : 100.);
+        iterations = std::max(iterations + 1, (size_t) (iterations * std::min(factor, 100.)));
+    }
+
+    std::vector<double> samples = { elapsed / iterations };
+    double total = elapsed;
+    while (samples.size() < 5 && total < min_time_ns)
+    {
+        const long long start = get_nsec_time();
+        body(iterations);
+        const double t = get_nsec_time() - start;
+        samples.emplace_back(t / iterations);
+        total += t;
+    }
+    std::sort(samples.begin(), samples.end());
+
+    benchmark_result result;
+    result.name = name;
+    result.size = size;
+    result.iterations = iterations;
+    result.samples = samples.size();
+    result.ns_per_op = samples[samples.size() / 2];
+    result.min_ns_per_op = samples[0];
+    results.emplace_back(result);
+
+    printf("%-50s %10zu %16.1f ns/op (%zu x %zu)\n",
+           name.c_str(), size, result.ns_per_op, result.samples, result.iterations);
+    fflush(stdout);
+}
+
+void benchmark_suite::write_json(std::ostream &out) const
+{
+    out << "{\n  \"suite\": ";
+    write_json_string(out, suite_name);
+    out << ",\n  \"context\": {";
+    bool first = true;
+    for (auto &kv : build_context())
+    {
+        out << (first ? "\n    " : ",\n    ");
+        write_json_string(out, kv.first);
+        out << ": ";
+        write_json_string(out, kv.second);
+        first = false;
+    }
+    out << "\n  },\n  \"benchmarks\": [";
+
+    char buf[64];
+    for (size_t i = 0; i < results.size(); ++i)
+    {
+        const benchmark_result &r = results[i];
+        out << (i == 0 ? "\n    " : ",\n    ") << "{\"name\": ";
+        write_json_string(out, r.name);
+        out << ", \"size\": " << r.size
+            << ", \"iterations\": " << r.iterations
+            << ", \"samples\": " << r.samples;
+        snprintf(buf, sizeof(buf), "%.3f", r.ns_per_op);
+        out << ", \"ns_per_op\": " << buf;
+        snprintf(buf, sizeof(buf), "%.3f", r.min_ns_per_op);
+        out << ", \"min_ns_per_op\": " << buf << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+int benchmark_suite::finish() const
+{
+    std::ofstream out(output_path);
+    if (!out)
+    {
+        fprintf(stderr, "Cannot write %s\n", output_path.c_str());
+        return 1;
+    }
+    write_json(out);
+    printf("Wrote %zu results to %s\n", results.size(), output_path.c_str());
+    return 0;
+}
+
+/* Minimal JSON reader, sufficient for the files written by write_json. */
+struct json_value {
+    enum { null_value, bool_value, number_value, string_value, array_value, object_value } kind = null_value;
+    double number = 0;
+    std::string str;
+    std::vector<json_value> items;
+    std::vector<std::pair<std::string, json_value> > members;
+
+    const json_value* get(const std::string &key) const
+    {
+        for (auto &kv : members)
+        {
+            if (kv.first == key)
+            {
+                return &kv.second;
+            }
+        }
+        return nullptr;
+    }
+};
+
+class json_reader {
+private:
+    const std::string &text;
+    size_t pos;
+
+    void skip_whitespace()
+    {
+        while (pos < text.size() && isspace(static_cast<unsigned char>(text[pos])))
+        {
+            ++pos;
+        }
+    }
+
+    void fail(const std::string &what) const
+    {
+        throw std::runtime_error("JSON parse error at offset " + std::to_string(pos) + ": " + what);
+    }
+
+    void expect(const char ch)
+    {
+        skip_whitespace();
+        if (pos >= text.size() || text[pos] != ch)
+        {
+            fail(std::string("expected '") + ch + "'");
+        }
+        ++pos;
+    }
+
+    std::string parse_string()
+    {
+        expect('"');
+        std::string result;
+        while (pos < text.size() && text[pos] != '"')
+        {
+            char ch = text[pos++];
+            if (ch == '\\')
+            {
+                if (pos >= text.size())
+                {
+                    fail("unterminated escape");
+                }
+                ch = text[pos++];
+                switch (ch)
+                {
+                case 'n': result += '\n'; break;
+                case 't': result += '\t'; break;
+                case 'r': result += '\r'; break;
+                case 'b': result += '\b'; break;
+                case 'f': result += '\f'; break;
+                case 'u':
+                    /* only the control characters written by write_json_string */
+                    result += static_cast<char>(strtol(text.substr(pos, 4).c_str(), nullptr, 16));
+                    pos += 4;
+                    break;
+                default: result += ch; break;
+                }
+            }
+            else
+            {
+                result += ch;
+            }
+        }
+        expect('"');
+        return result;
+    }
+
+public:
+    explicit json_reader(const std::string &text) : text(text), pos(0) {}
+
+    json_value parse_value()
+    {
+        skip_whitespace();
+        if (pos >= text.size())
+        {
+            fail("unexpected end of input");
+        }
+
+        json_value v;
+        const char ch = text[pos];
+        if (ch == '{')
+        {
+            v.kind = json_value::object_value;
+            ++pos;
+            skip_whitespace();
+            if (pos < text.size() && text[pos] == '}')
+            {
+                ++pos;
+                return v;
+            }
+            while (true)
+            {
+                std::string key = parse_string();
+                expect(':');
+                v.members.emplace_back(key, parse_value());
+                skip_whitespace();
+                if (pos < text.size() && text[pos] == ',')
+                {
+                    ++pos;
+                    continue;
+                }
+                expect('}');
+                return v;
+            }
+        }
+        else if (ch == '[')
+        {
+            v.kind = json_value::array_value;
+            ++pos;
+            skip_whitespace();
+            if (pos < text.size() && text[pos] == ']')
+            {
+                ++pos;
+                return v;
+            }
+            while (true)
+            {
+                v.items.emplace_back(parse_value());
+                skip_whitespace();
+                if (pos < text.size() && text[pos] == ',')
+                {
+                    ++pos;
+                    continue;
+                }
+                expect(']');
+                return v;
+            }
+        }
+        else if (ch == '"')
+        {
+            v.kind = json_value::string_value;
+            v.str = parse_string();
+        }
+        else if (text.compare(pos, 4, "true") == 0 || text.compare(pos, 5, "false") == 0)
+        {
+            v.kind = json_value::bool_value;
+            v.number = (ch == 't');
+            pos += (ch == 't' ? 4 : 5);
+        }
+        else if (text.compare(pos, 4, "null") == 0)
+        {
+            pos += 4;
+        }
+        else
+        {
+            const char *start = text.c_str() + pos;
+            char *end;
+            v.kind = json_value::number_value;
+            v.number = strtod(start, &end);
+            if (end == start)
+            {
+                fail("unexpected character");
+            }
+            pos += end - start;
+        }
+        return v;
+    }
+};
+
+benchmark_run read_benchmark_json(const std::string &path)
+{
+    std::ifstream in(path);
+    if (!in)
+    {
+        throw std::runtime_error("cannot read " + path);
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+    const json_value root = json_reader(text).parse_value();
+
+    benchmark_run run;
+    const json_value *context = root.get("context");
+    if (context != nullptr)
+    {
+        for (auto &kv : context->members)
+        {
+            run.context[kv.first] = kv.second.str;
+        }
+    }
+
+    const json_value *benchmarks = root.get("benchmarks");
+    if (benchmarks == nullptr || benchmarks->kind != json_value::array_value)
+    {
+        throw std::runtime_error(path + ": no benchmarks array");
+    }
+    for (const json_value &b : benchmarks->items)
+    {
+        const json_value *name = b.get("name");
+        const json_value *ns_per_op = b.get("ns_per_op");
+        if (name == nullptr || ns_per_op == nullptr)
+        {
+            throw std::runtime_error(path + ": benchmark without name or ns_per_op");
+        }
+
+        benchmark_result r;
+        r.name = name->str;
+        r.size = (b.get("size") ? (size_t) b.get("size")->number : 1);
+        r.iterations = (b.get("iterations") ? (size_t) b.get("iterations")->number : 1);
+        r.samples = (b.get("samples") ? (size_t) b.get("samples")->number : 1);
+        r.ns_per_op = ns_per_op->number;
+        r.min_ns_per_op = (b.get("min_ns_per_op") ? b.get("min_ns_per_op")->number : r.ns_per_op);
+        run.results.emplace_back(r);
+    }
+    return run;
+}
+
+size_t compare_benchmark_results(const benchmark_run &baseline, const benchmark_run &current,
+                                 const double threshold_percent)
+{
+    for (auto &kv : baseline.context)
+    {
+        auto it = current.context.find(kv.first);
+        if (kv.first != "compiler" && it != current.context.end() && it->second != kv.second)
+        {
+            printf("* Warning: %s differs (baseline: %s, current: %s)\n",
+                   kv.first.c_str(), kv.second.c_str(), it->second.c_str());
+        }
+    }
+
+    std::map<std::pair<std::string, size_t>, const benchmark_result*> baseline_by_key;
+    for (const benchmark_result &r : baseline.results)
+    {
+        baseline_by_key[std::make_pair(r.name, r.size)] = &r;
+    }
+
+    printf("%-50s %10s %16s %16s %9s\n", "benchmark", "size", "baseline ns/op", "current ns/op", "change");
+    size_t num_regressions = 0;
+    for (const benchmark_result &r : current.results)
+    {
+        auto it = baseline_by_key.find(std::make_pair(r.name, r.size));
+        if (it == baseline_by_key.end())
+        {
+            printf("%-50s %10zu %16s %16.1f %9s\n", r.name.c_str(), r.size, "-", r.ns_per_op, "new");
+            continue;
+        }
+
+        const double base = it->second->ns_per_op;
+        const double change = (base > 0 ? 100. * (r.ns_per_op - base) / base : 0.);
+        const bool regression = (change > threshold_percent);
+        num_regressions += regression;
+        printf("%-50s %10zu %16.1f %16.1f %+8.1f%%%s\n",
+               r.name.c_str(), r.size, base, r.ns_per_op, change,
+               regression ? "  REGRESSION" : (change < -threshold_percent ? "  improved" : ""));
+        baseline_by_key.erase(it);
+    }
+    for (auto &kv : baseline_by_key)
+    {
+        printf("%-50s %10zu %16.1f %16s %9s\n",
+               kv.first.first.c_str(), kv.first.second, kv.second->ns_per_op, "-", "missing");
+    }
+
+    printf("%zu regression(s) above %.1f%%\n", num_regressions, threshold_percent);
+    return num_regressions;
+}
+
+} // libff
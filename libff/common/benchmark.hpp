@@ -0,0 +1,104 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of a small benchmark harness with JSON output.
+
+ A benchmark_suite times named operations (each with a problem size, e.g. the
+ number of terms of a multi-exponentiation), prints a line per benchmark and
+ writes all results, together with the build configuration, as JSON. Results
+ of two runs can be compared with compare_benchmark_results (see the
+ benchmark_compare tool).
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef BENCHMARK_HPP_
+#define BENCHMARK_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace libff {
+
+struct benchmark_result {
+    std::string name;
+    size_t size;
+    size_t iterations; // per sample
+    size_t samples;
+    double ns_per_op; // median over samples
+    double min_ns_per_op;
+};
+
+/* Keep the compiler from optimizing away the computation of x. */
+template<typename T>
+inline void benchmark_keep(const T &x)
+{
+#ifdef __GNUC__
+    __asm__ __volatile__("" : : "r"(&x) : "memory");
+#else
+    static volatile const void *sink;
+    sink = &x;
+#endif
+}
+
+class benchmark_suite {
+private:
+    std::string suite_name;
+    std::string output_path;
+    std::vector<std::string> filters;
+    double min_time_ns;
+    std::vector<benchmark_result> results;
+public:
+    size_t min_log_size;
+    size_t max_log_size;
+    size_t chunks;
+
+    explicit benchmark_suite(const std::string &suite_name);
+
+    /**
+     * Parse --output FILE, --filter SUBSTRING (repeatable), --min-time-ms T,
+     * --min-log-size N, --max-log-size N and --chunks N. Returns false (after
+     * printing usage) on bad arguments.
+     */
+    bool parse_args(const int argc, const char * const *argv);
+
+    bool enabled(const std::string &name) const;
+
+    /**
+     * Time body(iterations), which must perform the benchmarked operation
+     * `iterations` times. The number of iterations is calibrated so that each
+     * sample takes a fraction of the minimum time; slow operations (e.g. large
+     * multi-exponentiations) are run only once.
+     */
+    void run(const std::string &name, const size_t size, const std::function<void(size_t)> &body);
+
+    const std::vector<benchmark_result>& get_results() const { return results; }
+    void write_json(std::ostream &out) const;
+    /* writes the JSON output; returns the exit code for main */
+    int finish() const;
+};
+
+struct benchmark_run {
+    std::map<std::string, std::string> context;
+    std::vector<benchmark_result> results;
+};
+
+benchmark_run read_benchmark_json(const std::string &path);
+
+/**
+ * Print a comparison of two runs and return the number of benchmarks that got
+ * slower by more than threshold_percent.
+ */
+size_t compare_benchmark_results(const benchmark_run &baseline, const benchmark_run &current,
+                                 const double threshold_percent);
+
+} // libff
+
+#endif // BENCHMARK_HPP_
@@ -41,10 +41,10 @@ namespace libff {
     val = num;
   }
 
-  unsigned Double::add_cnt = 0;
-  unsigned Double::sub_cnt = 0;
-  unsigned Double::mul_cnt = 0;
-  unsigned Double::inv_cnt = 0;
+  op_counter Double::add_cnt("Double::add");
+  op_counter Double::sub_cnt("Double::sub");
+  op_counter Double::mul_cnt("Double::mul");
+  op_counter Double::inv_cnt("Double::inv");
 
   Double Double::operator+(const Double &other) const
   {
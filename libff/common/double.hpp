@@ -15,6 +15,7 @@
 #include <complex>
 
 #include <libff/algebra/fields/bigint.hpp>
+#include <libff/common/op_counts.hpp>
 
 namespace libff {
 
@@ -31,10 +32,10 @@ namespace libff {
 
       Double(std::complex<double> num);
 
-      static unsigned add_cnt;
-      static unsigned sub_cnt;
-      static unsigned mul_cnt;
-      static unsigned inv_cnt;
+      static op_counter add_cnt;
+      static op_counter sub_cnt;
+      static op_counter mul_cnt;
+      static op_counter inv_cnt;
 
       Double operator+(const Double &other) const;
       Double operator-(const Double &other) const;
@@ -0,0 +1,401 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of the execution backend.
+
+ See execution.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+
+#include <libff/common/execution.hpp>
+#include <libff/common/perf_counters.hpp>
+
+#ifdef MULTICORE
+#include <omp.h>
+#endif
+
+namespace libff {
+
+static thread_local size_t parallel_depth = 0;
+
+/* the pool and queue the calling thread works for, if it is a pool worker */
+static thread_local const void *current_pool = nullptr;
+static thread_local size_t current_queue = 0;
+
+bool in_parallel_region()
+{
+    return parallel_depth > 0;
+}
+
+struct parallel_for_state {
+    size_t end;
+    size_t grain;
+    std::atomic<size_t> next;
+    /* iterations that have not finished yet */
+    std::atomic<size_t> remaining;
+    const std::function<void(size_t)> *body;
+
+    std::atomic<bool> failed;
+    std::mutex mutex;
+    std::exception_ptr error;
+    std::condition_variable finished;
+};
+
+static void record_error(parallel_for_state &state)
+{
+    std::lock_guard<std::mutex> lock(state.mutex);
+    if (!state.error)
+    {
+        state.error = std::current_exception();
+    }
+    state.failed.store(true);
+}
+
+/* Claim and run ranges of iterations until none are left. */
+static void run_iterations(parallel_for_state &state)
+{
+#ifdef PROFILE_PERF_EVENTS
+    register_perf_thread();
+#endif
+    ++parallel_depth;
+    while (true)
+    {
+        const size_t start = state.next.fetch_add(state.grain);
+        if (start >= state.end)
+        {
+            break;
+        }
+        const size_t stop = std::min(start + state.grain, state.end);
+
+        if (!state.failed.load(std::memory_order_relaxed))
+        {
+            try
+            {
+                for (size_t i = start; i < stop; ++i)
+                {
+                    (*state.body)(i);
+                }
+            }
+            catch (...)
+            {
+                record_error(state);
+            }
+        }
+        if (state.remaining.fetch_sub(stop - start) == stop - start)
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.finished.notify_all();
+        }
+    }
+    --parallel_depth;
+}
+
+void executor::parallel_for(const size_t begin, const size_t end,
+                            const std::function<void(size_t)> &body)
+{
+    if (begin >= end)
+    {
+        return;
+    }
+
+    const size_t n = end - begin;
+    const size_t threads = std::max<size_t>(1, concurrency());
+    /* a few ranges per thread, so that threads finishing early can help the others */
+    const size_t grain = std::max<size_t>(1, n / (4 * threads));
+    const size_t num_ranges = (n + grain - 1) / grain;
+
+    std::shared_ptr<parallel_for_state> state = std::make_shared<parallel_for_state>();
+    state->end = end;
+    state->grain = grain;
+    state->next.store(begin);
+    state->remaining.store(n);
+    state->body = &body;
+    state->failed.store(false);
+
+    /* helpers that start after all ranges have been claimed return right away */
+    const size_t num_helpers = std::min(threads, num_ranges) - 1;
+    for (size_t i = 0; i < num_helpers; ++i)
+    {
+        submit([state]() { run_iterations(*state); });
+    }
+
+    run_iterations(*state);
+
+    /* wait for the ranges other threads are still working on, helping with queued tasks meanwhile */
+    while (state->remaining.load() > 0)
+    {
+        if (!run_pending_task())
+        {
+            std::unique_lock<std::mutex> lock(state->mutex);
+            state->finished.wait_for(lock, std::chrono::milliseconds(1),
+                                     [&state]() { return state->remaining.load() == 0; });
+        }
+    }
+
+    if (state->error)
+    {
+        std::rethrow_exception(state->error);
+    }
+}
+
+void serial_executor::parallel_for(const size_t begin, const size_t end,
+                                   const std::function<void(size_t)> &body)
+{
+    ++parallel_depth;
+    try
+    {
+        for (size_t i = begin; i < end; ++i)
+        {
+            body(i);
+        }
+    }
+    catch (...)
+    {
+        --parallel_depth;
+        throw;
+    }
+    --parallel_depth;
+}
+
+#ifdef MULTICORE
+size_t openmp_executor::concurrency() const
+{
+    return omp_get_max_threads();
+}
+
+thread_pool_executor& openmp_executor::task_pool()
+{
+    std::lock_guard<std::mutex> lock(pool_mutex);
+    if (!pool)
+    {
+        pool.reset(new thread_pool_executor(concurrency()));
+    }
+    return *pool;
+}
+
+void openmp_executor::submit(executor_task task)
+{
+    task_pool().submit(std::move(task));
+}
+
+void openmp_executor::parallel_for(const size_t begin, const size_t end,
+                                   const std::function<void(size_t)> &body)
+{
+    if (omp_in_parallel() || in_parallel_region())
+    {
+        serial_executor().parallel_for(begin, end, body);
+        return;
+    }
+    if (current_pool != nullptr)
+    {
+        /*
+          Called from a submitted task: its worker is not an OpenMP thread,
+          and an OpenMP team per task would multiply the threads by the
+          number of concurrent tasks. The loop is shared with the pool's
+          workers instead.
+        */
+        task_pool().parallel_for(begin, end, body);
+        return;
+    }
+
+    parallel_for_state state;
+    state.failed.store(false);
+
+#pragma omp parallel for
+    for (size_t i = begin; i < end; ++i)
+    {
+        if (state.failed.load(std::memory_order_relaxed))
+        {
+            continue;
+        }
+#ifdef PROFILE_PERF_EVENTS
+        register_perf_thread();
+#endif
+        ++parallel_depth;
+        try
+        {
+            body(i);
+        }
+        catch (...)
+        {
+            record_error(state);
+        }
+        --parallel_depth;
+    }
+
+    if (state.error)
+    {
+        std::rethrow_exception(state.error);
+    }
+}
+#endif
+
+thread_pool_executor::thread_pool_executor(const size_t num_threads) :
+    state(std::make_shared<pool_state>())
+{
+    size_t n = num_threads;
+    if (n == 0)
+    {
+        n = std::max<size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    state->queued.store(0);
+    state->next_queue.store(0);
+    state->stopping = false;
+    for (size_t i = 0; i < n; ++i)
+    {
+        state->queues.emplace_back(new worker_queue());
+    }
+    for (size_t i = 0; i < n; ++i)
+    {
+        const std::shared_ptr<pool_state> worker_state = state;
+        workers.emplace_back([worker_state, i]() { worker_loop(worker_state, i); });
+    }
+}
+
+thread_pool_executor::~thread_pool_executor()
+{
+    {
+        std::lock_guard<std::mutex> lock(state->sleep_mutex);
+        state->stopping = true;
+    }
+    state->wake.notify_all();
+    for (std::thread &t : workers)
+    {
+        if (t.get_id() == std::this_thread::get_id())
+        {
+            /* destroyed by one of its own tasks; this worker exits once the task returns */
+            t.detach();
+        }
+        else
+        {
+            t.join();
+        }
+    }
+}
+
+void thread_pool_executor::submit(executor_task task)
+{
+    if (current_pool == state.get())
+    {
+        /* own queue, taken LIFO by this worker and FIFO by thieves */
+        worker_queue &q = *state->queues[current_queue];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.emplace_front(std::move(task));
+    }
+    else
+    {
+        worker_queue &q = *state->queues[state->next_queue.fetch_add(1) % state->queues.size()];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        q.tasks.emplace_back(std::move(task));
+    }
+    state->queued.fetch_add(1);
+
+    {
+        std::lock_guard<std::mutex> lock(state->sleep_mutex);
+    }
+    state->wake.notify_one();
+}
+
+bool thread_pool_executor::pool_state::pop_task(const size_t own_queue, executor_task &task)
+{
+    const size_t n = queues.size();
+    for (size_t k = 0; k < n; ++k)
+    {
+        worker_queue &q = *queues[(own_queue + k) % n];
+        std::lock_guard<std::mutex> lock(q.mutex);
+        if (q.tasks.empty())
+        {
+            continue;
+        }
+        if (k == 0 && current_pool == this)
+        {
+            task = std::move(q.tasks.front());
+            q.tasks.pop_front();
+        }
+        else
+        {
+            task = std::move(q.tasks.back());
+            q.tasks.pop_back();
+        }
+        queued.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+bool thread_pool_executor::run_pending_task()
+{
+    executor_task task;
+    if (!state->pop_task(current_pool == state.get() ? current_queue : 0, task))
+    {
+        return false;
+    }
+    task();
+    return true;
+}
+
+void thread_pool_executor::worker_loop(const std::shared_ptr<pool_state> &state, const size_t index)
+{
+    current_pool = state.get();
+    current_queue = index;
+#ifdef PROFILE_PERF_EVENTS
+    register_perf_thread();
+#endif
+
+    executor_task task;
+    while (true)
+    {
+        if (state->pop_task(index, task))
+        {
+            task();
+            task = nullptr;
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(state->sleep_mutex);
+        state->wake.wait(lock, [&state]() { return state->stopping || state->queued.load() > 0; });
+        if (state->stopping && state->queued.load() == 0)
+        {
+            return;
+        }
+    }
+}
+
+static std::mutex executor_mutex;
+static std::shared_ptr<executor> current_executor;
+
+static std::shared_ptr<executor> default_executor()
+{
+#ifdef MULTICORE
+    return std::make_shared<openmp_executor>();
+#else
+    return std::make_shared<serial_executor>();
+#endif
+}
+
+std::shared_ptr<executor> get_executor()
+{
+    std::lock_guard<std::mutex> lock(executor_mutex);
+    if (!current_executor)
+    {
+        current_executor = default_executor();
+    }
+    return current_executor;
+}
+
+void set_executor(const std::shared_ptr<executor> &exec)
+{
+    std::lock_guard<std::mutex> lock(executor_mutex);
+    current_executor = exec;
+}
+
+} // libff
@@ -0,0 +1,173 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of the execution backend used for all parallel regions of the
+ library (multi_exp chunks, batch_exp, batch_as_bigint, ...).
+
+ Parallel loops are written as parallel_for(begin, end, body) and run on the
+ process-wide executor, which can be replaced with set_executor:
+
+ - serial_executor runs everything on the calling thread (the default
+   without MULTICORE);
+ - openmp_executor uses `#pragma omp parallel for` (the default with
+   MULTICORE); a parallel_for nested in another parallel region runs
+   serially on the calling thread, as with OpenMP's default of no nested
+   parallelism. Submitted tasks (e.g. of async_submit) run on a
+   thread_pool_executor with one worker per OpenMP thread, started on the
+   first submission and joined when the executor is destroyed; a
+   parallel_for called from such a task runs on that pool rather than on an
+   OpenMP team, so concurrent tasks share its workers;
+ - thread_pool_executor is a work-stealing pool with a fixed set of workers.
+   A parallel_for called from one of its workers (or from several
+   application threads at once) shares the same workers instead of starting
+   more threads, and the calling thread works on the loop too;
+ - an application can plug in its own thread pool by deriving from executor
+   and implementing submit and concurrency, or with function_executor.
+
+ The generic parallel_for never blocks on a task that has not started: the
+ calling thread claims iterations itself and only waits for iterations that
+ another thread is already executing. It is therefore safe even if the
+ external pool is saturated, or is the pool the caller runs on.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef EXECUTION_HPP_
+#define EXECUTION_HPP_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace libff {
+
+typedef std::function<void()> executor_task;
+
+class executor {
+public:
+    virtual ~executor() {}
+
+    virtual const char* name() const = 0;
+    /* number of threads that can work on a parallel_for at the same time */
+    virtual size_t concurrency() const = 0;
+    /* run task asynchronously (or, for serial_executor, right away) */
+    virtual void submit(executor_task task) = 0;
+
+    /**
+     * Run body(i) for every i in [begin, end) and return when all calls have
+     * returned. If a call throws, the remaining iterations are skipped and
+     * the first exception is rethrown.
+     */
+    virtual void parallel_for(const size_t begin, const size_t end,
+                              const std::function<void(size_t)> &body);
+
+protected:
+    /* run one queued task on the calling thread, if the executor has any; used while waiting */
+    virtual bool run_pending_task() { return false; }
+};
+
+class serial_executor : public executor {
+public:
+    const char* name() const { return "serial"; }
+    size_t concurrency() const { return 1; }
+    void submit(executor_task task) { task(); }
+    void parallel_for(const size_t begin, const size_t end,
+                      const std::function<void(size_t)> &body);
+};
+
+class thread_pool_executor : public executor {
+private:
+    struct worker_queue {
+        std::mutex mutex;
+        std::deque<executor_task> tasks;
+    };
+
+    /**
+     * Owned jointly by the executor and its workers: a task may drop the
+     * last reference to the executor, whose destructor then runs on that
+     * worker, which cannot join itself and keeps using the state instead.
+     */
+    struct pool_state {
+        std::vector<std::unique_ptr<worker_queue> > queues;
+        std::mutex sleep_mutex;
+        std::condition_variable wake;
+        std::atomic<size_t> queued;
+        std::atomic<size_t> next_queue;
+        bool stopping;
+
+        bool pop_task(const size_t own_queue, executor_task &task);
+    };
+
+    std::shared_ptr<pool_state> state;
+    std::vector<std::thread> workers;
+
+    static void worker_loop(const std::shared_ptr<pool_state> &state, const size_t index);
+protected:
+    bool run_pending_task();
+public:
+    /* 0 threads: std::thread::hardware_concurrency() */
+    explicit thread_pool_executor(const size_t num_threads = 0);
+    /* runs the tasks still queued, then joins the workers */
+    ~thread_pool_executor();
+
+    const char* name() const { return "thread_pool"; }
+    size_t concurrency() const { return workers.size(); }
+    void submit(executor_task task);
+};
+
+#ifdef MULTICORE
+class openmp_executor : public executor {
+private:
+    std::mutex pool_mutex;
+    std::unique_ptr<thread_pool_executor> pool;
+
+    thread_pool_executor& task_pool();
+public:
+    const char* name() const { return "openmp"; }
+    size_t concurrency() const;
+    /* runs the task on a pool of concurrency() threads, started on the first call */
+    void submit(executor_task task);
+    void parallel_for(const size_t begin, const size_t end,
+                      const std::function<void(size_t)> &body);
+};
+#endif
+
+/* Adapts an application's thread pool, given as a function that schedules a task on it. */
+class function_executor : public executor {
+private:
+    std::function<void(executor_task)> submit_function;
+    size_t num_threads;
+public:
+    function_executor(const std::function<void(executor_task)> &submit_function, const size_t num_threads) :
+        submit_function(submit_function), num_threads(num_threads) {}
+
+    const char* name() const { return "external"; }
+    size_t concurrency() const { return num_threads; }
+    void submit(executor_task task) { submit_function(std::move(task)); }
+};
+
+/* The executor used by the library; never null. */
+std::shared_ptr<executor> get_executor();
+/* Replace the executor; a null pointer restores the default. */
+void set_executor(const std::shared_ptr<executor> &exec);
+
+/* Whether the calling thread is executing the body of a parallel_for. */
+bool in_parallel_region();
+
+inline void parallel_for(const size_t begin, const size_t end, const std::function<void(size_t)> &body)
+{
+    get_executor()->parallel_for(begin, end, body);
+}
+
+} // libff
+
+#endif // EXECUTION_HPP_
@@ -0,0 +1,242 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of tagged accounting of the library's large allocations.
+
+ See memory_accounting.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+#include <libff/common/memory_accounting.hpp>
+#include <libff/common/profiling.hpp>
+
+#ifdef __linux__
+#include <fstream>
+#include <string>
+#endif
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+namespace libff {
+
+struct mem_counter {
+    std::atomic<size_t> current;
+    std::atomic<size_t> peak;
+
+    mem_counter() : current(0), peak(0) {}
+
+    size_t add(const size_t bytes)
+    {
+        const size_t now = current.fetch_add(bytes) + bytes;
+        size_t old_peak = peak.load();
+        while (now > old_peak && !peak.compare_exchange_weak(old_peak, now))
+        {
+        }
+        return now;
+    }
+
+    size_t sub(const size_t bytes)
+    {
+        return current.fetch_sub(bytes) - bytes;
+    }
+
+    mem_usage usage() const
+    {
+        mem_usage result;
+        result.current = current.load();
+        result.peak = peak.load();
+        return result;
+    }
+};
+
+static mem_counter tag_counters[num_mem_tags];
+static mem_counter total_counter;
+static std::atomic<size_t> mem_budget(0);
+
+static std::mutex hook_mutex;
+static std::atomic<bool> hook_set(false);
+static mem_report_hook report_hook;
+
+static void report(const mem_tag tag, const long long delta)
+{
+    if (!hook_set.load())
+    {
+        return;
+    }
+
+    mem_report_hook hook;
+    {
+        std::lock_guard<std::mutex> lock(hook_mutex);
+        hook = report_hook;
+    }
+    if (hook)
+    {
+        hook(tag, delta, tag_counters[tag].usage());
+    }
+}
+
+const char* mem_tag_name(const mem_tag tag)
+{
+    switch (tag)
+    {
+    case mem_tag_window_table: return "window_table";
+    case mem_tag_multiexp_buckets: return "multiexp_buckets";
+    case mem_tag_multiexp_copies: return "multiexp_copies";
+    case mem_tag_pairing_precomp: return "pairing_precomp";
+    default: return "unknown";
+    }
+}
+
+void mem_allocated(const mem_tag tag, const size_t bytes)
+{
+    tag_counters[tag].add(bytes);
+    total_counter.add(bytes);
+    report(tag, (long long) bytes);
+}
+
+void mem_released(const mem_tag tag, const size_t bytes)
+{
+    tag_counters[tag].sub(bytes);
+    total_counter.sub(bytes);
+    report(tag, -(long long) bytes);
+}
+
+mem_usage get_mem_usage(const mem_tag tag)
+{
+    return tag_counters[tag].usage();
+}
+
+mem_usage get_total_mem_usage()
+{
+    return total_counter.usage();
+}
+
+void reset_mem_peaks()
+{
+    for (size_t i = 0; i < num_mem_tags; ++i)
+    {
+        tag_counters[i].peak.store(tag_counters[i].current.load());
+    }
+    total_counter.peak.store(total_counter.current.load());
+}
+
+void set_mem_report_hook(const mem_report_hook &hook)
+{
+    std::lock_guard<std::mutex> lock(hook_mutex);
+    report_hook = hook;
+    hook_set.store((bool) hook);
+}
+
+void set_mem_budget(const size_t bytes)
+{
+    mem_budget.store(bytes);
+}
+
+size_t get_mem_budget()
+{
+    return mem_budget.load();
+}
+
+bool mem_budget_allows(const size_t bytes)
+{
+    const size_t budget = mem_budget.load();
+    if (budget == 0)
+    {
+        return true;
+    }
+    const size_t current = total_counter.current.load();
+    return (current <= budget && bytes <= budget - current);
+}
+
+void print_mem_usage()
+{
+    const size_t MiB = 1ul << 20;
+    for (size_t i = 0; i < num_mem_tags; ++i)
+    {
+        const mem_usage usage = tag_counters[i].usage();
+        if (usage.peak == 0)
+        {
+            continue;
+        }
+        print_indent();
+        printf("* Memory (%s) in mebibytes: current %.2f, peak %.2f\n",
+               mem_tag_name((mem_tag) i), (double) usage.current / MiB, (double) usage.peak / MiB);
+    }
+    const mem_usage total = total_counter.usage();
+    print_indent();
+    printf("* Memory (accounted total) in mebibytes: current %.2f, peak %.2f", (double) total.current / MiB, (double) total.peak / MiB);
+    const size_t budget = mem_budget.load();
+    if (budget != 0)
+    {
+        printf(", budget %.2f", (double) budget / MiB);
+    }
+    printf("\n");
+}
+
+process_mem_info get_process_mem_info()
+{
+    process_mem_info info;
+    memset(&info, 0, sizeof(info));
+
+#ifdef __linux__
+    std::ifstream status("/proc/self/status");
+    std::string key;
+    while (status >> key)
+    {
+        size_t value_kib;
+        if (!(status >> value_kib))
+        {
+            status.clear();
+            status.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            continue;
+        }
+        status.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+
+        if (key == "VmSize:")
+        {
+            info.vsize = value_kib << 10;
+        }
+        else if (key == "VmPeak:")
+        {
+            info.peak_vsize = value_kib << 10;
+        }
+        else if (key == "VmRSS:")
+        {
+            info.rss = value_kib << 10;
+        }
+        else if (key == "VmHWM:")
+        {
+            info.peak_rss = value_kib << 10;
+        }
+    }
+#endif
+
+#ifndef _WIN32
+    if (info.peak_rss == 0)
+    {
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) == 0)
+        {
+#ifdef __APPLE__
+            info.peak_rss = usage.ru_maxrss; // bytes
+#else
+            info.peak_rss = ((size_t) usage.ru_maxrss) << 10; // kibibytes
+#endif
+        }
+    }
+#endif
+
+    return info;
+}
+
+} // libff
@@ -0,0 +1,152 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of tagged accounting of the library's large allocations.
+
+ The big memory consumers of libff -- fixed-base window tables, multiexp
+ buckets, temporary copies made by the multiexp front-ends, and G2
+ precomputations for pairings -- report their allocations under a mem_tag.
+ For every tag (and in total) the current and the peak number of bytes are
+ kept; a hook can forward every change to an external metrics system.
+
+ Allocations are accounted with a mem_scope where they are made. Buffers of a
+ single function are accounted for their lifetime. Window tables are plain
+ std::vectors handed to the caller, so they are accounted while they are
+ built: they show up in the peaks and in the hook, but no longer in the
+ current usage once returned. G2 precomputations carry a mem_charge for the
+ capacity of their coefficients, so they stay in the current usage for as
+ long as they (and their copies) exist.
+
+ A memory budget (set_mem_budget) bounds what operations that can trade memory
+ for speed will use: get_exp_window_size and the bucket methods of multi_exp
+ choose smaller windows when the tables for the preferred window would not
+ fit in what is left of the budget. The budget is advisory; allocations are
+ never refused.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef MEMORY_ACCOUNTING_HPP_
+#define MEMORY_ACCOUNTING_HPP_
+
+#include <cstddef>
+#include <functional>
+
+namespace libff {
+
+enum mem_tag {
+    mem_tag_window_table = 0,
+    mem_tag_multiexp_buckets,
+    mem_tag_multiexp_copies,
+    mem_tag_pairing_precomp,
+    num_mem_tags
+};
+
+const char* mem_tag_name(const mem_tag tag);
+
+struct mem_usage {
+    size_t current;
+    size_t peak;
+};
+
+void mem_allocated(const mem_tag tag, const size_t bytes);
+void mem_released(const mem_tag tag, const size_t bytes);
+
+mem_usage get_mem_usage(const mem_tag tag);
+mem_usage get_total_mem_usage();
+/* set the peaks to the current usage */
+void reset_mem_peaks();
+
+/**
+ * Called after every accounted allocation (delta > 0) and release (delta < 0),
+ * from the thread that performed it, with the new usage of the tag. Pass an
+ * empty function to remove the hook.
+ */
+typedef std::function<void(const mem_tag tag, const long long delta, const mem_usage &usage)> mem_report_hook;
+void set_mem_report_hook(const mem_report_hook &hook);
+
+/* 0 means no budget */
+void set_mem_budget(const size_t bytes);
+size_t get_mem_budget();
+/* whether bytes more can be allocated without exceeding the budget */
+bool mem_budget_allows(const size_t bytes);
+
+void print_mem_usage();
+
+/**
+ * Memory of the whole process, read from /proc/self/status on Linux and
+ * getrusage elsewhere (where only peak_rss is known). Does not need procps.
+ */
+struct process_mem_info {
+    size_t vsize;
+    size_t peak_vsize;
+    size_t rss;
+    size_t peak_rss;
+};
+
+process_mem_info get_process_mem_info();
+
+/* Accounts bytes under tag for the lifetime of the object. */
+class mem_scope {
+private:
+    mem_tag tag;
+    size_t bytes;
+public:
+    mem_scope(const mem_tag tag, const size_t bytes) : tag(tag), bytes(bytes) { mem_allocated(tag, bytes); }
+    ~mem_scope() { mem_released(tag, bytes); }
+    mem_scope(const mem_scope&) = delete;
+    mem_scope& operator=(const mem_scope&) = delete;
+};
+
+/**
+ * Accounts bytes under tag for the lifetime of the object that holds it as a
+ * member. A copy accounts the bytes again; set changes the amount, e.g. once
+ * the object has allocated what it accounts for.
+ */
+template<mem_tag tag>
+class mem_charge {
+private:
+    size_t bytes;
+public:
+    mem_charge() : bytes(0) {}
+    mem_charge(const mem_charge &other) : bytes(0) { set(other.bytes); }
+    mem_charge(mem_charge &&other) : bytes(other.bytes) { other.bytes = 0; }
+    ~mem_charge() { set(0); }
+
+    mem_charge& operator=(const mem_charge &other)
+    {
+        set(other.bytes);
+        return *this;
+    }
+    mem_charge& operator=(mem_charge &&other)
+    {
+        if (this != &other)
+        {
+            set(0);
+            bytes = other.bytes;
+            other.bytes = 0;
+        }
+        return *this;
+    }
+
+    void set(const size_t new_bytes)
+    {
+        if (new_bytes > bytes)
+        {
+            mem_allocated(tag, new_bytes - bytes);
+        }
+        else if (new_bytes < bytes)
+        {
+            mem_released(tag, bytes - new_bytes);
+        }
+        bytes = new_bytes;
+    }
+    size_t get() const { return bytes; }
+};
+
+} // libff
+
+#endif // MEMORY_ACCOUNTING_HPP_
@@ -0,0 +1,251 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of NUMA topology, memory placement and thread pinning.
+
+ See numa.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include <libff/common/execution.hpp>
+#include <libff/common/numa.hpp>
+
+#ifdef __linux__
+#include <fstream>
+#include <string>
+
+#include <dirent.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace libff {
+
+#ifdef __linux__
+/* from linux/mempolicy.h */
+static const int mpol_bind = 2;
+static const unsigned mpol_mf_move = 1 << 1;
+
+/* parses a list such as "0-3,8-11" */
+static std::vector<size_t> parse_cpu_list(const std::string &list)
+{
+    std::vector<size_t> cpus;
+    size_t pos = 0;
+    while (pos < list.size())
+    {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos)
+        {
+            end = list.size();
+        }
+        const std::string range = list.substr(pos, end - pos);
+        const size_t dash = range.find('-');
+        if (!range.empty())
+        {
+            const size_t first = std::strtoul(range.c_str(), nullptr, 10);
+            const size_t last = (dash == std::string::npos ? first : std::strtoul(range.c_str() + dash + 1, nullptr, 10));
+            for (size_t cpu = first; cpu <= last; ++cpu)
+            {
+                cpus.emplace_back(cpu);
+            }
+        }
+        pos = end + 1;
+    }
+    return cpus;
+}
+
+static std::vector<numa_node> detect_numa_nodes()
+{
+    std::vector<numa_node> nodes;
+    DIR *dir = opendir("/sys/devices/system/node");
+    if (dir != nullptr)
+    {
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != nullptr)
+        {
+            if (std::strncmp(entry->d_name, "node", 4) != 0 ||
+                entry->d_name[4] < '0' || entry->d_name[4] > '9')
+            {
+                continue;
+            }
+
+            std::ifstream file(std::string("/sys/devices/system/node/") + entry->d_name + "/cpulist");
+            std::string list;
+            std::getline(file, list);
+
+            numa_node node;
+            node.id = std::strtoul(entry->d_name + 4, nullptr, 10);
+            node.cpus = parse_cpu_list(list);
+            /* memory-only nodes have no CPUs to run a worker group on */
+            if (!node.cpus.empty())
+            {
+                nodes.emplace_back(node);
+            }
+        }
+        closedir(dir);
+    }
+
+    std::sort(nodes.begin(), nodes.end(),
+              [](const numa_node &a, const numa_node &b) { return a.id < b.id; });
+    return nodes;
+}
+#endif
+
+static std::vector<numa_node> single_node()
+{
+    numa_node node;
+    node.id = 0;
+    const size_t n = std::max<unsigned>(1, std::thread::hardware_concurrency());
+    for (size_t cpu = 0; cpu < n; ++cpu)
+    {
+        node.cpus.emplace_back(cpu);
+    }
+    return std::vector<numa_node>(1, node);
+}
+
+static std::mutex numa_mutex;
+static std::vector<numa_node> numa_nodes;
+
+std::vector<numa_node> get_numa_nodes()
+{
+    std::lock_guard<std::mutex> lock(numa_mutex);
+    if (numa_nodes.empty())
+    {
+#ifdef __linux__
+        numa_nodes = detect_numa_nodes();
+#endif
+        if (numa_nodes.empty())
+        {
+            numa_nodes = single_node();
+        }
+    }
+    return numa_nodes;
+}
+
+void set_numa_nodes(const std::vector<numa_node> &nodes)
+{
+    std::lock_guard<std::mutex> lock(numa_mutex);
+    numa_nodes = nodes;
+}
+
+bool numa_bind_memory(const void *addr, const size_t bytes, const numa_node &node)
+{
+#ifdef __linux__
+    const size_t page = sysconf(_SC_PAGESIZE);
+    const size_t begin = ((size_t) addr + page - 1) / page * page;
+    const size_t end = ((size_t) addr + bytes) / page * page;
+    if (end <= begin)
+    {
+        /* no whole page to bind; nothing to do */
+        return true;
+    }
+
+    const size_t bits_per_word = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask(node.id / bits_per_word + 1, 0);
+    mask[node.id / bits_per_word] |= 1ul << (node.id % bits_per_word);
+
+    /* the kernel expects the number of bits plus one */
+    return syscall(SYS_mbind, (void*) begin, end - begin, mpol_bind,
+                   mask.data(), mask.size() * bits_per_word + 1, mpol_mf_move) == 0;
+#else
+    (void) addr;
+    (void) bytes;
+    (void) node;
+    return false;
+#endif
+}
+
+numa_thread_binding::numa_thread_binding(const numa_node &node) : bound(false)
+{
+#ifdef __linux__
+    cpu_set_t saved;
+    if (sched_getaffinity(0, sizeof(saved), &saved) != 0)
+    {
+        return;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const size_t cpu : node.cpus)
+    {
+        if (cpu < CPU_SETSIZE)
+        {
+            CPU_SET(cpu, &set);
+        }
+    }
+    if (sched_setaffinity(0, sizeof(set), &set) == 0)
+    {
+        saved_mask.assign((unsigned char*) &saved, (unsigned char*) &saved + sizeof(saved));
+        bound = true;
+    }
+#else
+    (void) node;
+#endif
+}
+
+numa_thread_binding::~numa_thread_binding()
+{
+#ifdef __linux__
+    if (bound)
+    {
+        cpu_set_t saved;
+        std::memcpy(&saved, saved_mask.data(), sizeof(saved));
+        sched_setaffinity(0, sizeof(saved), &saved);
+    }
+#endif
+}
+
+std::vector<size_t> numa_partition(const size_t n, const std::vector<numa_node> &nodes)
+{
+    size_t total_cpus = 0;
+    for (const numa_node &node : nodes)
+    {
+        total_cpus += std::max<size_t>(1, node.cpus.size());
+    }
+
+    std::vector<size_t> bounds(1, 0);
+    size_t cpus_so_far = 0;
+    for (const numa_node &node : nodes)
+    {
+        cpus_so_far += std::max<size_t>(1, node.cpus.size());
+        bounds.emplace_back(n * cpus_so_far / total_cpus);
+    }
+    return bounds;
+}
+
+void numa_run_on_nodes(const std::vector<numa_node> &nodes,
+                       const std::function<void(size_t node_index, size_t worker, size_t num_workers)> &body)
+{
+    /* (node, worker) slots, node by node, so that a thread taking consecutive slots stays on one node */
+    std::vector<std::pair<size_t, size_t> > slots;
+    std::vector<size_t> num_workers(nodes.size());
+    for (size_t k = 0; k < nodes.size(); ++k)
+    {
+        num_workers[k] = std::max<size_t>(1, nodes[k].cpus.size());
+        for (size_t w = 0; w < num_workers[k]; ++w)
+        {
+            slots.emplace_back(k, w);
+        }
+    }
+
+    get_executor()->parallel_for(0, slots.size(), [&](const size_t i) {
+        const size_t k = slots[i].first;
+        /* only for the slot: the thread may be the application's, or run other work next */
+        const numa_thread_binding binding(nodes[k]);
+        body(k, slots[i].second, num_workers[k]);
+    });
+}
+
+} // libff
@@ -0,0 +1,85 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of NUMA topology, memory placement and thread pinning, used by
+ multi_exp_numa (see multiexp.hpp).
+
+ The topology is read from /sys/devices/system/node on Linux; elsewhere, or
+ if it cannot be read, the machine is treated as a single node holding all
+ CPUs, in which case the NUMA-aware code paths fall back to the ordinary
+ ones. The detected topology can be replaced with set_numa_nodes, e.g. to
+ restrict the library to a subset of the nodes.
+
+ Memory is placed with the mbind system call (pages that are already
+ resident are migrated), so libnuma is not needed; threads are pinned with
+ sched_setaffinity. Both are best effort: if the kernel refuses (e.g. in a
+ container without CAP_SYS_NICE for migration), the work still runs, only
+ without the locality.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef NUMA_HPP_
+#define NUMA_HPP_
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace libff {
+
+struct numa_node {
+    /* the kernel's node number, used for memory placement */
+    size_t id;
+    std::vector<size_t> cpus;
+};
+
+std::vector<numa_node> get_numa_nodes();
+/* An empty vector restores the detected topology. */
+void set_numa_nodes(const std::vector<numa_node> &nodes);
+
+/**
+ * Bind the whole pages within [addr, addr + bytes) to the node, moving pages
+ * that are already resident. Returns false if the kernel did not allow it.
+ */
+bool numa_bind_memory(const void *addr, const size_t bytes, const numa_node &node);
+
+/* Pins the calling thread to the CPUs of a node for the lifetime of the object. */
+class numa_thread_binding {
+private:
+    std::vector<unsigned char> saved_mask;
+    bool bound;
+public:
+    explicit numa_thread_binding(const numa_node &node);
+    ~numa_thread_binding();
+    numa_thread_binding(const numa_thread_binding&) = delete;
+    numa_thread_binding& operator=(const numa_thread_binding&) = delete;
+
+    bool is_bound() const { return bound; }
+};
+
+/**
+ * Split n items into one contiguous slice per node, in proportion to the
+ * number of CPUs of the node. Returns the nodes.size() + 1 slice boundaries.
+ */
+std::vector<size_t> numa_partition(const size_t n, const std::vector<numa_node> &nodes);
+
+/**
+ * Run body(node_index, worker, num_workers) for every node and every worker
+ * of the node, with as many workers as the node has CPUs, and return when
+ * all have returned. The calls are a parallel_for on the executor (see
+ * execution.hpp), and the thread running a call is pinned to the node for
+ * that call only (see numa_thread_binding), so executor and application
+ * threads keep their affinity afterwards. With serial_executor, all calls
+ * run on the calling thread. The first exception thrown by a body is
+ * rethrown.
+ */
+void numa_run_on_nodes(const std::vector<numa_node> &nodes,
+                       const std::function<void(size_t node_index, size_t worker, size_t num_workers)> &body);
+
+} // libff
+
+#endif // NUMA_HPP_
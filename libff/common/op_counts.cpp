@@ -0,0 +1,220 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of per-thread, aggregatable operation counters.
+
+ See op_counts.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <algorithm>
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+
+#include <libff/common/op_counts.hpp>
+
+namespace libff {
+
+struct op_count_registry {
+    std::mutex mutex;
+    std::vector<std::string> names;
+    std::vector<bool> renamed;
+    std::set<op_count_block*> live_blocks;
+    /* counts accumulated by threads that have exited */
+    std::vector<long long> retired;
+
+    op_count_registry() : retired(max_op_counters, 0) {}
+};
+
+static op_count_registry& registry()
+{
+    static op_count_registry r;
+    return r;
+}
+
+/* Owns the counts of one thread and folds them into the registry when the thread exits. */
+struct op_count_thread_guard {
+    op_count_block block;
+
+    op_count_thread_guard()
+    {
+        op_count_registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.live_blocks.insert(&block);
+    }
+
+    ~op_count_thread_guard()
+    {
+        op_count_registry &r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (size_t i = 0; i < max_op_counters; ++i)
+        {
+            r.retired[i] += block.counts[i].load(std::memory_order_relaxed);
+        }
+        r.live_blocks.erase(&block);
+        this_thread_op_counts = nullptr;
+    }
+};
+
+thread_local op_count_block *this_thread_op_counts = nullptr;
+
+op_count_block::op_count_block()
+{
+    for (size_t i = 0; i < max_op_counters; ++i)
+    {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+op_count_block* register_op_count_thread()
+{
+    static thread_local op_count_thread_guard guard;
+    this_thread_op_counts = &guard.block;
+    return this_thread_op_counts;
+}
+
+op_counter::op_counter(const std::string &name)
+{
+    op_count_registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    if (r.names.size() == max_op_counters)
+    {
+        throw std::runtime_error("too many operation counters");
+    }
+    idx = r.names.size();
+    r.names.emplace_back(name);
+    r.renamed.emplace_back(false);
+}
+
+std::string op_counter::name() const
+{
+    op_count_registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    return r.names[idx];
+}
+
+void op_counter::add_name(const std::string &name)
+{
+    op_count_registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    if (!r.renamed[idx])
+    {
+        r.names[idx] = name;
+        r.renamed[idx] = true;
+    }
+    else if (r.names[idx] != name && r.names[idx].find(name + "/") != 0 &&
+             r.names[idx].find("/" + name) == std::string::npos)
+    {
+        r.names[idx] += "/" + name;
+    }
+}
+
+long long op_counter::value() const
+{
+    op_count_registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    long long result = r.retired[idx];
+    for (const op_count_block *block : r.live_blocks)
+    {
+        result += block->counts[idx].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+op_count_snapshot op_count_snapshot::all_threads()
+{
+    op_count_registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    op_count_snapshot result;
+    result.counts.assign(r.retired.begin(), r.retired.begin() + r.names.size());
+    for (const op_count_block *block : r.live_blocks)
+    {
+        for (size_t i = 0; i < result.counts.size(); ++i)
+        {
+            result.counts[i] += block->counts[i].load(std::memory_order_relaxed);
+        }
+    }
+    return result;
+}
+
+op_count_snapshot op_count_snapshot::this_thread()
+{
+    op_count_registry &r = registry();
+    size_t num_counters;
+    {
+        std::lock_guard<std::mutex> lock(r.mutex);
+        num_counters = r.names.size();
+    }
+
+    op_count_snapshot result;
+    result.counts.resize(num_counters, 0);
+    const op_count_block *block = this_thread_op_counts;
+    if (block != nullptr)
+    {
+        for (size_t i = 0; i < num_counters; ++i)
+        {
+            result.counts[i] = block->counts[i].load(std::memory_order_relaxed);
+        }
+    }
+    return result;
+}
+
+long long op_count_snapshot::operator[](const op_counter &counter) const
+{
+    return (counter.index() < counts.size() ? counts[counter.index()] : 0);
+}
+
+op_count_snapshot op_count_snapshot::operator-(const op_count_snapshot &other) const
+{
+    /* counters registered after other was taken count from zero */
+    op_count_snapshot result(*this);
+    result.counts.resize(std::max(counts.size(), other.counts.size()), 0);
+    for (size_t i = 0; i < other.counts.size(); ++i)
+    {
+        result.counts[i] -= other.counts[i];
+    }
+    return result;
+}
+
+op_count_snapshot& op_count_snapshot::operator+=(const op_count_snapshot &other)
+{
+    counts.resize(std::max(counts.size(), other.counts.size()), 0);
+    for (size_t i = 0; i < other.counts.size(); ++i)
+    {
+        counts[i] += other.counts[i];
+    }
+    return *this;
+}
+
+std::map<std::string, long long> op_count_snapshot::nonzero_counts() const
+{
+    op_count_registry &r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+
+    std::map<std::string, long long> result;
+    for (size_t i = 0; i < counts.size(); ++i)
+    {
+        if (counts[i] != 0)
+        {
+            result[r.names[i]] += counts[i];
+        }
+    }
+    return result;
+}
+
+void op_count_snapshot::print() const
+{
+    for (auto &kv : nonzero_counts())
+    {
+        printf("  %-35s: %lld\n", kv.first.c_str(), kv.second);
+    }
+}
+
+} // libff
@@ -0,0 +1,116 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of per-thread, aggregatable operation counters.
+
+ Field and group classes keep one op_counter per counted operation (see
+ Fp_model::add_cnt or bls12_381_G1::dbl_cnt); they are only incremented when
+ compiled with PROFILE_OP_COUNTS. Every thread increments its own copy of each
+ counter, so counting from parallel regions neither races nor bounces cache
+ lines between cores. Reading a counter sums the copies of all threads,
+ including those of threads that have already exited.
+
+ op_count_snapshot captures all counters at once; the difference of two
+ snapshots (or op_count_scope) gives the operations performed in between, e.g.
+ by a single multi-exponentiation.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef OP_COUNTS_HPP_
+#define OP_COUNTS_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace libff {
+
+const size_t max_op_counters = 1024;
+
+struct op_count_block {
+    std::atomic<long long> counts[max_op_counters];
+
+    op_count_block();
+};
+
+extern thread_local op_count_block *this_thread_op_counts;
+op_count_block* register_op_count_thread();
+
+class op_counter {
+private:
+    size_t idx;
+public:
+    explicit op_counter(const std::string &name);
+    op_counter(const op_counter&) = delete;
+    op_counter& operator=(const op_counter&) = delete;
+
+    size_t index() const { return idx; }
+    std::string name() const;
+    /**
+     * Give the counter a (further) name. The first call replaces the name
+     * passed to the constructor; later calls with a different name append it,
+     * e.g. when two curves share the same field.
+     */
+    void add_name(const std::string &name);
+
+    void add(const long long delta)
+    {
+        op_count_block *block = this_thread_op_counts;
+        if (block == nullptr)
+        {
+            block = register_op_count_thread();
+        }
+        /* only the owning thread writes, so no read-modify-write is needed */
+        std::atomic<long long> &c = block->counts[idx];
+        c.store(c.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    }
+    op_counter& operator++() { add(1); return *this; }
+    op_counter& operator--() { add(-1); return *this; }
+    void operator++(int) { add(1); }
+    void operator--(int) { add(-1); }
+
+    /* sum over all threads */
+    long long value() const;
+};
+
+class op_count_snapshot {
+public:
+    std::vector<long long> counts; // indexed by op_counter::index()
+
+    /* counts of all threads, and of the calling thread only */
+    static op_count_snapshot all_threads();
+    static op_count_snapshot this_thread();
+
+    long long operator[](const op_counter &counter) const;
+    op_count_snapshot operator-(const op_count_snapshot &other) const;
+    op_count_snapshot& operator+=(const op_count_snapshot &other);
+
+    /* non-zero counts keyed by counter name */
+    std::map<std::string, long long> nonzero_counts() const;
+    void print() const;
+};
+
+/**
+ * Operations performed (by all threads) since construction; e.g.
+ *
+ *   op_count_scope scope;
+ *   multi_exp<...>(...);
+ *   scope.elapsed().print();
+ */
+class op_count_scope {
+private:
+    op_count_snapshot start;
+public:
+    op_count_scope() : start(op_count_snapshot::all_threads()) {}
+    op_count_snapshot elapsed() const { return op_count_snapshot::all_threads() - start; }
+};
+
+} // libff
+
+#endif // OP_COUNTS_HPP_
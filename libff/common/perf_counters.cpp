@@ -0,0 +1,301 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of hardware performance counters for profiling blocks.
+
+ See perf_counters.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <cstdio>
+
+#include <libff/common/perf_counters.hpp>
+#include <libff/common/utils.hpp>
+
+#if defined(PROFILE_PERF_EVENTS) && defined(__linux__)
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace libff {
+
+const char* perf_event_name(const perf_event_kind kind)
+{
+    switch (kind)
+    {
+    case perf_cycles: return "cycles";
+    case perf_instructions: return "instructions";
+    case perf_l1d_misses: return "L1d-misses";
+    case perf_llc_misses: return "LLC-misses";
+    case perf_dtlb_misses: return "dTLB-misses";
+    case perf_branch_misses: return "branch-misses";
+    default: return "unknown";
+    }
+}
+
+perf_counts perf_counts::operator-(const perf_counts &other) const
+{
+    perf_counts result;
+    for (size_t i = 0; i < num_perf_events; ++i)
+    {
+        result.values[i] = values[i] - other.values[i];
+    }
+    return result;
+}
+
+perf_counts& perf_counts::operator+=(const perf_counts &other)
+{
+    for (size_t i = 0; i < num_perf_events; ++i)
+    {
+        values[i] += other.values[i];
+    }
+    return *this;
+}
+
+bool perf_counts::is_zero() const
+{
+    for (size_t i = 0; i < num_perf_events; ++i)
+    {
+        if (values[i] != 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void perf_counts::print() const
+{
+    for (size_t i = 0; i < num_perf_events; ++i)
+    {
+        printf("%s%s=%lld", (i == 0 ? "" : ", "), perf_event_name(perf_event_kind(i)), values[i]);
+        if (i == perf_instructions && values[perf_cycles] != 0)
+        {
+            printf(" (IPC %0.2f)", 1. * values[perf_instructions] / values[perf_cycles]);
+        }
+    }
+}
+
+perf_snapshot perf_snapshot::operator-(const perf_snapshot &other) const
+{
+    perf_snapshot result;
+    result.total = total - other.total;
+    for (auto &kv : per_thread)
+    {
+        auto it = other.per_thread.find(kv.first);
+        result.per_thread[kv.first] = (it == other.per_thread.end() ? kv.second : kv.second - it->second);
+    }
+    return result;
+}
+
+perf_snapshot& perf_snapshot::operator+=(const perf_snapshot &other)
+{
+    total += other.total;
+    for (auto &kv : other.per_thread)
+    {
+        per_thread[kv.first] += kv.second;
+    }
+    return *this;
+}
+
+#if defined(PROFILE_PERF_EVENTS) && defined(__linux__)
+
+struct perf_event_spec {
+    uint32_t type;
+    uint64_t config;
+};
+
+static uint64_t hw_cache_miss(const uint64_t cache)
+{
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+static const perf_event_spec perf_event_specs[num_perf_events] = {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HW_CACHE, hw_cache_miss(PERF_COUNT_HW_CACHE_L1D) },
+    { PERF_TYPE_HW_CACHE, hw_cache_miss(PERF_COUNT_HW_CACHE_LL) },
+    { PERF_TYPE_HW_CACHE, hw_cache_miss(PERF_COUNT_HW_CACHE_DTLB) },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+struct thread_perf_fds {
+    int fds[num_perf_events];
+};
+
+static std::mutex perf_mutex;
+static std::map<long, thread_perf_fds> perf_threads;
+/* final counts of threads that have exited, see perf_snapshot::per_thread */
+static perf_counts exited_perf_counts;
+static bool perf_initialized = false;
+static bool perf_available = false;
+
+static int open_perf_event(const perf_event_spec &spec, const long tid)
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    /* to scale the counts if the kernel has to multiplex events */
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return syscall(__NR_perf_event_open, &attr, tid, -1, -1, 0);
+}
+
+static long long read_perf_event(const int fd)
+{
+    uint64_t buf[3]; // value, time enabled, time running
+    if (fd < 0 || read(fd, buf, sizeof(buf)) != (ssize_t) sizeof(buf) || buf[2] == 0)
+    {
+        return 0;
+    }
+    if (buf[2] < buf[1])
+    {
+        return (long long) ((long double) buf[0] * buf[1] / buf[2]);
+    }
+    return buf[0];
+}
+
+static perf_counts read_thread_perf_counts(const thread_perf_fds &t)
+{
+    perf_counts result;
+    for (size_t i = 0; i < num_perf_events; ++i)
+    {
+        result.values[i] = read_perf_event(t.fds[i]);
+    }
+    return result;
+}
+
+static void close_thread_perf_fds(const thread_perf_fds &t)
+{
+    for (size_t i = 0; i < num_perf_events; ++i)
+    {
+        if (t.fds[i] >= 0)
+        {
+            close(t.fds[i]);
+        }
+    }
+}
+
+/* Opens the counters of one thread and folds them into exited_perf_counts when the thread exits. */
+struct perf_thread_guard {
+    long tid;
+    bool registered;
+
+    perf_thread_guard() : tid(syscall(SYS_gettid)), registered(false)
+    {
+        thread_perf_fds t;
+        bool any_open = false;
+        int first_errno = 0;
+        for (size_t i = 0; i < num_perf_events; ++i)
+        {
+            /* pid 0 and cpu -1: the calling thread, on any CPU */
+            t.fds[i] = open_perf_event(perf_event_specs[i], 0);
+            if (t.fds[i] >= 0)
+            {
+                any_open = true;
+            }
+            else if (first_errno == 0)
+            {
+                first_errno = errno;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(perf_mutex);
+        if (any_open)
+        {
+            perf_threads[tid] = t;
+            perf_available = true;
+            registered = true;
+        }
+        if (!perf_initialized)
+        {
+            perf_initialized = true;
+            if (!perf_available)
+            {
+                printf("* Hardware performance counters not available (perf_event_open: %s)\n", strerror(first_errno));
+            }
+        }
+    }
+
+    ~perf_thread_guard()
+    {
+        if (!registered)
+        {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(perf_mutex);
+        auto it = perf_threads.find(tid);
+        exited_perf_counts += read_thread_perf_counts(it->second);
+        close_thread_perf_fds(it->second);
+        perf_threads.erase(it);
+    }
+};
+
+void register_perf_thread()
+{
+    static thread_local perf_thread_guard guard;
+    UNUSED(guard);
+}
+
+bool perf_counters_available()
+{
+    register_perf_thread();
+    std::lock_guard<std::mutex> lock(perf_mutex);
+    return perf_available;
+}
+
+perf_snapshot read_perf_counters()
+{
+    register_perf_thread();
+    std::lock_guard<std::mutex> lock(perf_mutex);
+    perf_snapshot result;
+    if (!perf_available)
+    {
+        return result;
+    }
+
+    result.per_thread[0] = exited_perf_counts;
+    result.total = exited_perf_counts;
+    for (auto &kv : perf_threads)
+    {
+        const perf_counts counts = read_thread_perf_counts(kv.second);
+        result.per_thread[kv.first] = counts;
+        result.total += counts;
+    }
+    return result;
+}
+
+#else
+
+void register_perf_thread()
+{
+}
+
+bool perf_counters_available()
+{
+    return false;
+}
+
+perf_snapshot read_perf_counters()
+{
+    return perf_snapshot();
+}
+
+#endif
+
+} // libff
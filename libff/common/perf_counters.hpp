@@ -0,0 +1,80 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of hardware performance counters for profiling blocks.
+
+ When compiled with PROFILE_PERF_EVENTS on Linux, the counters below are
+ opened with perf_event_open for every thread that registers (user-space
+ events only) and enter_block/leave_block report them alongside the wall and
+ CPU times. This shows directly whether a region is compute- or memory-bound.
+
+ A thread registers with register_perf_thread, which opens its counters the
+ first time it is called on that thread and folds the final counts into the
+ exited threads when the thread exits. The threads that run parallel_for
+ iterations and the workers of thread_pool_executor (see execution.hpp)
+ register themselves, and a thread that reads the counters (e.g. in
+ enter_block) is registered by the read.
+ Counters are read per thread; the total is the sum over all registered
+ threads, including those that have exited. If the kernel or the machine does
+ not provide an event (e.g. in a VM, or with kernel.perf_event_paranoid > 2),
+ that event reads as zero; if no event can be opened at all,
+ perf_counters_available() is false and nothing is reported.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef PERF_COUNTERS_HPP_
+#define PERF_COUNTERS_HPP_
+
+#include <cstddef>
+#include <map>
+
+namespace libff {
+
+enum perf_event_kind {
+    perf_cycles = 0,
+    perf_instructions,
+    perf_l1d_misses,
+    perf_llc_misses,
+    perf_dtlb_misses,
+    perf_branch_misses,
+    num_perf_events
+};
+
+const char* perf_event_name(const perf_event_kind kind);
+
+struct perf_counts {
+    long long values[num_perf_events] = {};
+
+    long long operator[](const perf_event_kind kind) const { return values[kind]; }
+    perf_counts operator-(const perf_counts &other) const;
+    perf_counts& operator+=(const perf_counts &other);
+    bool is_zero() const;
+
+    /* e.g. "cycles=1000, instructions=2000 (IPC 2.00), ..." */
+    void print() const;
+};
+
+struct perf_snapshot {
+    perf_counts total;
+    /* by thread id; threads that have exited are summed under id 0 */
+    std::map<long, perf_counts> per_thread;
+
+    perf_snapshot operator-(const perf_snapshot &other) const;
+    perf_snapshot& operator+=(const perf_snapshot &other);
+};
+
+/* Start counting the calling thread, if it is not counted yet. Cheap after the first call. */
+void register_perf_thread();
+
+bool perf_counters_available();
+
+/* Read the counters of all registered threads. */
+perf_snapshot read_perf_counters();
+
+} // libff
+
+#endif // PERF_COUNTERS_HPP_
@@ -15,12 +15,18 @@
 #include <chrono>
 #include <cstdio>
 #include <ctime>
-#include <list>
+#include <iterator>
+#include <mutex>
 #include <stdexcept>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
-#include <libff/common/default_types/ec_pp.hpp>
+#include <libff/common/memory_accounting.hpp>
+#include <libff/common/op_counts.hpp>
+#include <libff/common/perf_counters.hpp>
 #include <libff/common/profiling.hpp>
+#include <libff/common/tracing.hpp>
 #include <libff/common/utils.hpp>
 
 #ifndef NO_PROCPS
@@ -60,36 +66,40 @@ void start_profiling()
 }
 
 std::map<std::string, size_t> invocation_counts;
-std::map<std::string, long long> enter_times;
 std::map<std::string, long long> last_times;
 std::map<std::string, long long> cumulative_times;
 //TODO: Instead of analogous maps for time and cpu_time, use a single struct-valued map
-std::map<std::string, long long> enter_cpu_times;
 std::map<std::string, long long> last_cpu_times;
-std::map<std::pair<std::string, std::string>, long long> op_counts;
-std::map<std::pair<std::string, std::string>, long long> cumulative_op_counts; // ((msg, data_point), value)
-    // TODO: Convert op_counts and cumulative_op_counts from pair to structs
 size_t indentation = 0;
 
-std::vector<std::string> block_names;
-
-std::list<std::pair<std::string, long long*> > op_data_points = {
+/* the state a block was entered with */
+struct block_entry {
+    std::string name;
+    long long time;
+    long long cpu_time;
 #ifdef PROFILE_OP_COUNTS
-    std::make_pair("Fradd", &Fr<default_ec_pp>::add_cnt),
-    std::make_pair("Frsub", &Fr<default_ec_pp>::sub_cnt),
-    std::make_pair("Frmul", &Fr<default_ec_pp>::mul_cnt),
-    std::make_pair("Frinv", &Fr<default_ec_pp>::inv_cnt),
-    std::make_pair("Fqadd", &Fq<default_ec_pp>::add_cnt),
-    std::make_pair("Fqsub", &Fq<default_ec_pp>::sub_cnt),
-    std::make_pair("Fqmul", &Fq<default_ec_pp>::mul_cnt),
-    std::make_pair("Fqinv", &Fq<default_ec_pp>::inv_cnt),
-    std::make_pair("G1add", &G1<default_ec_pp>::add_cnt),
-    std::make_pair("G1dbl", &G1<default_ec_pp>::dbl_cnt),
-    std::make_pair("G2add", &G2<default_ec_pp>::add_cnt),
-    std::make_pair("G2dbl", &G2<default_ec_pp>::dbl_cnt)
+    op_count_snapshot op_counts;
+#endif
+#ifdef PROFILE_PERF_EVENTS
+    perf_snapshot perf_counts;
 #endif
 };
 
+/*
+  blocks may be entered from several threads (e.g. by tasks of async.hpp),
+  also the same block at once; each thread nests its own, and the lock is
+  only taken for the cumulative maps and the output
+*/
+thread_local std::vector<block_entry> block_stack;
+static std::mutex block_mutex;
+
+/* operation counts of all fields and groups, see op_counts.hpp */
+std::map<std::string, op_count_snapshot> enter_op_counts;
+std::map<std::string, op_count_snapshot> cumulative_op_counts;
+
+/* hardware performance counters, see perf_counters.hpp */
+std::map<std::string, perf_snapshot> cumulative_perf_counts;
+
 bool inhibit_profiling_info = false;
 bool inhibit_profiling_counters = false;
 
@@ -126,9 +136,9 @@ void print_cumulative_op_counts(const bool only_fq)
     {
         printf("  %-45s: ", msg.first.c_str());
         bool first = true;
-        for (auto& data_point : op_data_points)
+        for (auto& data_point : cumulative_op_counts[msg.first].nonzero_counts())
         {
-            if (only_fq && data_point.first.compare(0, 2, "Fq") != 0)
+            if (only_fq && data_point.first.find("Fq") == std::string::npos)
             {
                 continue;
             }
@@ -137,9 +147,9 @@ void print_cumulative_op_counts(const bool only_fq)
             {
                 printf(", ");
             }
-            printf("%-5s = %7.0f (%3zu)",
+            printf("%s = %7.0f (%3zu)",
                    data_point.first.c_str(),
-                   1. * cumulative_op_counts[std::make_pair(msg.first, data_point.first)] / msg.second,
+                   1. * data_point.second / msg.second,
                    msg.second);
             first = false;
         }
@@ -150,30 +160,80 @@ void print_cumulative_op_counts(const bool only_fq)
 #endif
 }
 
-void print_op_profiling(const std::string &msg)
-{
 #ifdef PROFILE_OP_COUNTS
+static void print_op_counts(const op_count_snapshot &counts)
+{
     printf("\n");
     print_indent();
 
     printf("(opcounts) = (");
     bool first = true;
-    for (std::pair<std::string, long long*> p : op_data_points)
+    for (auto& p : counts.nonzero_counts())
     {
         if (!first)
         {
             printf(", ");
         }
 
-        printf("%s=%lld", p.first.c_str(), *(p.second)-op_counts[std::make_pair(msg, p.first)]);
+        printf("%s=%lld", p.first.c_str(), p.second);
         first = false;
     }
     printf(")");
+}
+#endif
+
+void print_op_profiling(const std::string &msg)
+{
+#ifdef PROFILE_OP_COUNTS
+    print_op_counts(op_count_snapshot::all_threads() - enter_op_counts[msg]);
 #else
     UNUSED(msg);
 #endif
 }
 
+void print_cumulative_perf_counts(const bool per_thread)
+{
+#ifdef PROFILE_PERF_EVENTS
+    printf("Dumping hardware performance counters (per invocation):\n");
+    for (auto& msg : invocation_counts)
+    {
+        const perf_snapshot &counts = cumulative_perf_counts[msg.first];
+        printf("  %-45s: ", msg.first.c_str());
+        perf_counts avg;
+        for (size_t i = 0; i < num_perf_events; ++i)
+        {
+            avg.values[i] = counts.total.values[i] / (long long) msg.second;
+        }
+        avg.print();
+        printf("\n");
+
+        if (!per_thread)
+        {
+            continue;
+        }
+        for (auto& thread : counts.per_thread)
+        {
+            if (thread.second.is_zero())
+            {
+                continue;
+            }
+            if (thread.first == 0)
+            {
+                printf("    %-43s: ", "exited threads");
+            }
+            else
+            {
+                printf("    thread %-36ld: ", thread.first);
+            }
+            thread.second.print();
+            printf("\n");
+        }
+    }
+#else
+    UNUSED(per_thread);
+#endif
+}
+
 static void print_times_from_last_and_start(long long     now, long long     last,
                                             long long cpu_now, long long cpu_last)
 {
@@ -234,36 +294,54 @@ void print_indent()
 
 void op_profiling_enter(const std::string &msg)
 {
-    for (std::pair<std::string, long long*> p : op_data_points)
+    enter_op_counts[msg] = op_count_snapshot::all_threads();
+}
+
+/* trace id of a block name, interned once per thread instead of under the tracer's lock on every call */
+static trace_block_id block_trace_id(const std::string &msg)
+{
+    static thread_local std::unordered_map<std::string, trace_block_id> ids;
+    auto it = ids.find(msg);
+    if (it == ids.end())
     {
-        op_counts[std::make_pair(msg, p.first)] = *(p.second);
+        it = ids.emplace(msg, trace_intern(msg)).first;
     }
+    return it->second;
 }
 
 void enter_block(const std::string &msg, const bool indent)
 {
+    if (tracing_enabled())
+    {
+        trace_enter(block_trace_id(msg));
+    }
+
     if (inhibit_profiling_counters)
     {
         return;
     }
 
-    block_names.emplace_back(msg);
-    long long t = get_nsec_time();
-    enter_times[msg] = t;
-    long long cpu_t = get_nsec_cpu_time();
-    enter_cpu_times[msg] = cpu_t;
+    block_entry entry;
+    entry.name = msg;
+    entry.time = get_nsec_time();
+    entry.cpu_time = get_nsec_cpu_time();
+#ifdef PROFILE_OP_COUNTS
+    entry.op_counts = op_count_snapshot::all_threads();
+#endif
+#ifdef PROFILE_PERF_EVENTS
+    entry.perf_counts = read_perf_counters();
+#endif
+    const long long t = entry.time;
+    const long long cpu_t = entry.cpu_time;
+    block_stack.emplace_back(std::move(entry));
 
     if (inhibit_profiling_info)
     {
         return;
     }
 
-#ifdef MULTICORE
-#pragma omp critical
-#endif
     {
-        op_profiling_enter(msg);
-
+        std::lock_guard<std::mutex> lock(block_mutex);
         print_indent();
         printf("(enter) %-35s\t", msg.c_str());
         print_times_from_last_and_start(t, t, cpu_t, cpu_t);
@@ -279,30 +357,52 @@ void enter_block(const std::string &msg, const bool indent)
 
 void leave_block(const std::string &msg, const bool indent)
 {
+    if (tracing_enabled())
+    {
+        trace_leave(block_trace_id(msg));
+    }
+
     if (inhibit_profiling_counters)
     {
         return;
     }
 
 #ifndef MULTICORE
-    assert(*(--block_names.end()) == msg);
+    assert(!block_stack.empty() && block_stack.back().name == msg);
 #endif
-    block_names.pop_back();
-
-    ++invocation_counts[msg];
-
-    long long t = get_nsec_time();
-    last_times[msg] = (t - enter_times[msg]);
-    cumulative_times[msg] += (t - enter_times[msg]);
+    /* the innermost block of this name that this thread entered */
+    auto it = block_stack.rbegin();
+    while (it != block_stack.rend() && it->name != msg)
+    {
+        ++it;
+    }
+    if (it == block_stack.rend())
+    {
+        /* entered with the counters inhibited, or on another thread: nothing to measure */
+        return;
+    }
+    const block_entry entry = std::move(*it);
+    block_stack.erase(std::next(it).base());
 
-    long long cpu_t = get_nsec_cpu_time();
-    last_cpu_times[msg] = (cpu_t - enter_cpu_times[msg]);
+    const long long t = get_nsec_time();
+    const long long cpu_t = get_nsec_cpu_time();
+#ifdef PROFILE_OP_COUNTS
+    const op_count_snapshot op_delta = op_count_snapshot::all_threads() - entry.op_counts;
+#endif
+#ifdef PROFILE_PERF_EVENTS
+    const perf_snapshot perf_delta = read_perf_counters() - entry.perf_counts;
+#endif
 
+    std::lock_guard<std::mutex> lock(block_mutex);
+    ++invocation_counts[msg];
+    last_times[msg] = (t - entry.time);
+    cumulative_times[msg] += (t - entry.time);
+    last_cpu_times[msg] = (cpu_t - entry.cpu_time);
 #ifdef PROFILE_OP_COUNTS
-    for (std::pair<std::string, long long*> p : op_data_points)
-    {
-        cumulative_op_counts[std::make_pair(msg, p.first)] += *(p.second)-op_counts[std::make_pair(msg, p.first)];
-    }
+    cumulative_op_counts[msg] += op_delta;
+#endif
+#ifdef PROFILE_PERF_EVENTS
+    cumulative_perf_counts[msg] += perf_delta;
 #endif
 
     if (inhibit_profiling_info)
@@ -310,9 +410,6 @@ void leave_block(const std::string &msg, const bool indent)
         return;
     }
 
-#ifdef MULTICORE
-#pragma omp critical
-#endif
     {
         if (indent)
         {
@@ -321,8 +418,20 @@ void leave_block(const std::string &msg, const bool indent)
 
         print_indent();
         printf("(leave) %-35s\t", msg.c_str());
-        print_times_from_last_and_start(t, enter_times[msg], cpu_t, enter_cpu_times[msg]);
-        print_op_profiling(msg);
+        print_times_from_last_and_start(t, entry.time, cpu_t, entry.cpu_time);
+#ifdef PROFILE_OP_COUNTS
+        print_op_counts(op_delta);
+#endif
+#ifdef PROFILE_PERF_EVENTS
+        if (!perf_delta.total.is_zero())
+        {
+            printf("\n");
+            print_indent();
+            printf("(perf) = (");
+            perf_delta.total.print();
+            printf(")");
+        }
+#endif
         printf("\n");
         fflush(stdout);
     }
@@ -342,7 +451,21 @@ void print_mem(const std::string &s)
         printf("* Peak vsize (physical memory+swap) in mebibytes (%s): %lu\n", s.c_str(), usage.vsize >> 20);
     }
 #else
-    printf("* Memory profiling not supported in NO_PROCPS mode\n");
+    const process_mem_info info = get_process_mem_info();
+    if (info.peak_vsize != 0)
+    {
+        printf("* Peak vsize (physical memory+swap) in mebibytes%s%s%s: %zu\n",
+               s.empty() ? "" : " (", s.c_str(), s.empty() ? "" : ")", info.peak_vsize >> 20);
+    }
+    else if (info.peak_rss != 0)
+    {
+        printf("* Peak resident set size in mebibytes%s%s%s: %zu\n",
+               s.empty() ? "" : " (", s.c_str(), s.empty() ? "" : ")", info.peak_rss >> 20);
+    }
+    else
+    {
+        printf("* Memory profiling not supported on this platform\n");
+    }
 #endif
 }
 
@@ -372,6 +495,11 @@ void print_compilation_info()
 #else
     printf("PROFILE_OP_COUNTS: no\n");
 #endif
+#ifdef PROFILE_PERF_EVENTS
+    printf("PROFILE_PERF_EVENTS: yes\n");
+#else
+    printf("PROFILE_PERF_EVENTS: no\n");
+#endif
 #ifdef _GLIBCXX_DEBUG
     printf("_GLIBCXX_DEBUG: yes\n");
 #else
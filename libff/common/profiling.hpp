@@ -39,6 +39,8 @@ void clear_profiling_counters();
 void print_cumulative_time_entry(const std::string &key, const long long factor=1);
 void print_cumulative_times(const long long factor=1);
 void print_cumulative_op_counts(const bool only_fq=false);
+/* requires PROFILE_PERF_EVENTS; see perf_counters.hpp */
+void print_cumulative_perf_counts(const bool per_thread=false);
 
 void enter_block(const std::string &msg, const bool indent=true);
 void leave_block(const std::string &msg, const bool indent=true);
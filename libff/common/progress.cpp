@@ -0,0 +1,99 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of progress reporting and cooperative cancellation.
+
+ See progress.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <libff/common/profiling.hpp>
+#include <libff/common/progress.hpp>
+
+namespace libff {
+
+static thread_local progress_context this_thread_progress;
+
+cancellation_token::cancellation_token() :
+    flag(std::make_shared<std::atomic<bool> >(false))
+{
+}
+
+void cancellation_token::cancel() const
+{
+    flag->store(true, std::memory_order_relaxed);
+}
+
+void set_progress_callback(const progress_callback &callback, const long long min_interval_ms)
+{
+    this_thread_progress.callback = callback;
+    this_thread_progress.min_interval_ns = min_interval_ms * 1000000ll;
+}
+
+void set_cancellation_token(const cancellation_token &token)
+{
+    this_thread_progress.token = token;
+    this_thread_progress.has_token = true;
+}
+
+void clear_progress_callback()
+{
+    this_thread_progress.callback = progress_callback();
+}
+
+void clear_cancellation_token()
+{
+    this_thread_progress.token = cancellation_token();
+    this_thread_progress.has_token = false;
+}
+
+progress_context get_progress_context()
+{
+    return this_thread_progress;
+}
+
+void set_progress_context(const progress_context &context)
+{
+    this_thread_progress = context;
+}
+
+progress_reporter::progress_reporter(const std::string &operation, const size_t total) :
+    operation(operation),
+    total(total),
+    callback(this_thread_progress.callback),
+    token(this_thread_progress.token),
+    has_token(this_thread_progress.has_token),
+    min_interval_ns(this_thread_progress.min_interval_ns),
+    last_report_ns(get_nsec_time()),
+    owner(std::this_thread::get_id()),
+    done(0)
+{
+}
+
+void progress_reporter::report()
+{
+    const long long now = get_nsec_time();
+    if (now - last_report_ns >= min_interval_ns)
+    {
+        last_report_ns = now;
+        callback(operation, done.load(std::memory_order_relaxed), total);
+    }
+}
+
+void progress_reporter::finish()
+{
+    if (cancelled())
+    {
+        throw operation_cancelled(operation);
+    }
+    if (callback)
+    {
+        callback(operation, total, total);
+    }
+}
+
+} // libff
@@ -0,0 +1,116 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of progress reporting and cooperative cancellation for
+ long-running operations (batch_exp, batch_exp_with_coeff, batch_exp_affine
+ and chunked multi_exp).
+
+ A thread registers a progress callback and/or a cancellation token with
+ set_progress_callback and set_cancellation_token; operations started from
+ that thread pick them up, even if the work itself runs on OpenMP worker
+ threads. The callback is only ever invoked from the thread that started the
+ operation, at most once per min_interval_ms and once more when the operation
+ completes, so it never serializes the workers.
+
+ Cancelling a token makes the running operation skip its remaining work and
+ throw operation_cancelled from the thread that started it. Cancellation is
+ checked between work items (one scalar of batch_exp, one chunk of
+ multi_exp), so it takes effect after at most one work item per thread.
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef PROGRESS_HPP_
+#define PROGRESS_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace libff {
+
+/* Copies share their state, so a token can be cancelled from any thread. */
+class cancellation_token {
+private:
+    std::shared_ptr<std::atomic<bool> > flag;
+public:
+    cancellation_token();
+
+    void cancel() const;
+    bool is_cancelled() const { return flag->load(std::memory_order_relaxed); }
+};
+
+class operation_cancelled : public std::runtime_error {
+public:
+    explicit operation_cancelled(const std::string &operation) :
+        std::runtime_error(operation + " cancelled") {}
+};
+
+/* done of total work items of operation have been completed */
+typedef std::function<void(const std::string &operation, const size_t done, const size_t total)> progress_callback;
+
+/* Register the callback and token for operations started from the calling thread. */
+void set_progress_callback(const progress_callback &callback, const long long min_interval_ms = 100);
+void set_cancellation_token(const cancellation_token &token);
+void clear_progress_callback();
+void clear_cancellation_token();
+
+/* Everything registered by a thread, so that work handed to another thread (see async.hpp) can carry it along. */
+struct progress_context {
+    progress_callback callback;
+    long long min_interval_ns = 0;
+    cancellation_token token;
+    bool has_token = false;
+};
+
+progress_context get_progress_context();
+void set_progress_context(const progress_context &context);
+
+/**
+ * Used by the operations themselves: created by the thread that starts the
+ * operation, shared with the workers, which call advance() and check
+ * cancelled(). finish() reports completion and throws operation_cancelled if
+ * the token was cancelled.
+ */
+class progress_reporter {
+private:
+    std::string operation;
+    size_t total;
+    progress_callback callback;
+    cancellation_token token;
+    bool has_token;
+    long long min_interval_ns;
+    long long last_report_ns;
+    std::thread::id owner;
+    std::atomic<size_t> done;
+
+    void report();
+public:
+    progress_reporter(const std::string &operation, const size_t total);
+    progress_reporter(const progress_reporter&) = delete;
+    progress_reporter& operator=(const progress_reporter&) = delete;
+
+    bool cancelled() const { return has_token && token.is_cancelled(); }
+
+    void advance(const size_t items = 1)
+    {
+        done.fetch_add(items, std::memory_order_relaxed);
+        if (callback && std::this_thread::get_id() == owner)
+        {
+            report();
+        }
+    }
+
+    void finish();
+};
+
+} // libff
+
+#endif // PROGRESS_HPP_
@@ -0,0 +1,265 @@
+/** @file
+ *****************************************************************************
+
+ Implementation of a low-overhead, thread-safe hierarchical tracer.
+
+ See tracing.hpp .
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#include <cstdio>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <libff/common/profiling.hpp>
+#include <libff/common/tracing.hpp>
+
+namespace libff {
+
+std::atomic<bool> tracing_enabled_flag(false);
+
+struct trace_event {
+    long long time;
+    trace_block_id id;
+    bool is_enter;
+};
+
+/* Events of a single thread. Only the owning thread writes to it. */
+struct trace_buffer {
+    size_t thread_idx;
+    std::vector<trace_event> events;
+    size_t num_recorded = 0;
+
+    trace_buffer(const size_t thread_idx, const size_t capacity) : thread_idx(thread_idx), events(capacity) {}
+
+    void record(const trace_block_id id, const bool is_enter)
+    {
+        trace_event &e = events[num_recorded % events.size()];
+        e.time = get_nsec_time();
+        e.id = id;
+        e.is_enter = is_enter;
+        ++num_recorded;
+    }
+
+    /* calls f on the retained events, oldest first */
+    template<typename F>
+    void for_each(F f) const
+    {
+        const size_t first = (num_recorded > events.size() ? num_recorded - events.size() : 0);
+        for (size_t i = first; i < num_recorded; ++i)
+        {
+            f(events[i % events.size()]);
+        }
+    }
+};
+
+static std::mutex trace_mutex;
+static size_t trace_buffer_capacity = 1ul << 16;
+/* buffers are owned here, so they outlive the threads that wrote them */
+static std::vector<std::unique_ptr<trace_buffer> > trace_buffers;
+/* buffers of threads that have exited, handed to the next threads that trace */
+static std::vector<trace_buffer*> free_trace_buffers;
+static std::map<std::string, trace_block_id> trace_ids;
+static std::deque<std::string> trace_names;
+
+/**
+ * Binds a buffer to the thread for the thread's lifetime. When the thread
+ * exits, the buffer (with its events) goes to the free list, so the number of
+ * buffers is bounded by the number of threads tracing at the same time rather
+ * than by the number of threads ever started. A reused buffer appends after
+ * the events of its previous thread, which shows up as the same trace thread.
+ */
+class trace_buffer_owner {
+public:
+    trace_buffer *buffer = nullptr;
+
+    ~trace_buffer_owner()
+    {
+        if (buffer != nullptr)
+        {
+            std::lock_guard<std::mutex> lock(trace_mutex);
+            free_trace_buffers.emplace_back(buffer);
+        }
+    }
+};
+
+static thread_local trace_buffer_owner this_thread_buffer;
+
+static trace_buffer& get_thread_buffer()
+{
+    if (this_thread_buffer.buffer == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(trace_mutex);
+        if (!free_trace_buffers.empty())
+        {
+            this_thread_buffer.buffer = free_trace_buffers.back();
+            free_trace_buffers.pop_back();
+        }
+        else
+        {
+            trace_buffers.emplace_back(new trace_buffer(trace_buffers.size(), trace_buffer_capacity));
+            this_thread_buffer.buffer = trace_buffers.back().get();
+        }
+    }
+    return *this_thread_buffer.buffer;
+}
+
+void enable_tracing(const bool enable)
+{
+    tracing_enabled_flag.store(enable, std::memory_order_relaxed);
+}
+
+void set_trace_buffer_capacity(const size_t num_events)
+{
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    trace_buffer_capacity = (num_events == 0 ? 1 : num_events);
+}
+
+trace_block_id trace_intern(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    auto it = trace_ids.find(name);
+    if (it != trace_ids.end())
+    {
+        return it->second;
+    }
+
+    const trace_block_id id = trace_names.size();
+    trace_names.emplace_back(name);
+    trace_ids[name] = id;
+    return id;
+}
+
+const std::string& trace_block_name(const trace_block_id id)
+{
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    /* std::deque never moves its elements on emplace_back */
+    return trace_names.at(id);
+}
+
+void trace_enter(const trace_block_id id)
+{
+    get_thread_buffer().record(id, true);
+}
+
+void trace_leave(const trace_block_id id)
+{
+    get_thread_buffer().record(id, false);
+}
+
+void clear_trace()
+{
+    std::lock_guard<std::mutex> lock(trace_mutex);
+    for (auto &buffer : trace_buffers)
+    {
+        buffer->num_recorded = 0;
+    }
+}
+
+static void write_json_string(std::ostream &out, const std::string &s)
+{
+    out << '"';
+    for (const char ch : s)
+    {
+        if (ch == '"' || ch == '\\')
+        {
+            out << '\\' << ch;
+        }
+        else if (static_cast<unsigned char>(ch) < 0x20)
+        {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", ch);
+            out << buf;
+        }
+        else
+        {
+            out << ch;
+        }
+    }
+    out << '"';
+}
+
+void write_chrome_trace(std::ostream &out)
+{
+    std::lock_guard<std::mutex> lock(trace_mutex);
+
+    out << "{\"traceEvents\":[";
+    bool first = true;
+    for (const auto &buffer : trace_buffers)
+    {
+        buffer->for_each([&](const trace_event &e) {
+            if (!first)
+            {
+                out << ",";
+            }
+            first = false;
+
+            char ts[32];
+            snprintf(ts, sizeof(ts), "%.3f", e.time * 1e-3); // microseconds
+            out << "\n{\"name\":";
+            write_json_string(out, trace_names[e.id]);
+            out << ",\"cat\":\"libff\",\"ph\":\"" << (e.is_enter ? "B" : "E")
+                << "\",\"ts\":" << ts
+                << ",\"pid\":0,\"tid\":" << buffer->thread_idx << "}";
+        });
+    }
+    out << "\n],\"displayTimeUnit\":\"ns\"}\n";
+}
+
+void write_folded_stacks(std::ostream &out)
+{
+    std::lock_guard<std::mutex> lock(trace_mutex);
+
+    /* self time (in ns) of every distinct call stack, summed over all threads */
+    std::map<std::string, long long> self_times;
+
+    for (const auto &buffer : trace_buffers)
+    {
+        std::vector<trace_block_id> stack;
+        long long last_time = 0;
+
+        buffer->for_each([&](const trace_event &e) {
+            if (!stack.empty())
+            {
+                std::string key;
+                for (size_t i = 0; i < stack.size(); ++i)
+                {
+                    key += (i == 0 ? "" : ";") + trace_names[stack[i]];
+                }
+                self_times[key] += e.time - last_time;
+            }
+            last_time = e.time;
+
+            if (e.is_enter)
+            {
+                stack.emplace_back(e.id);
+            }
+            else
+            {
+                /* tolerate leaves whose enter was overwritten in the ring buffer */
+                for (size_t i = stack.size(); i > 0; --i)
+                {
+                    if (stack[i-1] == e.id)
+                    {
+                        stack.resize(i-1);
+                        break;
+                    }
+                }
+            }
+        });
+    }
+
+    for (auto &kv : self_times)
+    {
+        out << kv.first << " " << kv.second << "\n";
+    }
+}
+
+} // libff
@@ -0,0 +1,98 @@
+/** @file
+ *****************************************************************************
+
+ Declaration of a low-overhead, thread-safe hierarchical tracer.
+
+ Unlike enter_block/leave_block (see profiling.hpp), which keep global
+ string-keyed maps and must not be used from parallel regions, the tracer
+ records fixed-size events into per-thread ring buffers. Block names are
+ interned once into integer ids, so an instrumented scope costs two clock
+ reads and two buffer writes while tracing is enabled, and a single flag
+ check while it is disabled.
+
+ The recorded events can be exported as Chrome trace-event JSON (viewable in
+ chrome://tracing or Perfetto) or as folded stacks (for flamegraph.pl).
+
+ *****************************************************************************
+ * @author     This file is part of libff, developed by SCIPR Lab
+ *             and contributors (see AUTHORS).
+ * @copyright  MIT license (see LICENSE file)
+ *****************************************************************************/
+
+#ifndef TRACING_HPP_
+#define TRACING_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+namespace libff {
+
+typedef size_t trace_block_id;
+
+extern std::atomic<bool> tracing_enabled_flag;
+
+inline bool tracing_enabled() { return tracing_enabled_flag.load(std::memory_order_relaxed); }
+void enable_tracing(const bool enable=true);
+
+/**
+ * Set the number of events kept per thread; once a thread's buffer is full,
+ * its oldest events are overwritten. Only affects buffers created afterwards:
+ * the buffer of a thread that has exited is kept, with its events and
+ * capacity, and reused by the next thread that starts tracing.
+ */
+void set_trace_buffer_capacity(const size_t num_events);
+
+/* Map a block name to its id. Thread-safe; the same name always gets the same id. */
+trace_block_id trace_intern(const std::string &name);
+const std::string& trace_block_name(const trace_block_id id);
+
+void trace_enter(const trace_block_id id);
+void trace_leave(const trace_block_id id);
+
+/**
+ * Discard all recorded events. The exporters and clear_trace must not run
+ * concurrently with traced code.
+ */
+void clear_trace();
+void write_chrome_trace(std::ostream &out);
+void write_folded_stacks(std::ostream &out);
+
+/* RAII helper that traces the enclosing scope. */
+class trace_scope {
+private:
+    trace_block_id id;
+    bool active;
+public:
+    explicit trace_scope(const trace_block_id id) : id(id), active(tracing_enabled())
+    {
+        if (active)
+        {
+            trace_enter(id);
+        }
+    }
+    ~trace_scope()
+    {
+        if (active)
+        {
+            trace_leave(id);
+        }
+    }
+    trace_scope(const trace_scope&) = delete;
+    trace_scope& operator=(const trace_scope&) = delete;
+};
+
+} // libff
+
+#define LIBFF_TRACE_CONCAT_INNER(a, b) a##b
+#define LIBFF_TRACE_CONCAT(a, b) LIBFF_TRACE_CONCAT_INNER(a, b)
+
+/* Trace the enclosing scope under the given (string literal) name; the name is interned once. */
+#define LIBFF_TRACE_SCOPE(name)                                                             \
+    static const libff::trace_block_id LIBFF_TRACE_CONCAT(libff_trace_id_, __LINE__) =      \
+        libff::trace_intern(name);                                                          \
+    libff::trace_scope LIBFF_TRACE_CONCAT(libff_trace_scope_, __LINE__)(                    \
+        LIBFF_TRACE_CONCAT(libff_trace_id_, __LINE__))
+
+#endif // TRACING_HPP_